@@ -0,0 +1,85 @@
+#ifndef __DiLeptonAnalysis_NTupleProducer_CorrectedJetCache_H__
+#define __DiLeptonAnalysis_NTupleProducer_CorrectedJetCache_H__
+//
+// Package: NTupleProducer
+// Class:   CorrectedJetCache
+//
+/* class CorrectedJetCache
+   CorrectedJetCache.h
+   Description:  per-event cache of corrected jets, keyed by (jet collection,
+                 corrector name), so that a collection stored by the producer
+                 and by a jet filler is corrected and ordered only once.
+
+   Usage: call newEvent() at the start of each event, then get() the
+   corrections of a collection. The first get() of a key corrects all the
+   jets of the collection (the corrector reads the event under the lock of
+   the collection cache); the entries of different keys are filled
+   independently, so that consumers of distinct collections can run
+   concurrently. The returned entry is valid until the next newEvent().
+*/
+//
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "DataFormats/JetReco/interface/Jet.h"
+
+class EventCollectionCache;
+
+class CorrectedJetCache {
+public:
+  /// Corrections of one collection, by index in the collection
+  struct Jets {
+    std::vector<double> scale;                        // correction factor
+    std::vector<double> pt;                           // raw pt times scale
+    std::vector<reco::Jet::LorentzVector> p4;         // raw p4 times scale
+    std::vector<unsigned> order;                      // indices by decreasing corrected pt
+  };
+
+  CorrectedJetCache(void);
+  ~CorrectedJetCache(void) { clear(); }
+
+  /// Drop the corrections of the previous event; the collections are read
+  /// through the given cache if there is one
+  void newEvent(const edm::Event& iEvent, const edm::EventSetup& iSetup, EventCollectionCache* collections);
+
+  /// Corrected jets of a collection (edm::View<reco::Jet>)
+  const Jets& get(const edm::InputTag& tag, const std::string& corrector);
+
+  /// Counters summed over all events
+  unsigned long nTotRequests(void) const { return fNTotRequests; }
+  unsigned long nTotCorrected(void) const { return fNTotCorrected; }
+
+private:
+  CorrectedJetCache(const CorrectedJetCache&);
+  CorrectedJetCache& operator=(const CorrectedJetCache&);
+
+  struct Entry {
+    Entry(void) : done(false) {}
+    boost::mutex mutex; // held while the entry is filled
+    bool done;
+    Jets jets;
+  };
+  typedef std::map<std::pair<std::string,std::string>, Entry*> EntryMap;
+
+  void clear(void);
+  void fill(const edm::InputTag& tag, const std::string& corrector, Jets& jets);
+
+  const edm::Event* fEvent;
+  const edm::EventSetup* fSetup;
+  EventCollectionCache* fCollections;
+  EntryMap fEntries;
+  boost::mutex fMutex; // guards fEntries and the counters
+
+  unsigned long fNTotRequests;
+  unsigned long fNTotCorrected;
+};
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef __DiLeptonAnalysis_NTupleProducer_CrystalGeometryCache_H__
+#define __DiLeptonAnalysis_NTupleProducer_CrystalGeometryCache_H__
+//
+// Package: NTupleProducer
+// Class:   CrystalGeometryCache
+//
+/* class CrystalGeometryCache
+   CrystalGeometryCache.h
+   Description:  run-scoped cache of the geometry of the ECAL crystals
+                 (barrel and endcap only): position, eta and phi widths and
+                 the four front-face corners, as stored in the Xtal branches.
+
+   A crystal is read from the geometry the first time it is asked for, and
+   then found through its dense (hashed) index. The cache is cleared at each
+   run, so that its content is the table of the crystals used in the run.
+*/
+//
+
+#include <vector>
+
+#include "DataFormats/DetId/interface/DetId.h"
+
+class CaloSubdetectorGeometry;
+
+class CrystalGeometryCache {
+public:
+  struct Crystal {
+    unsigned int rawId;
+    float x, y, z;
+    float etaWidth, phiWidth;
+    float front[4][3]; // corners, (x,y,z)
+  };
+
+  CrystalGeometryCache(void) {}
+  ~CrystalGeometryCache(void) {}
+
+  void clear(void);
+
+  /// Index of an EB or EE crystal in the cache, reading it from the geometry if needed
+  unsigned int index(const DetId& id, const CaloSubdetectorGeometry* barrel, const CaloSubdetectorGeometry* endcap);
+  const Crystal& crystal(unsigned int index) const { return fCrystals[index]; }
+
+  /// The crystals read so far in the run, in the order they were first asked for
+  const std::vector<Crystal>& crystals(void) const { return fCrystals; }
+
+private:
+  std::vector<int> fIndex; // by dense index, EB then EE; -1 if not read yet
+  std::vector<Crystal> fCrystals;
+};
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef __DiLeptonAnalysis_NTupleProducer_EventCollectionCache_H__
+#define __DiLeptonAnalysis_NTupleProducer_EventCollectionCache_H__
+//
+// Package: NTupleProducer
+// Class:   EventCollectionCache
+//
+/* class EventCollectionCache
+   EventCollectionCache.h
+   Description:  per-event cache of edm::Handles, so that every block of the
+                 producer and every filler resolves a given (InputTag, type)
+                 only once per event.
+
+   Usage: call newEvent() at the start of each event, then use getByLabel()
+   exactly like edm::Event::getByLabel().
+
+   getByLabel() may be called from concurrent stages. Any other access to the
+   edm::Event or the EventSetup from such stages must hold a Lock.
+*/
+//
+
+#include <map>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <utility>
+
+#include <boost/thread/recursive_mutex.hpp>
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "DataFormats/Common/interface/Handle.h"
+
+class EventCollectionCache {
+public:
+  EventCollectionCache(void);
+  ~EventCollectionCache(void) { clear(); }
+
+  /// Drop all handles of the previous event and point to the new one
+  void newEvent(const edm::Event& iEvent);
+
+  /// Same semantics as edm::Event::getByLabel, resolved once per event
+  template <class T> bool getByLabel(const edm::InputTag& tag, edm::Handle<T>& handle);
+  template <class T> bool getByLabel(const std::string& label, edm::Handle<T>& handle) {
+    return getByLabel(edm::InputTag(label, std::string()), handle);
+  }
+  template <class T> bool getByLabel(const std::string& label, const std::string& instance, edm::Handle<T>& handle) {
+    return getByLabel(edm::InputTag(label, instance), handle);
+  }
+
+  /// Serializes direct accesses to the event; a NULL cache does not lock
+  class Lock {
+  public:
+    explicit Lock(EventCollectionCache* cache) : fCache(cache) { if (fCache) fCache->fMutex.lock(); }
+    ~Lock(void) { if (fCache) fCache->fMutex.unlock(); }
+  private:
+    Lock(const Lock&);
+    Lock& operator=(const Lock&);
+    EventCollectionCache* fCache;
+  };
+
+  /// Counters for the current event
+  unsigned nLookups(void)  const { return fNLookups; }
+  unsigned nResolved(void) const { return fNResolved; }
+  unsigned nSaved(void)    const { return fNLookups - fNResolved; }
+  /// Counters summed over all events
+  unsigned long nTotLookups(void) const { return fNTotLookups; }
+  unsigned long nTotSaved(void)   const { return fNTotLookups - fNTotResolved; }
+
+private:
+  EventCollectionCache(const EventCollectionCache&);
+  EventCollectionCache& operator=(const EventCollectionCache&);
+
+  struct HolderBase {
+    virtual ~HolderBase(void) {}
+    bool found;
+  };
+  template <class T> struct Holder : public HolderBase {
+    edm::Handle<T> handle;
+  };
+  typedef std::map<std::pair<std::string,std::string>, HolderBase*> HolderMap;
+
+  void clear(void);
+
+  const edm::Event* fEvent;
+  HolderMap fHolders;
+  boost::recursive_mutex fMutex;
+
+  unsigned fNLookups;
+  unsigned fNResolved;
+  unsigned long fNTotLookups;
+  unsigned long fNTotResolved;
+};
+
+//________________________________________________________________________________________
+template <class T>
+bool EventCollectionCache::getByLabel(const edm::InputTag& tag, edm::Handle<T>& handle) {
+
+  Lock lock(this);
+  ++fNLookups;
+  ++fNTotLookups;
+
+  std::pair<std::string,std::string> key(tag.encode(), typeid(T).name());
+  HolderMap::const_iterator it = fHolders.find(key);
+  if (it != fHolders.end()) {
+    const Holder<T>* holder = static_cast<const Holder<T>*>(it->second);
+    handle = holder->handle;
+    return holder->found;
+  }
+
+  ++fNResolved;
+  ++fNTotResolved;
+
+  std::auto_ptr<Holder<T> > holder(new Holder<T>);
+  holder->found = fEvent->getByLabel(tag, holder->handle);
+  handle = holder->handle;
+  bool found = holder->found;
+  fHolders.insert(std::make_pair(key, holder.release()));
+  return found;
+
+}
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef __DiLeptonAnalysis_NTupleProducer_FastForest_H__
+#define __DiLeptonAnalysis_NTupleProducer_FastForest_H__
+//
+// Package: NTupleProducer
+// Class:   FastForest
+//
+/* class FastForest
+   FastForest.h
+   Description:  evaluation of a TMVA AdaBoost BDT (yes/no leaves, weighted
+                 trees, no variable transformation) from flat arrays, giving
+                 the same response as TMVA::Reader::EvaluateMVA.
+
+   The trees are read once from the TMVA weight file into one array of nodes
+   (variable, cut and the two children, with the cut type folded into the
+   order of the children) and one of leaf values. The arrays can be cached
+   in a binary file, which is only used when it was written from the same
+   weight file (same size and checksum), its own content is intact (checksum)
+   and all its indices are in range, and rewritten otherwise.
+
+   The inputs are rows of nVariables() floats in the order of the weight
+   file; evaluate() on several rows goes through the trees one after the
+   other, for all rows at once.
+*/
+//
+
+#include <string>
+#include <vector>
+
+class FastForest {
+public:
+  FastForest(void) : fNVariables(0), fNorm(0.) {}
+  ~FastForest(void) {}
+
+  /// Read the forest from a weight file, or from its cache if cachePath is
+  /// not empty and the cache is up to date; throws if the file can not be
+  /// used or its variables are not the expected ones (in that order)
+  void load(const std::string& weightPath, const std::vector<std::string>& variables,
+	    const std::string& cachePath = "");
+
+  unsigned nVariables(void) const { return fNVariables; }
+  unsigned nTrees(void) const { return fRoots.size(); }
+
+  /// Response for one row of nVariables() inputs
+  double evaluate(const float* row) const;
+  /// Responses for nRows consecutive rows
+  void evaluate(const float* rows, unsigned nRows, std::vector<double>& responses) const;
+
+private:
+  // Internal node: goes to ge if the input is >= cut, to lt otherwise;
+  // a negative child c is the leaf ~c
+  struct Node {
+    int   var;
+    float cut;
+    int   ge, lt;
+  };
+
+  void parseWeights(const std::string& xml, const std::vector<std::string>& variables,
+		    const std::string& weightPath);
+  static bool isValid(const std::vector<Node>& nodes, size_t nLeaves, const std::vector<int>& roots,
+		      unsigned nVariables);
+  bool readCache(const std::string& cachePath, unsigned long long size, unsigned long long checksum);
+  void writeCache(const std::string& cachePath, unsigned long long size, unsigned long long checksum) const;
+
+  unsigned fNVariables;
+  std::vector<std::string> fVariables;
+  std::vector<Node> fNodes;
+  std::vector<double> fLeaves;  // +-1 times the boost weight of the tree
+  std::vector<int> fRoots;      // per tree, node or ~leaf
+  double fNorm;                 // sum of the boost weights
+};
+
+#endif
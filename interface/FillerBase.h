@@ -24,6 +24,9 @@
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Utilities/interface/TypeID.h"
 
+#include "DiLeptonAnalysis/NTupleProducer/interface/EventCollectionCache.h"
+#include "DiLeptonAnalysis/NTupleProducer/interface/ProductBufferPool.h"
+
 namespace filler {
   // Gory details of production (need to hand over to producer class)
   // This is because of how the EDFilter::produce() method works.
@@ -51,16 +54,30 @@ public:
   /// Put products in the event data
   virtual void putProducts( edm::Event& ) = 0;
 
+  /// Share the producer's per-event collection cache (optional)
+  void setCollectionCache( EventCollectionCache* cache ) { fCollections = cache; }
+  /// Log the allocations avoided by the product buffer pool
+  void reportBufferPool(void) const { fBufferPool.report(fPrefix); }
+
 protected:
 
   /// Add a product to the list (with prefix)
   void addProduct(const char* name, const type_info& type);
   /// Returns prefixed name (always use this method!)
   const std::string fullName(const char* name) { return std::string(fPrefix+name); }
+  /// Retrieve a collection, through the shared cache if there is one
+  template <class T> bool getByLabel(const edm::Event& iEvent, const edm::InputTag& tag, edm::Handle<T>& handle) {
+    return fCollections ? fCollections->getByLabel(tag, handle) : iEvent.getByLabel(tag, handle);
+  }
+  template <class T> bool getByLabel(const edm::Event& iEvent, const std::string& label, edm::Handle<T>& handle) {
+    return getByLabel(iEvent, edm::InputTag(label, std::string()), handle);
+  }
 
   std::string fPrefix;        /// Prefix for branches
   bool   fIsRealData;         /// Global switch
   std::vector<filler::PPair> typeList;
+  EventCollectionCache* fCollections; /// Not owned
+  ProductBufferPool fBufferPool;      /// Vector products reserved to their high-water mark
   
 
 };
@@ -0,0 +1,69 @@
+#ifndef __DiLeptonAnalysis_NTupleProducer_GenMatcher_H__
+#define __DiLeptonAnalysis_NTupleProducer_GenMatcher_H__
+//
+// Package: NTupleProducer
+// Class:   GenMatcher
+//
+/* class GenMatcher
+   GenMatcher.h
+   Description:  event-scoped matching of reconstructed objects to the
+                 generator: the closest stable particle (dR < 0.1) with its
+                 mother and grand-mother, and the closest stored gen-jet
+                 (dR < 0.3), both within a factor 2 in pt.
+
+   The candidates are kept sorted in eta so that a query only looks at the
+   ones inside its cone; the results are indices (into the gen-particle
+   collection or the stored gen-jets), -1 when there is none. The buffers are
+   reused from event to event, and the queries are const: they can be made
+   from several stages at the same time.
+*/
+//
+
+#include <vector>
+
+#include "DataFormats/HepMCCandidate/interface/GenParticle.h"
+#include "DataFormats/HepMCCandidate/interface/GenParticleFwd.h"
+
+class GenMatcher {
+public:
+  struct Match {
+    int particle;    // matched stable particle
+    int mother;      // first ancestor with a different PDG id
+    int grandMother; // first ancestor of the mother with a different PDG id
+  };
+
+  GenMatcher(void) : fParticles(0) {}
+  ~GenMatcher(void) {}
+
+  /// Index the stable particles of the event; clear() on real data
+  void fillParticles(const reco::GenParticleCollection& particles);
+  /// Index the gen-jets stored in the ntuple
+  void fillJets(const std::vector<float>& pt, const std::vector<float>& eta, const std::vector<float>& phi);
+  void clear(void);
+
+  Match matchParticle(double pt, double eta, double phi) const;
+  int matchJet(double pt, double eta, double phi) const;
+
+  /// The particle of a match index; for -1 a default one, with all values 0
+  const reco::GenParticle& particle(int index) const { return index < 0 ? fNone : (*fParticles)[index]; }
+
+private:
+  struct Point {
+    double eta;
+    double phi;
+    double pt;
+    int index;
+    bool operator<(const Point& other) const { return eta < other.eta; }
+  };
+
+  static int closest(const std::vector<Point>& points, double maxDR, double pt, double eta, double phi);
+  int differentAncestor(int index, int pdgId, const char* what) const;
+  int indexOf(const reco::Candidate* particle) const;
+
+  const reco::GenParticleCollection* fParticles;
+  const reco::GenParticle fNone;
+  std::vector<Point> fStable;
+  std::vector<Point> fJets;
+};
+
+#endif
@@ -26,6 +26,7 @@
 #include "DataFormats/VertexReco/interface/Vertex.h"
 
 #include "DiLeptonAnalysis/NTupleProducer/interface/FillerBase.h"
+#include "DiLeptonAnalysis/NTupleProducer/interface/CorrectedJetCache.h"
 
 class JetFillerBase : public FillerBase {
 public:
@@ -47,6 +48,8 @@ public:
   /// Put products in the event data
   virtual void putProducts( edm::Event& );
 
+  /// Share the producer's per-event corrected jets (optional)
+  void setCorrectedJetCache( CorrectedJetCache* cache ) { fCorrectedJets = cache; }
 
 
 protected:
@@ -57,15 +60,8 @@ protected:
 
   static const unsigned int gMaxNBtags      = 10;
 
-  // To order indices by pt
-  typedef std::pair<unsigned int,double> OrderPair;
-  struct IndexByPt {
-    const bool operator()(const OrderPair& j1, const OrderPair& j2 ) const {
-      return j1.second > j2.second;
-    }
-  };
-
   JetType fJetType;	
+  CorrectedJetCache* fCorrectedJets; /// Not owned
 
   size_t gMaxnobjs;
 
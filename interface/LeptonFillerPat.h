@@ -208,7 +208,7 @@ void LeptonFillerPat<LeptonType>::fillProducts(edm::Event& iEvent,
 
   // Retrieve collection
   edm::Handle<edm::View<LeptonType> > collection;
-  iEvent.getByLabel(fTag,collection);
+  getByLabel(iEvent,fTag,collection);
     
   size_t pfqi(0);  // Index of qualified leptons
   for (typename edm::View<LeptonType>::const_iterator it = collection->begin(); 
@@ -357,6 +357,8 @@ const std::vector<filler::PPair> LeptonFillerPat<LeptonType>::declareProducts(vo
 template <class LeptonType>
 void LeptonFillerPat<LeptonType>::putProducts(edm::Event& e) {
 
+  fBufferPool.collect();
+
   e.put(fTMaxLepExc,fullName("MaxLepExc"));
   e.put(fTNObjsTot,fullName("NObjsTot"));
   e.put(fTNObjs,fullName("NObjs"));
@@ -462,94 +464,94 @@ void LeptonFillerPat<LeptonType>::resetProducts(void) {
   fTNObjs    .reset(new int(0));
 
   // Reset all arrays
-  fTPx.reset(new std::vector<float>);
-  fTPy.reset(new std::vector<float>);
-  fTPz.reset(new std::vector<float>);
-  fTPt.reset(new std::vector<float>);
-  fTEta.reset(new std::vector<float>);
-  fTPhi.reset(new std::vector<float>);
-  fTE.reset(new std::vector<float>);
-  fTEt.reset(new std::vector<float>);
-  fTCharge.reset(new std::vector<int>);
-
-  fTParticleIso.reset(new std::vector<float>);
-  fTChargedHadronIso.reset(new std::vector<float>);
-  fTNeutralHadronIso.reset(new std::vector<float>);
-  fTPhotonIso.reset(new std::vector<float>);
+  fBufferPool.reset(fTPx, "Px");
+  fBufferPool.reset(fTPy, "Py");
+  fBufferPool.reset(fTPz, "Pz");
+  fBufferPool.reset(fTPt, "Pt");
+  fBufferPool.reset(fTEta, "Eta");
+  fBufferPool.reset(fTPhi, "Phi");
+  fBufferPool.reset(fTE, "E");
+  fBufferPool.reset(fTEt, "Et");
+  fBufferPool.reset(fTCharge, "Charge");
+
+  fBufferPool.reset(fTParticleIso, "ParticleIso");
+  fBufferPool.reset(fTChargedHadronIso, "ChargedHadronIso");
+  fBufferPool.reset(fTNeutralHadronIso, "NeutralHadronIso");
+  fBufferPool.reset(fTPhotonIso, "PhotonIso");
 
   if(fType == Tau){
-    fTDecayMode.reset(new std::vector<int>);
-    fTIsPFTau.reset(new std::vector<int>);
-    fTVz.reset(new std::vector<float>); 
-    fTEmFraction.reset(new std::vector<float>); 
-    fTJetPt.reset(new std::vector<float>);
-    fTJetEta.reset(new std::vector<float>);
-    fTJetPhi.reset(new std::vector<float>);
-    fTJetMass.reset(new std::vector<float>);
-    fTLeadingTkPt.reset(new std::vector<float>);
-    fTLeadingNeuPt.reset(new std::vector<float>);
-    fTLeadingTkHcalenergy.reset(new std::vector<float>);
-    fTLeadingTkEcalenergy.reset(new std::vector<float>);
-    fTNumChargedHadronsSignalCone.reset(new std::vector<int>);
-    fTNumNeutralHadronsSignalCone.reset(new std::vector<int>);
-    fTNumPhotonsSignalCone.reset(new std::vector<int>);
-    fTNumParticlesSignalCone.reset(new std::vector<int>);
-    fTNumChargedHadronsIsoCone.reset(new std::vector<int>);
-    fTNumNeutralHadronsIsoCone.reset(new std::vector<int>);
-    fTNumPhotonsIsolationCone.reset(new std::vector<int>);
-    fTNumParticlesIsolationCone.reset(new std::vector<int>);
-    fTPtSumChargedParticlesIsoCone.reset(new std::vector<float>);
-    fTPtSumPhotonsIsoCone.reset(new std::vector<float>);
-    fTDecayModeFinding.reset(new std::vector<float>);
-    fTVLooseIso.reset(new std::vector<float>);
-    fTLooseIso.reset(new std::vector<float>);
-    fTTightIso.reset(new std::vector<float>);
-    fTMediumIso.reset(new std::vector<float>);
-    fTVLooseChargedIso.reset(new std::vector<float>);
-    fTLooseChargedIso.reset(new std::vector<float>);
-    fTTightChargedIso.reset(new std::vector<float>);
-    fTMediumChargedIso.reset(new std::vector<float>);
-    fTVLooseIsoDBSumPtCorr.reset(new std::vector<float>);
-    fTLooseIsoDBSumPtCorr.reset(new std::vector<float>);
-    fTTightIsoDBSumPtCorr.reset(new std::vector<float>);
-    fTMediumIsoDBSumPtCorr.reset(new std::vector<float>);
-    fTVLooseCombinedIsoDBSumPtCorr.reset(new std::vector<float>);
-    fTLooseCombinedIsoDBSumPtCorr.reset(new std::vector<float>);
-    fTTightCombinedIsoDBSumPtCorr.reset(new std::vector<float>);
-    fTMediumCombinedIsoDBSumPtCorr.reset(new std::vector<float>);
-    fTLooseCombinedIsoDBSumPtCorr3Hits.reset(new std::vector<float>);
-    fTTightCombinedIsoDBSumPtCorr3Hits.reset(new std::vector<float>);
-    fTMediumCombinedIsoDBSumPtCorr3Hits.reset(new std::vector<float>);
-    fTIsolationMVAraw.reset(new std::vector<float>);
-    fTLooseIsolationMVA.reset(new std::vector<float>);
-    fTMediumIsolationMVA.reset(new std::vector<float>);
-    fTTightIsolationMVA.reset(new std::vector<float>);
-    fTIsolationMVA2raw.reset(new std::vector<float>);
-    fTLooseIsolationMVA2.reset(new std::vector<float>);
-    fTMediumIsolationMVA2.reset(new std::vector<float>);
-    fTTightIsolationMVA2.reset(new std::vector<float>);
-    fTLooseElectronRejection.reset(new std::vector<float>);
-    fTTightElectronRejection.reset(new std::vector<float>);
-    fTMediumElectronRejection.reset(new std::vector<float>);
-    fTElectronMVARejection.reset(new std::vector<float>);
-    fTLooseElectronMVA3Rejection.reset(new std::vector<float>);
-    fTMediumElectronMVA3Rejection.reset(new std::vector<float>);
-    fTTightElectronMVA3Rejection.reset(new std::vector<float>);
-    fTVTightElectronMVA3Rejection.reset(new std::vector<float>);
-    fTLooseMuonRejection.reset(new std::vector<float>);
-    fTMediumMuonRejection.reset(new std::vector<float>);
-    fTTightMuonRejection.reset(new std::vector<float>);
-    fTLooseMuon2Rejection.reset(new std::vector<float>);
-    fTMediumMuon2Rejection.reset(new std::vector<float>);
-    fTTightMuon2Rejection.reset(new std::vector<float>);
+    fBufferPool.reset(fTDecayMode, "DecayMode");
+    fBufferPool.reset(fTIsPFTau, "IsPFTau");
+    fBufferPool.reset(fTVz, "Vz"); 
+    fBufferPool.reset(fTEmFraction, "EmFraction"); 
+    fBufferPool.reset(fTJetPt, "JetPt");
+    fBufferPool.reset(fTJetEta, "JetEta");
+    fBufferPool.reset(fTJetPhi, "JetPhi");
+    fBufferPool.reset(fTJetMass, "JetMass");
+    fBufferPool.reset(fTLeadingTkPt, "LeadingTkPt");
+    fBufferPool.reset(fTLeadingNeuPt, "LeadingNeuPt");
+    fBufferPool.reset(fTLeadingTkHcalenergy, "LeadingTkHcalenergy");
+    fBufferPool.reset(fTLeadingTkEcalenergy, "LeadingTkEcalenergy");
+    fBufferPool.reset(fTNumChargedHadronsSignalCone, "NumChargedHadronsSignalCone");
+    fBufferPool.reset(fTNumNeutralHadronsSignalCone, "NumNeutralHadronsSignalCone");
+    fBufferPool.reset(fTNumPhotonsSignalCone, "NumPhotonsSignalCone");
+    fBufferPool.reset(fTNumParticlesSignalCone, "NumParticlesSignalCone");
+    fBufferPool.reset(fTNumChargedHadronsIsoCone, "NumChargedHadronsIsoCone");
+    fBufferPool.reset(fTNumNeutralHadronsIsoCone, "NumNeutralHadronsIsoCone");
+    fBufferPool.reset(fTNumPhotonsIsolationCone, "NumPhotonsIsolationCone");
+    fBufferPool.reset(fTNumParticlesIsolationCone, "NumParticlesIsolationCone");
+    fBufferPool.reset(fTPtSumChargedParticlesIsoCone, "PtSumChargedParticlesIsoCone");
+    fBufferPool.reset(fTPtSumPhotonsIsoCone, "PtSumPhotonsIsoCone");
+    fBufferPool.reset(fTDecayModeFinding, "DecayModeFinding");
+    fBufferPool.reset(fTVLooseIso, "VLooseIso");
+    fBufferPool.reset(fTLooseIso, "LooseIso");
+    fBufferPool.reset(fTTightIso, "TightIso");
+    fBufferPool.reset(fTMediumIso, "MediumIso");
+    fBufferPool.reset(fTVLooseChargedIso, "VLooseChargedIso");
+    fBufferPool.reset(fTLooseChargedIso, "LooseChargedIso");
+    fBufferPool.reset(fTTightChargedIso, "TightChargedIso");
+    fBufferPool.reset(fTMediumChargedIso, "MediumChargedIso");
+    fBufferPool.reset(fTVLooseIsoDBSumPtCorr, "VLooseIsoDBSumPtCorr");
+    fBufferPool.reset(fTLooseIsoDBSumPtCorr, "LooseIsoDBSumPtCorr");
+    fBufferPool.reset(fTTightIsoDBSumPtCorr, "TightIsoDBSumPtCorr");
+    fBufferPool.reset(fTMediumIsoDBSumPtCorr, "MediumIsoDBSumPtCorr");
+    fBufferPool.reset(fTVLooseCombinedIsoDBSumPtCorr, "VLooseCombinedIsoDBSumPtCorr");
+    fBufferPool.reset(fTLooseCombinedIsoDBSumPtCorr, "LooseCombinedIsoDBSumPtCorr");
+    fBufferPool.reset(fTTightCombinedIsoDBSumPtCorr, "TightCombinedIsoDBSumPtCorr");
+    fBufferPool.reset(fTMediumCombinedIsoDBSumPtCorr, "MediumCombinedIsoDBSumPtCorr");
+    fBufferPool.reset(fTLooseCombinedIsoDBSumPtCorr3Hits, "LooseCombinedIsoDBSumPtCorr3Hits");
+    fBufferPool.reset(fTTightCombinedIsoDBSumPtCorr3Hits, "TightCombinedIsoDBSumPtCorr3Hits");
+    fBufferPool.reset(fTMediumCombinedIsoDBSumPtCorr3Hits, "MediumCombinedIsoDBSumPtCorr3Hits");
+    fBufferPool.reset(fTIsolationMVAraw, "IsolationMVAraw");
+    fBufferPool.reset(fTLooseIsolationMVA, "LooseIsolationMVA");
+    fBufferPool.reset(fTMediumIsolationMVA, "MediumIsolationMVA");
+    fBufferPool.reset(fTTightIsolationMVA, "TightIsolationMVA");
+    fBufferPool.reset(fTIsolationMVA2raw, "IsolationMVA2raw");
+    fBufferPool.reset(fTLooseIsolationMVA2, "LooseIsolationMVA2");
+    fBufferPool.reset(fTMediumIsolationMVA2, "MediumIsolationMVA2");
+    fBufferPool.reset(fTTightIsolationMVA2, "TightIsolationMVA2");
+    fBufferPool.reset(fTLooseElectronRejection, "LooseElectronRejection");
+    fBufferPool.reset(fTTightElectronRejection, "TightElectronRejection");
+    fBufferPool.reset(fTMediumElectronRejection, "MediumElectronRejection");
+    fBufferPool.reset(fTElectronMVARejection, "ElectronMVARejection");
+    fBufferPool.reset(fTLooseElectronMVA3Rejection, "LooseElectronMVA3Rejection");
+    fBufferPool.reset(fTMediumElectronMVA3Rejection, "MediumElectronMVA3Rejection");
+    fBufferPool.reset(fTTightElectronMVA3Rejection, "TightElectronMVA3Rejection");
+    fBufferPool.reset(fTVTightElectronMVA3Rejection, "VTightElectronMVA3Rejection");
+    fBufferPool.reset(fTLooseMuonRejection, "LooseMuonRejection");
+    fBufferPool.reset(fTMediumMuonRejection, "MediumMuonRejection");
+    fBufferPool.reset(fTTightMuonRejection, "TightMuonRejection");
+    fBufferPool.reset(fTLooseMuon2Rejection, "LooseMuon2Rejection");
+    fBufferPool.reset(fTMediumMuon2Rejection, "MediumMuon2Rejection");
+    fBufferPool.reset(fTTightMuon2Rejection, "TightMuon2Rejection");
   }else if(fType == El){
-    fTID95.reset(new std::vector<int>);
-    fTID90.reset(new std::vector<int>);
-    fTID85.reset(new std::vector<int>);
-    fTID80.reset(new std::vector<int>);
+    fBufferPool.reset(fTID95, "ID95");
+    fBufferPool.reset(fTID90, "ID90");
+    fBufferPool.reset(fTID85, "ID85");
+    fBufferPool.reset(fTID80, "ID80");
   }else if(fType == Mu){
-    fTMuNMatches.reset(new std::vector<int>);
-    fTPtErr.reset(new std::vector<float>);
+    fBufferPool.reset(fTMuNMatches, "NMatches");
+    fBufferPool.reset(fTPtErr, "PtErr");
   }
   
 
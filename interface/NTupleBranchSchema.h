@@ -0,0 +1,120 @@
+#ifndef __DiLeptonAnalysis_NTupleProducer_NTupleBranchSchema_H__
+#define __DiLeptonAnalysis_NTupleProducer_NTupleBranchSchema_H__
+//
+// Package: NTupleProducer
+// Namespace: NTupleBranches
+//
+/* NTupleBranchSchema.h
+   Description:  branch groups, precision classes and the reset/put helpers
+                 used by the expansions of the branch table NTupleBranches.h.
+
+   A group can be switched off at build time with -DNTP_BUILD_GROUP_<Group>=0,
+   or at run time with the 'disabledBranchGroups' parameter of the producer.
+   The branches of a disabled group are neither declared nor put, and their
+   buffers are allocated once and only cleared at each event.
+*/
+//
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#define NTP_BRANCH_GROUPS(G) \
+  G(Event) G(Gen) G(GenInfo) G(PileUp) G(Trigger) G(TriggerBits) G(TriggerUnpacked) \
+  G(Vertex) G(EBRechit) G(Muon) G(Electron) G(Photon) G(SuperCluster) G(Xtal) G(Jet) G(Track) G(MET) G(PfCand)
+
+#ifndef NTP_BUILD_GROUP_Event
+#define NTP_BUILD_GROUP_Event 1
+#endif
+#ifndef NTP_BUILD_GROUP_Gen
+#define NTP_BUILD_GROUP_Gen 1
+#endif
+#ifndef NTP_BUILD_GROUP_GenInfo
+#define NTP_BUILD_GROUP_GenInfo 1
+#endif
+#ifndef NTP_BUILD_GROUP_PileUp
+#define NTP_BUILD_GROUP_PileUp 1
+#endif
+#ifndef NTP_BUILD_GROUP_Trigger
+#define NTP_BUILD_GROUP_Trigger 1
+#endif
+#ifndef NTP_BUILD_GROUP_TriggerBits
+#define NTP_BUILD_GROUP_TriggerBits 1
+#endif
+#ifndef NTP_BUILD_GROUP_TriggerUnpacked
+#define NTP_BUILD_GROUP_TriggerUnpacked 1
+#endif
+#ifndef NTP_BUILD_GROUP_Vertex
+#define NTP_BUILD_GROUP_Vertex 1
+#endif
+#ifndef NTP_BUILD_GROUP_EBRechit
+#define NTP_BUILD_GROUP_EBRechit 1
+#endif
+#ifndef NTP_BUILD_GROUP_Muon
+#define NTP_BUILD_GROUP_Muon 1
+#endif
+#ifndef NTP_BUILD_GROUP_Electron
+#define NTP_BUILD_GROUP_Electron 1
+#endif
+#ifndef NTP_BUILD_GROUP_Photon
+#define NTP_BUILD_GROUP_Photon 1
+#endif
+#ifndef NTP_BUILD_GROUP_SuperCluster
+#define NTP_BUILD_GROUP_SuperCluster 1
+#endif
+#ifndef NTP_BUILD_GROUP_Xtal
+#define NTP_BUILD_GROUP_Xtal 1
+#endif
+#ifndef NTP_BUILD_GROUP_Jet
+#define NTP_BUILD_GROUP_Jet 1
+#endif
+#ifndef NTP_BUILD_GROUP_Track
+#define NTP_BUILD_GROUP_Track 1
+#endif
+#ifndef NTP_BUILD_GROUP_MET
+#define NTP_BUILD_GROUP_MET 1
+#endif
+#ifndef NTP_BUILD_GROUP_PfCand
+#define NTP_BUILD_GROUP_PfCand 1
+#endif
+
+namespace NTupleBranches {
+
+#define NTP_GROUP_ENUM(g) k##g,
+  enum Group { NTP_BRANCH_GROUPS(NTP_GROUP_ENUM) kNGroups };
+#undef NTP_GROUP_ENUM
+
+  enum Precision { kFull, kReduced };
+
+  /// Name of a group, as used in the configuration
+  const char* groupName(int group);
+  /// Group with the given name, kNGroups if unknown
+  int groupIndex(const std::string& name);
+  /// Whether the group was compiled in (NTP_BUILD_GROUP_<Group>)
+  bool groupBuilt(int group);
+
+  /// Float mantissa truncated to 10 bits (rounded), other types unchanged
+  float reducedPrecision(float value);
+  template <class T> inline void applyPrecision(T&, int) {}
+  inline void applyPrecision(float& value, int precision) {
+    if (precision == kReduced) value = reducedPrecision(value);
+  }
+  inline void applyPrecision(std::vector<float>& values, int precision) {
+    if (precision != kReduced) return;
+    for (std::vector<float>::iterator it = values.begin(); it != values.end(); ++it)
+      *it = reducedPrecision(*it);
+  }
+
+  /// Reset of a branch which is not put: allocate once, then only clear
+  template <class T> inline void resetUnused(std::auto_ptr<T>& product, const T& init) {
+    if (product.get()) *product = init;
+    else product.reset(new T(init));
+  }
+  template <class T> inline void resetUnused(std::auto_ptr<std::vector<T> >& product) {
+    if (product.get()) product->clear();
+    else product.reset(new std::vector<T>);
+  }
+
+}
+
+#endif
@@ -0,0 +1,750 @@
+//
+// Package: NTupleProducer
+// File:    NTupleBranches.h
+//
+/* NTupleBranches.h
+   Description:  table of the regular event branches of the NTupleProducer.
+                 Each entry generates the member, the produces<>() call, the
+                 reset and the put of one branch, depending on how the
+                 including code defines the two macros:
+
+     NTP_SCALAR(type, Name, init,        precision, Group, enabled)
+     NTP_VECTOR(type, Name, reserveHint, precision, Group, enabled)
+
+   type        C++ type of the value (element type for vectors)
+   init        value of a scalar at the start of each event
+   reserveHint minimal capacity of a vector at the start of each event
+   precision   Full, or Reduced to truncate the float mantissa when put
+   Group       branch group, see NTupleBranchSchema.h
+   enabled     false removes the branch from the output
+
+   Array structure for 2D-indexed information: if a branch is named
+   Obj1Obj2ListStart, then Qty_Obj1[Obj2] = Qty[Obj1Obj2ListStart[Obj1]+Obj2].
+
+   No include guard on purpose: this file is included once per expansion.
+   Branches with a non-standard reset or put (arrays of products, run
+   products, branches filled in loops) are still written by hand.
+*/
+//
+
+
+// General event information
+NTP_SCALAR(int,           Run,                                     -999,    Full, Event, true)
+NTP_SCALAR(unsigned int,  Event,                                   0,       Full, Event, true)
+NTP_SCALAR(int,           LumiSection,                             -999,    Full, Event, true)
+NTP_SCALAR(float,         Weight,                                  -999.99, Full, Event, true)
+NTP_SCALAR(float,         Rho,                                     -999.99, Full, Event, true)
+NTP_SCALAR(float,         RhoForIso,                               -999.99, Full, Event, true)
+NTP_SCALAR(int,           CSCTightHaloID,                          -999,    Full, Event, true)
+NTP_SCALAR(int,           NCaloTowers,                             0,       Full, Event, true)
+NTP_SCALAR(int,           GoodEvent,                               0,       Full, Event, true)
+NTP_SCALAR(int,           MaxMuExceed,                             0,       Full, Event, true)
+NTP_SCALAR(int,           MaxElExceed,                             0,       Full, Event, true)
+NTP_SCALAR(int,           MaxJetExceed,                            0,       Full, Event, true)
+NTP_SCALAR(int,           MaxUncJetExceed,                         0,       Full, Event, true)
+NTP_SCALAR(int,           MaxTrkExceed,                            0,       Full, Event, true)
+NTP_SCALAR(int,           MaxPhotonsExceed,                        0,       Full, Event, true)
+NTP_SCALAR(int,           MaxGenLepExceed,                         0,       Full, Event, true)
+NTP_SCALAR(int,           MaxGenPhoExceed,                         0,       Full, Event, true)
+NTP_SCALAR(int,           MaxGenJetExceed,                         0,       Full, Event, true)
+NTP_SCALAR(int,           MaxVerticesExceed,                       0,       Full, Event, true)
+NTP_SCALAR(int,           MaxGenPartExceed,                        -999,    Full, Event, true)
+NTP_SCALAR(float,         Sigma,                                   -999.99, Full, Event, true)
+
+// Generator event information, PDFs, model scan and generator-level objects
+NTP_VECTOR(float,         pdfW,                                    0,       Full, Gen, true)
+NTP_SCALAR(float,         pdfWsum,                                 0.0,     Full, Gen, true)
+NTP_SCALAR(int,           NPdfs,                                   1,       Full, Gen, true)
+NTP_SCALAR(int,           process,                                 -999,    Full, Gen, true)
+NTP_SCALAR(float,         PtHat,                                   -999.99, Full, Gen, true)
+NTP_SCALAR(float,         QCDPartonicHT,                           -999.99, Full, Gen, true)
+NTP_SCALAR(int,           SigProcID,                               -999,    Full, Gen, true)
+NTP_SCALAR(float,         PDFScalePDF,                             -999.99, Full, Gen, true)
+NTP_SCALAR(int,           PDFID1,                                  -999,    Full, Gen, true)
+NTP_SCALAR(int,           PDFID2,                                  -999,    Full, Gen, true)
+NTP_SCALAR(float,         PDFx1,                                   -999.99, Full, Gen, true)
+NTP_SCALAR(float,         PDFx2,                                   -999.99, Full, Gen, true)
+NTP_SCALAR(float,         PDFxPDF1,                                -999.99, Full, Gen, true)
+NTP_SCALAR(float,         PDFxPDF2,                                -999.99, Full, Gen, true)
+NTP_SCALAR(float,         GenWeight,                               -999.99, Full, Gen, true)
+NTP_SCALAR(float,         MassGlu,                                 -999.99, Full, Gen, true)
+NTP_SCALAR(float,         MassChi,                                 -999.99, Full, Gen, true)
+NTP_SCALAR(float,         MassLSP,                                 -999.99, Full, Gen, true)
+NTP_SCALAR(float,         xSMS,                                    -999.99, Full, Gen, true)
+NTP_SCALAR(float,         xbarSMS,                                 -999.99, Full, Gen, true)
+NTP_SCALAR(float,         M0,                                      -999.99, Full, Gen, true)
+NTP_SCALAR(float,         M12,                                     -999.99, Full, Gen, true)
+NTP_SCALAR(float,         A0,                                      -999.99, Full, Gen, true)
+NTP_SCALAR(float,         signMu,                                  -999.99, Full, Gen, true)
+NTP_VECTOR(int,           LHEEventID,                              0,       Full, Gen, true)
+NTP_VECTOR(int,           LHEEventStatus,                          0,       Full, Gen, true)
+NTP_VECTOR(int,           LHEEventMotherFirst,                     0,       Full, Gen, true)
+NTP_VECTOR(int,           LHEEventMotherSecond,                    0,       Full, Gen, true)
+NTP_VECTOR(float,         LHEEventPx,                              0,       Full, Gen, true)
+NTP_VECTOR(float,         LHEEventPy,                              0,       Full, Gen, true)
+NTP_VECTOR(float,         LHEEventPz,                              0,       Full, Gen, true)
+NTP_VECTOR(float,         LHEEventE,                               0,       Full, Gen, true)
+NTP_VECTOR(float,         LHEEventM,                               0,       Full, Gen, true)
+NTP_SCALAR(int,           NGenLeptons,                             0,       Full, Gen, true)
+NTP_VECTOR(int,           GenLeptonID,                             0,       Full, Gen, true)
+NTP_VECTOR(float,         GenLeptonPt,                             0,       Full, Gen, true)
+NTP_VECTOR(float,         GenLeptonEta,                            0,       Full, Gen, true)
+NTP_VECTOR(float,         GenLeptonPhi,                            0,       Full, Gen, true)
+NTP_VECTOR(int,           GenLeptonMID,                            0,       Full, Gen, true)
+NTP_VECTOR(int,           GenLeptonMStatus,                        0,       Full, Gen, true)
+NTP_VECTOR(float,         GenLeptonMPt,                            0,       Full, Gen, true)
+NTP_VECTOR(float,         GenLeptonMEta,                           0,       Full, Gen, true)
+NTP_VECTOR(float,         GenLeptonMPhi,                           0,       Full, Gen, true)
+NTP_VECTOR(int,           GenLeptonGMID,                           0,       Full, Gen, true)
+NTP_VECTOR(int,           GenLeptonGMStatus,                       0,       Full, Gen, true)
+NTP_VECTOR(float,         GenLeptonGMPt,                           0,       Full, Gen, true)
+NTP_VECTOR(float,         GenLeptonGMEta,                          0,       Full, Gen, true)
+NTP_VECTOR(float,         GenLeptonGMPhi,                          0,       Full, Gen, true)
+NTP_SCALAR(int,           NGenPhotons,                             0,       Full, Gen, true)
+NTP_VECTOR(float,         GenPhotonPt,                             0,       Full, Gen, true)
+NTP_VECTOR(float,         GenPhotonEta,                            0,       Full, Gen, true)
+NTP_VECTOR(float,         GenPhotonPhi,                            0,       Full, Gen, true)
+NTP_VECTOR(float,         GenPhotonVx,                             0,       Full, Gen, true)
+NTP_VECTOR(float,         GenPhotonVy,                             0,       Full, Gen, true)
+NTP_VECTOR(float,         GenPhotonVz,                             0,       Full, Gen, true)
+NTP_VECTOR(float,         GenPhotonPartonMindR,                    0,       Full, Gen, true)
+NTP_VECTOR(int,           GenPhotonMotherID,                       0,       Full, Gen, true)
+NTP_VECTOR(int,           GenPhotonMotherStatus,                   0,       Full, Gen, true)
+NTP_SCALAR(int,           NGenJets,                                0,       Full, Gen, true)
+NTP_VECTOR(float,         GenJetPt,                                0,       Full, Gen, true)
+NTP_VECTOR(float,         GenJetEta,                               0,       Full, Gen, true)
+NTP_VECTOR(float,         GenJetPhi,                               0,       Full, Gen, true)
+NTP_VECTOR(float,         GenJetE,                                 0,       Full, Gen, true)
+NTP_VECTOR(float,         GenJetEmE,                               0,       Full, Gen, true)
+NTP_VECTOR(float,         GenJetHadE,                              0,       Full, Gen, true)
+NTP_VECTOR(float,         GenJetInvE,                              0,       Full, Gen, true)
+NTP_SCALAR(float,         GenMET,                                  -999.99, Full, Gen, true)
+NTP_SCALAR(float,         GenMETpx,                                -999.99, Full, Gen, true)
+NTP_SCALAR(float,         GenMETpy,                                -999.99, Full, Gen, true)
+NTP_SCALAR(float,         GenMETphi,                               -999.99, Full, Gen, true)
+NTP_VECTOR(float,         GenPhotonIsoDR03,                        0,       Full, Gen, true)
+NTP_VECTOR(float,         GenPhotonIsoDR04,                        0,       Full, Gen, true)
+
+// Generator particle list
+NTP_SCALAR(int,           nGenParticles,                           0,       Full, GenInfo, true)
+NTP_VECTOR(int,           genInfoId,                               0,       Full, GenInfo, true)
+NTP_VECTOR(int,           genInfoStatus,                           0,       Full, GenInfo, true)
+NTP_VECTOR(int,           genInfoNMo,                              0,       Full, GenInfo, true)
+NTP_VECTOR(int,           genInfoMo1,                              0,       Full, GenInfo, true)
+NTP_VECTOR(int,           genInfoMo2,                              0,       Full, GenInfo, true)
+NTP_VECTOR(int,           PromptnessLevel,                         0,       Full, GenInfo, true)
+NTP_VECTOR(float,         genInfoPt,                               0,       Full, GenInfo, true)
+NTP_VECTOR(float,         genInfoEta,                              0,       Full, GenInfo, true)
+NTP_VECTOR(float,         genInfoPhi,                              0,       Full, GenInfo, true)
+NTP_VECTOR(float,         genInfoM,                                0,       Full, GenInfo, true)
+NTP_VECTOR(float,         genInfoPromptFlag,                       0,       Full, GenInfo, true)
+
+// Pile-up
+NTP_SCALAR(int,           PUnumInteractions,                       -999,    Full, PileUp, true)
+NTP_SCALAR(int,           PUnumTrueInteractions,                   -999,    Full, PileUp, true)
+NTP_SCALAR(int,           PUnumFilled,                             -999,    Full, PileUp, true)
+NTP_SCALAR(int,           PUOOTnumInteractionsEarly,               -999,    Full, PileUp, true)
+NTP_SCALAR(int,           PUOOTnumInteractionsLate,                -999,    Full, PileUp, true)
+NTP_VECTOR(float,         PUzPositions,                            0,       Full, PileUp, true)
+NTP_VECTOR(float,         PUsumPtLowPt,                            0,       Full, PileUp, true)
+NTP_VECTOR(float,         PUsumPtHighPt,                           0,       Full, PileUp, true)
+NTP_VECTOR(float,         PUnTrksLowPt,                            0,       Full, PileUp, true)
+NTP_VECTOR(float,         PUnTrksHighPt,                           0,       Full, PileUp, true)
+NTP_SCALAR(float,         PUWeightTotal,                           -999.99, Full, PileUp, true)
+NTP_SCALAR(float,         PUWeightInTime,                          -999.99, Full, PileUp, true)
+
+// Trigger
+NTP_VECTOR(unsigned long long, HLTResultBits,                       0,       Full, TriggerBits, true)
+NTP_VECTOR(unsigned long long, L1PhysResultBits,                    0,       Full, TriggerBits, true)
+NTP_VECTOR(unsigned long long, L1TechResultBits,                    0,       Full, TriggerBits, true)
+NTP_VECTOR(int,           HLTResults,                              0,       Full, TriggerUnpacked, true)
+NTP_VECTOR(int,           HLTPrescale,                             0,       Full, Trigger, true)
+NTP_VECTOR(int,           L1PhysResults,                           0,       Full, TriggerUnpacked, true)
+NTP_VECTOR(int,           L1TechResults,                           0,       Full, TriggerUnpacked, true)
+NTP_VECTOR(int,           NHLTObjs,                                0,       Full, Trigger, true)
+
+// Beam spot and vertices
+NTP_SCALAR(int,           PrimVtxGood,                             -999,    Full, Vertex, true)
+NTP_SCALAR(float,         PrimVtxx,                                -999.99, Full, Vertex, true)
+NTP_SCALAR(float,         PrimVtxy,                                -999.99, Full, Vertex, true)
+NTP_SCALAR(float,         PrimVtxz,                                -999.99, Full, Vertex, true)
+NTP_SCALAR(float,         PrimVtxRho,                              -999.99, Full, Vertex, true)
+NTP_SCALAR(float,         PrimVtxxE,                               -999.99, Full, Vertex, true)
+NTP_SCALAR(float,         PrimVtxyE,                               -999.99, Full, Vertex, true)
+NTP_SCALAR(float,         PrimVtxzE,                               -999.99, Full, Vertex, true)
+NTP_SCALAR(float,         PrimVtxNChi2,                            -999.99, Full, Vertex, true)
+NTP_SCALAR(float,         PrimVtxNdof,                             -999.99, Full, Vertex, true)
+NTP_SCALAR(int,           PrimVtxIsFake,                           -999,    Full, Vertex, true)
+NTP_SCALAR(float,         PrimVtxPtSum,                            -999.99, Full, Vertex, true)
+NTP_SCALAR(float,         Beamspotx,                               -999.99, Full, Vertex, true)
+NTP_SCALAR(float,         Beamspoty,                               -999.99, Full, Vertex, true)
+NTP_SCALAR(float,         Beamspotz,                               -999.99, Full, Vertex, true)
+NTP_SCALAR(int,           NVrtx,                                   0,       Full, Vertex, true)
+NTP_VECTOR(float,         VrtxX,                                   0,       Full, Vertex, true)
+NTP_VECTOR(float,         VrtxY,                                   0,       Full, Vertex, true)
+NTP_VECTOR(float,         VrtxZ,                                   0,       Full, Vertex, true)
+NTP_VECTOR(float,         VrtxXE,                                  0,       Full, Vertex, true)
+NTP_VECTOR(float,         VrtxYE,                                  0,       Full, Vertex, true)
+NTP_VECTOR(float,         VrtxZE,                                  0,       Full, Vertex, true)
+NTP_VECTOR(float,         VrtxNdof,                                0,       Full, Vertex, true)
+NTP_VECTOR(float,         VrtxChi2,                                0,       Full, Vertex, true)
+NTP_VECTOR(float,         VrtxNtrks,                               0,       Full, Vertex, true)
+NTP_VECTOR(float,         VrtxSumPt,                               0,       Full, Vertex, true)
+NTP_VECTOR(int,           VrtxIsFake,                              0,       Full, Vertex, true)
+
+// Barrel rechits
+NTP_SCALAR(int,           NEBhits,                                 0,       Full, EBRechit, true)
+NTP_VECTOR(float,         EBrechitE,                               0,       Full, EBRechit, true)
+NTP_VECTOR(float,         EBrechitPt,                              0,       Full, EBRechit, true)
+NTP_VECTOR(float,         EBrechitEta,                             0,       Full, EBRechit, true)
+NTP_VECTOR(float,         EBrechitPhi,                             0,       Full, EBRechit, true)
+NTP_VECTOR(float,         EBrechitChi2,                            0,       Full, EBRechit, true)
+NTP_VECTOR(float,         EBrechitTime,                            0,       Full, EBRechit, true)
+NTP_VECTOR(float,         EBrechitE4oE1,                           0,       Full, EBRechit, true)
+NTP_VECTOR(float,         EBrechitE2oE9,                           0,       Full, EBRechit, true)
+
+// Muons
+NTP_SCALAR(int,           NMus,                                    0,       Full, Muon, true)
+NTP_SCALAR(int,           NMusTot,                                 0,       Full, Muon, true)
+NTP_SCALAR(int,           NGMus,                                   0,       Full, Muon, true)
+NTP_SCALAR(int,           NTMus,                                   0,       Full, Muon, true)
+NTP_VECTOR(int,           MuGood,                                  0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsIso,                                 0,       Full, Muon, true)
+NTP_VECTOR(int,           MuTrigMatch,                             0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsGlobalMuon,                          0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsTrackerMuon,                         0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsPFMuon,                              0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsStandaloneMuon,                      0,       Full, Muon, true)
+NTP_VECTOR(float,         MuPx,                                    0,       Full, Muon, true)
+NTP_VECTOR(float,         MuPy,                                    0,       Full, Muon, true)
+NTP_VECTOR(float,         MuPz,                                    0,       Full, Muon, true)
+NTP_VECTOR(float,         MuPt,                                    0,       Full, Muon, true)
+NTP_VECTOR(float,         MuInnerTkPt,                             0,       Full, Muon, true)
+NTP_VECTOR(float,         MuPtE,                                   0,       Full, Muon, true)
+NTP_VECTOR(float,         MuTkPtE,                                 0,       Full, Muon, true)
+NTP_VECTOR(float,         MuTkD0E,                                 0,       Full, Muon, true)
+NTP_VECTOR(float,         MuTkDzE,                                 0,       Full, Muon, true)
+NTP_VECTOR(float,         MuE,                                     0,       Full, Muon, true)
+NTP_VECTOR(float,         MuEt,                                    0,       Full, Muon, true)
+NTP_VECTOR(float,         MuEta,                                   0,       Full, Muon, true)
+NTP_VECTOR(float,         MuPhi,                                   0,       Full, Muon, true)
+NTP_VECTOR(int,           MuCharge,                                0,       Full, Muon, true)
+NTP_VECTOR(float,         MuRelIso03,                              0,       Full, Muon, true)
+NTP_VECTOR(float,         MuIso03SumPt,                            0,       Full, Muon, true)
+NTP_VECTOR(float,         MuIso03EmEt,                             0,       Full, Muon, true)
+NTP_VECTOR(float,         MuIso03HadEt,                            0,       Full, Muon, true)
+NTP_VECTOR(float,         MuIso03EMVetoEt,                         0,       Full, Muon, true)
+NTP_VECTOR(float,         MuIso03HadVetoEt,                        0,       Full, Muon, true)
+NTP_VECTOR(float,         MuIso05SumPt,                            0,       Full, Muon, true)
+NTP_VECTOR(float,         MuIso05EmEt,                             0,       Full, Muon, true)
+NTP_VECTOR(float,         MuIso05HadEt,                            0,       Full, Muon, true)
+NTP_VECTOR(float,         MuPfIsoR03ChHad,                         0,       Full, Muon, true)
+NTP_VECTOR(float,         MuPfIsoR03NeHad,                         0,       Full, Muon, true)
+NTP_VECTOR(float,         MuPfIsoR03Photon,                        0,       Full, Muon, true)
+NTP_VECTOR(float,         MuPfIsoR03NeHadHighThresh,               0,       Full, Muon, true)
+NTP_VECTOR(float,         MuPfIsoR03PhotonHighThresh,              0,       Full, Muon, true)
+NTP_VECTOR(float,         MuPfIsoR03SumPUPt,                       0,       Full, Muon, true)
+NTP_VECTOR(float,         MuPfIsoR04ChHad,                         0,       Full, Muon, true)
+NTP_VECTOR(float,         MuPfIsoR04NeHad,                         0,       Full, Muon, true)
+NTP_VECTOR(float,         MuPfIsoR04Photon,                        0,       Full, Muon, true)
+NTP_VECTOR(float,         MuPfIsoR04NeHadHighThresh,               0,       Full, Muon, true)
+NTP_VECTOR(float,         MuPfIsoR04PhotonHighThresh,              0,       Full, Muon, true)
+NTP_VECTOR(float,         MuPfIsoR04SumPUPt,                       0,       Full, Muon, true)
+NTP_VECTOR(float,         MuEem,                                   0,       Full, Muon, true)
+NTP_VECTOR(float,         MuEhad,                                  0,       Full, Muon, true)
+NTP_VECTOR(float,         MuD0BS,                                  0,       Full, Muon, true)
+NTP_VECTOR(float,         MuD0PV,                                  0,       Full, Muon, true)
+NTP_VECTOR(float,         MuD03DPV,                                0,       Full, Muon, true)
+NTP_VECTOR(float,         MuD03DE,                                 0,       Full, Muon, true)
+NTP_VECTOR(float,         MuD0E,                                   0,       Full, Muon, true)
+NTP_VECTOR(float,         MuDzBS,                                  0,       Full, Muon, true)
+NTP_VECTOR(float,         MuDzPV,                                  0,       Full, Muon, true)
+NTP_VECTOR(float,         MuDzE,                                   0,       Full, Muon, true)
+NTP_VECTOR(float,         MuNChi2,                                 0,       Full, Muon, true)
+NTP_VECTOR(int,           MuNGlHits,                               0,       Full, Muon, true)
+NTP_VECTOR(int,           MuNGlMuHits,                             0,       Full, Muon, true)
+NTP_VECTOR(int,           MuNMuHits,                               0,       Full, Muon, true)
+NTP_VECTOR(int,           MuNTkHits,                               0,       Full, Muon, true)
+NTP_VECTOR(int,           MuNPxHits,                               0,       Full, Muon, true)
+NTP_VECTOR(float,         MuInnerTkNChi2,                          0,       Full, Muon, true)
+NTP_VECTOR(int,           MuNSiLayers,                             0,       Full, Muon, true)
+NTP_VECTOR(int,           MuNMatches,                              0,       Full, Muon, true)
+NTP_VECTOR(int,           MuNMatchedStations,                      0,       Full, Muon, true)
+NTP_VECTOR(int,           MuNChambers,                             0,       Full, Muon, true)
+NTP_VECTOR(float,         MuIsoMVA,                                0,       Full, Muon, true)
+NTP_VECTOR(float,         MuCaloComp,                              0,       Full, Muon, true)
+NTP_VECTOR(float,         MuSegmComp,                              0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsGMPT,                                0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsGMTkChiComp,                         0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsGMStaChiComp,                        0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsGMTkKinkTight,                       0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsAllStaMuons,                         0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsAllTrkMuons,                         0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsTrkMuonArbitrated,                   0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsAllArbitrated,                       0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsTMLSLoose,                           0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsTMLSTight,                           0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsTM2DCompLoose,                       0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsTM2DCompTight,                       0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsTMOneStationLoose,                   0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsTMOneStationTight,                   0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsTMLSOptLowPtLoose,                   0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsTMLSAngLoose,                        0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsTMLSAngTight,                        0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsTMOneStationAngTight,                0,       Full, Muon, true)
+NTP_VECTOR(int,           MuIsTMOneStationAngLoose,                0,       Full, Muon, true)
+NTP_VECTOR(int,           MuGenID,                                 0,       Full, Muon, true)
+NTP_VECTOR(int,           MuGenStatus,                             0,       Full, Muon, true)
+NTP_VECTOR(float,         MuGenPt,                                 0,       Full, Muon, true)
+NTP_VECTOR(float,         MuGenEta,                                0,       Full, Muon, true)
+NTP_VECTOR(float,         MuGenPhi,                                0,       Full, Muon, true)
+NTP_VECTOR(float,         MuGenE,                                  0,       Full, Muon, true)
+NTP_VECTOR(int,           MuGenMID,                                0,       Full, Muon, true)
+NTP_VECTOR(int,           MuGenMStatus,                            0,       Full, Muon, true)
+NTP_VECTOR(float,         MuGenMPt,                                0,       Full, Muon, true)
+NTP_VECTOR(float,         MuGenMEta,                               0,       Full, Muon, true)
+NTP_VECTOR(float,         MuGenMPhi,                               0,       Full, Muon, true)
+NTP_VECTOR(float,         MuGenME,                                 0,       Full, Muon, true)
+NTP_VECTOR(int,           MuGenGMID,                               0,       Full, Muon, true)
+NTP_VECTOR(int,           MuGenGMStatus,                           0,       Full, Muon, true)
+NTP_VECTOR(float,         MuGenGMPt,                               0,       Full, Muon, true)
+NTP_VECTOR(float,         MuGenGMEta,                              0,       Full, Muon, true)
+NTP_VECTOR(float,         MuGenGMPhi,                              0,       Full, Muon, true)
+NTP_VECTOR(float,         MuGenGME,                                0,       Full, Muon, true)
+
+// Electrons
+NTP_SCALAR(int,           NEles,                                   0,       Full, Electron, true)
+NTP_SCALAR(int,           NElesTot,                                0,       Full, Electron, true)
+NTP_VECTOR(int,           ElGood,                                  0,       Full, Electron, true)
+NTP_VECTOR(int,           ElIsIso,                                 0,       Full, Electron, true)
+NTP_VECTOR(int,           ElTrigMatch,                             0,       Full, Electron, true)
+NTP_VECTOR(int,           ElChargeMisIDProb,                       0,       Full, Electron, true)
+NTP_VECTOR(float,         ElPx,                                    0,       Full, Electron, true)
+NTP_VECTOR(float,         ElPy,                                    0,       Full, Electron, true)
+NTP_VECTOR(float,         ElPz,                                    0,       Full, Electron, true)
+NTP_VECTOR(float,         ElPt,                                    0,       Full, Electron, true)
+NTP_VECTOR(float,         ElPtE,                                   0,       Full, Electron, true)
+NTP_VECTOR(float,         ElE,                                     0,       Full, Electron, true)
+NTP_VECTOR(float,         ElEt,                                    0,       Full, Electron, true)
+NTP_VECTOR(float,         ElEta,                                   0,       Full, Electron, true)
+NTP_VECTOR(float,         ElTheta,                                 0,       Full, Electron, true)
+NTP_VECTOR(float,         ElSCEta,                                 0,       Full, Electron, true)
+NTP_VECTOR(float,         ElPhi,                                   0,       Full, Electron, true)
+NTP_VECTOR(int,           ElIsEB,                                  0,       Full, Electron, true)
+NTP_VECTOR(int,           ElIsEE,                                  0,       Full, Electron, true)
+NTP_VECTOR(float,         ElGsfTkPt,                               0,       Full, Electron, true)
+NTP_VECTOR(float,         ElGsfTkEta,                              0,       Full, Electron, true)
+NTP_VECTOR(float,         ElGsfTkPhi,                              0,       Full, Electron, true)
+NTP_VECTOR(float,         ElTrkMomentumError,                      0,       Full, Electron, true)
+NTP_VECTOR(float,         ElEcalEnergyError,                       0,       Full, Electron, true)
+NTP_VECTOR(float,         ElEleMomentumError,                      0,       Full, Electron, true)
+NTP_VECTOR(int,           ElNBrems,                                0,       Full, Electron, true)
+NTP_VECTOR(float,         ElD0BS,                                  0,       Full, Electron, true)
+NTP_VECTOR(float,         ElD0PV,                                  0,       Full, Electron, true)
+NTP_VECTOR(float,         ElD0E,                                   0,       Full, Electron, true)
+NTP_VECTOR(float,         ElD03DPV,                                0,       Full, Electron, true)
+NTP_VECTOR(float,         ElD03DE,                                 0,       Full, Electron, true)
+NTP_VECTOR(float,         ElDzBS,                                  0,       Full, Electron, true)
+NTP_VECTOR(float,         ElDzPV,                                  0,       Full, Electron, true)
+NTP_VECTOR(float,         ElDzE,                                   0,       Full, Electron, true)
+NTP_VECTOR(float,         ElRelIso03,                              0,       Full, Electron, true)
+NTP_VECTOR(float,         ElRelIso04,                              0,       Full, Electron, true)
+NTP_VECTOR(float,         ElPfIsoChHad03,                          0,       Full, Electron, true)
+NTP_VECTOR(float,         ElPfIsoNeHad03,                          0,       Full, Electron, true)
+NTP_VECTOR(float,         ElPfIsoPhoton03,                         0,       Full, Electron, true)
+NTP_VECTOR(float,         ElDR03TkSumPt,                           0,       Full, Electron, true)
+NTP_VECTOR(float,         ElDR04TkSumPt,                           0,       Full, Electron, true)
+NTP_VECTOR(float,         ElDR03EcalRecHitSumEt,                   0,       Full, Electron, true)
+NTP_VECTOR(float,         ElDR04EcalRecHitSumEt,                   0,       Full, Electron, true)
+NTP_VECTOR(float,         ElDR03HcalTowerSumEt,                    0,       Full, Electron, true)
+NTP_VECTOR(float,         ElDR04HcalTowerSumEt,                    0,       Full, Electron, true)
+NTP_VECTOR(float,         ElNChi2,                                 0,       Full, Electron, true)
+NTP_VECTOR(float,         ElKfTrkchi2,                             0,       Full, Electron, true)
+NTP_VECTOR(float,         ElKfTrkhits,                             0,       Full, Electron, true)
+NTP_VECTOR(int,           ElCharge,                                0,       Full, Electron, true)
+NTP_VECTOR(int,           ElCInfoIsGsfCtfCons,                     0,       Full, Electron, true)
+NTP_VECTOR(int,           ElCInfoIsGsfCtfScPixCons,                0,       Full, Electron, true)
+NTP_VECTOR(int,           ElCInfoIsGsfScPixCons,                   0,       Full, Electron, true)
+NTP_VECTOR(int,           ElScPixCharge,                           0,       Full, Electron, true)
+NTP_VECTOR(float,         ElClosestCtfTrackPt,                     0,       Full, Electron, true)
+NTP_VECTOR(float,         ElClosestCtfTrackEta,                    0,       Full, Electron, true)
+NTP_VECTOR(float,         ElClosestCtfTrackPhi,                    0,       Full, Electron, true)
+NTP_VECTOR(int,           ElClosestCtfTrackCharge,                 0,       Full, Electron, true)
+NTP_VECTOR(float,         ElIDMva,                                 0,       Full, Electron, true)
+NTP_VECTOR(float,         ElIDMVATrig,                             0,       Full, Electron, true)
+NTP_VECTOR(float,         ElIDMVANoTrig,                           0,       Full, Electron, true)
+NTP_VECTOR(int,           ElInGap,                                 0,       Full, Electron, true)
+NTP_VECTOR(int,           ElEcalDriven,                            0,       Full, Electron, true)
+NTP_VECTOR(int,           ElTrackerDriven,                         0,       Full, Electron, true)
+NTP_VECTOR(int,           ElBasicClustersSize,                     0,       Full, Electron, true)
+NTP_VECTOR(float,         Elfbrem,                                 0,       Full, Electron, true)
+NTP_VECTOR(float,         ElEoPout,                                0,       Full, Electron, true)
+NTP_VECTOR(float,         ElIoEmIoP,                               0,       Full, Electron, true)
+NTP_VECTOR(float,         ElHcalOverEcal,                          0,       Full, Electron, true)
+NTP_VECTOR(float,         ElHcalOverEcalBc,                        0,       Full, Electron, true)
+NTP_VECTOR(float,         ElE1x5,                                  0,       Full, Electron, true)
+NTP_VECTOR(float,         ElE5x5,                                  0,       Full, Electron, true)
+NTP_VECTOR(float,         ElE2x5Max,                               0,       Full, Electron, true)
+NTP_VECTOR(float,         ElR9,                                    0,       Full, Electron, true)
+NTP_VECTOR(float,         ElPreShowerOverRaw,                      0,       Full, Electron, true)
+NTP_VECTOR(float,         ElScEtaWidth,                            0,       Full, Electron, true)
+NTP_VECTOR(float,         ElScPhiWidth,                            0,       Full, Electron, true)
+NTP_VECTOR(float,         ElSigmaIetaIeta,                         0,       Full, Electron, true)
+NTP_VECTOR(float,         ElSigmaIphiIphi,                         0,       Full, Electron, true)
+NTP_VECTOR(float,         ElDeltaPhiSeedClusterAtCalo,             0,       Full, Electron, true)
+NTP_VECTOR(float,         ElDeltaEtaSeedClusterAtCalo,             0,       Full, Electron, true)
+NTP_VECTOR(float,         ElDeltaPhiSuperClusterAtVtx,             0,       Full, Electron, true)
+NTP_VECTOR(float,         ElDeltaEtaSuperClusterAtVtx,             0,       Full, Electron, true)
+NTP_VECTOR(float,         ElCaloEnergy,                            0,       Full, Electron, true)
+NTP_VECTOR(float,         ElTrkMomAtVtx,                           0,       Full, Electron, true)
+NTP_VECTOR(float,         ElESuperClusterOverP,                    0,       Full, Electron, true)
+NTP_VECTOR(int,           ElNumberOfMissingInnerHits,              0,       Full, Electron, true)
+NTP_VECTOR(int,           ElSCindex,                               0,       Full, Electron, true)
+NTP_VECTOR(bool,          ElPassConversionVeto,                    0,       Full, Electron, true)
+NTP_VECTOR(float,         ElConvPartnerTrkDist,                    0,       Full, Electron, true)
+NTP_VECTOR(float,         ElConvPartnerTrkDCot,                    0,       Full, Electron, true)
+NTP_VECTOR(float,         ElConvPartnerTrkPt,                      0,       Full, Electron, true)
+NTP_VECTOR(float,         ElConvPartnerTrkEta,                     0,       Full, Electron, true)
+NTP_VECTOR(float,         ElConvPartnerTrkPhi,                     0,       Full, Electron, true)
+NTP_VECTOR(float,         ElConvPartnerTrkCharge,                  0,       Full, Electron, true)
+NTP_VECTOR(int,           ElScSeedSeverity,                        0,       Full, Electron, true)
+NTP_VECTOR(float,         ElE1OverE9,                              0,       Full, Electron, true)
+NTP_VECTOR(float,         ElS4OverS1,                              0,       Full, Electron, true)
+NTP_VECTOR(int,           ElGenID,                                 0,       Full, Electron, true)
+NTP_VECTOR(int,           ElGenStatus,                             0,       Full, Electron, true)
+NTP_VECTOR(float,         ElGenPt,                                 0,       Full, Electron, true)
+NTP_VECTOR(float,         ElGenEta,                                0,       Full, Electron, true)
+NTP_VECTOR(float,         ElGenPhi,                                0,       Full, Electron, true)
+NTP_VECTOR(float,         ElGenE,                                  0,       Full, Electron, true)
+NTP_VECTOR(int,           ElGenMID,                                0,       Full, Electron, true)
+NTP_VECTOR(int,           ElGenMStatus,                            0,       Full, Electron, true)
+NTP_VECTOR(float,         ElGenMPt,                                0,       Full, Electron, true)
+NTP_VECTOR(float,         ElGenMEta,                               0,       Full, Electron, true)
+NTP_VECTOR(float,         ElGenMPhi,                               0,       Full, Electron, true)
+NTP_VECTOR(float,         ElGenME,                                 0,       Full, Electron, true)
+NTP_VECTOR(int,           ElGenGMID,                               0,       Full, Electron, true)
+NTP_VECTOR(int,           ElGenGMStatus,                           0,       Full, Electron, true)
+NTP_VECTOR(float,         ElGenGMPt,                               0,       Full, Electron, true)
+NTP_VECTOR(float,         ElGenGMEta,                              0,       Full, Electron, true)
+NTP_VECTOR(float,         ElGenGMPhi,                              0,       Full, Electron, true)
+NTP_VECTOR(float,         ElGenGME,                                0,       Full, Electron, true)
+
+// Photons and diphoton vertexing
+NTP_VECTOR(int,           PhoVrtxListStart,                        0,       Full, Photon, true)
+NTP_SCALAR(int,           NPhotons,                                0,       Full, Photon, true)
+NTP_SCALAR(int,           NPhotonsTot,                             0,       Full, Photon, true)
+NTP_VECTOR(bool,          PhoPassConversionVeto,                   0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoGood,                                 0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoIsIso,                                0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoTrigMatch,                            0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoPt,                                   0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoPx,                                   0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoPy,                                   0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoPz,                                   0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoEta,                                  0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoPhi,                                  0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoEnergy,                               0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoIso03Ecal,                            0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoIso03Hcal,                            0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoIso03TrkSolid,                        0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoIso03TrkHollow,                       0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoIso03,                                0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoIso04Ecal,                            0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoIso04Hcal,                            0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoIso04TrkSolid,                        0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoIso04TrkHollow,                       0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoIso04,                                0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoR9,                                   0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoCaloPositionX,                        0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoCaloPositionY,                        0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoCaloPositionZ,                        0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoHoverE,                               0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoH1overE,                              0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoH2overE,                              0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoHoverE2012,                           0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSigmaIetaIeta,                        0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSigmaIetaIphi,                        0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSigmaIphiIphi,                        0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoS4Ratio,                              0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoLambdaRatio,                          0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSCRawEnergy,                          0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSCEtaWidth,                           0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSCSigmaPhiPhi,                        0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoHasPixSeed,                           0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoHasConvTrks,                          0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoScSeedSeverity,                       0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoE1OverE9,                             0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoS4OverS1,                             0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSigmaEtaEta,                          0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSigmaRR,                              0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoHCalIso2012ConeDR03,                  0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoNewIsoPFCharged,                      0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoNewIsoPFPhoton,                       0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoNewIsoPFNeutral,                      0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoE1x5,                                 0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoE2x5,                                 0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoE3x3,                                 0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoE5x5,                                 0,       Full, Photon, true)
+NTP_VECTOR(float,         PhomaxEnergyXtal,                        0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoIso03HcalDepth1,                      0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoIso03HcalDepth2,                      0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoIso04HcalDepth1,                      0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoIso04HcalDepth2,                      0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoIso03nTrksSolid,                      0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoIso03nTrksHollow,                     0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoIso04nTrksSolid,                      0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoIso04nTrksHollow,                     0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoisEB,                                 0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoisEE,                                 0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoisEBEtaGap,                           0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoisEBPhiGap,                           0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoisEERingGap,                          0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoisEEDeeGap,                           0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoisEBEEGap,                            0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoisPFlowPhoton,                        0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoisStandardPhoton,                     0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoMCmatchindex,                         0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoMCmatchexitcode,                      0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoChargedHadronIso,                     0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoNeutralHadronIso,                     0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoPhotonIso,                            0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoisPFPhoton,                           0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoisPFElectron,                         0,       Full, Photon, true)
+NTP_VECTOR(int,           PhotSCindex,                             0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoCiCPFIsoChargedDR03,                  0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoCiCPFIsoNeutralDR03,                  0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoCiCPFIsoPhotonDR03,                   0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoCiCPFIsoChargedDR04,                  0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoCiCPFIsoNeutralDR04,                  0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoCiCPFIsoPhotonDR04,                   0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSCEta,                                0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSCPhiWidth,                           0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoIDMVA,                                0,       Full, Photon, true)
+NTP_SCALAR(int,           Ngv,                                     0,       Full, Photon, true)
+NTP_VECTOR(float,         gvSumPtHi,                               0,       Full, Photon, true)
+NTP_VECTOR(float,         gvSumPtLo,                               0,       Full, Photon, true)
+NTP_VECTOR(int,           gvNTkHi,                                 0,       Full, Photon, true)
+NTP_VECTOR(int,           gvNTkLo,                                 0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoMatchedPFPhotonCand,                  0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoMatchedPFElectronCand,                0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoFootprintPfCandsListStart,            0,       Full, Photon, true)
+NTP_VECTOR(int,           PhoFootprintPfCands,                     0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoVx,                                   0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoVy,                                   0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoVz,                                   0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoRegrEnergy,                           0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoRegrEnergyErr,                        0,       Full, Photon, true)
+NTP_VECTOR(int,           Diphotonsfirst,                          0,       Full, Photon, true)
+NTP_VECTOR(int,           Diphotonssecond,                         0,       Full, Photon, true)
+NTP_VECTOR(int,           Vtxdiphoh2gglobe,                        0,       Full, Photon, true)
+NTP_VECTOR(int,           Vtxdiphomva,                             0,       Full, Photon, true)
+NTP_VECTOR(int,           Vtxdiphoproductrank,                     0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSCRemovalPFIsoCharged,                0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSCRemovalPFIsoChargedPrimVtx,         0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSCRemovalPFIsoNeutral,                0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSCRemovalPFIsoPhoton,                 0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSCRemovalPFIsoChargedRCone,           0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSCRemovalPFIsoChargedPrimVtxRCone,    0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSCRemovalPFIsoChargedVtxConstRCone,   0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSCRemovalPFIsoChargedVtxConst,        0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSCRemovalPFIsoNeutralRCone,           0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSCRemovalPFIsoPhotonRCone,            0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSCRemovalRConeEta,                    0,       Full, Photon, true)
+NTP_VECTOR(float,         PhoSCRemovalRConePhi,                    0,       Full, Photon, true)
+
+// Superclusters
+NTP_SCALAR(int,           NGoodSuperClusters,                      0,       Full, SuperCluster, true)
+NTP_VECTOR(float,         GoodSCEnergy,                            0,       Full, SuperCluster, true)
+NTP_VECTOR(float,         GoodSCEta,                               0,       Full, SuperCluster, true)
+NTP_VECTOR(float,         GoodSCPhi,                               0,       Full, SuperCluster, true)
+NTP_SCALAR(int,           NSuperClusters,                          0,       Full, SuperCluster, true)
+NTP_VECTOR(float,         SCRaw,                                   0,       Full, SuperCluster, true)
+NTP_VECTOR(float,         SCPre,                                   0,       Full, SuperCluster, true)
+NTP_VECTOR(float,         SCEnergy,                                0,       Full, SuperCluster, true)
+NTP_VECTOR(float,         SCEta,                                   0,       Full, SuperCluster, true)
+NTP_VECTOR(float,         SCPhi,                                   0,       Full, SuperCluster, true)
+NTP_VECTOR(float,         SCPhiWidth,                              0,       Full, SuperCluster, true)
+NTP_VECTOR(float,         SCEtaWidth,                              0,       Full, SuperCluster, true)
+NTP_VECTOR(float,         SCBrem,                                  0,       Full, SuperCluster, true)
+NTP_VECTOR(float,         SCR9,                                    0,       Full, SuperCluster, true)
+NTP_VECTOR(float,         SCcrackcorrseed,                         0,       Full, SuperCluster, true)
+NTP_VECTOR(float,         SCcrackcorr,                             0,       Full, SuperCluster, true)
+NTP_VECTOR(float,         SClocalcorrseed,                         0,       Full, SuperCluster, true)
+NTP_VECTOR(float,         SClocalcorr,                             0,       Full, SuperCluster, true)
+NTP_VECTOR(float,         SCcrackcorrseedfactor,                   0,       Full, SuperCluster, true)
+NTP_VECTOR(float,         SClocalcorrseedfactor,                   0,       Full, SuperCluster, true)
+NTP_VECTOR(float,         SCX,                                     0,       Full, SuperCluster, true)
+NTP_VECTOR(float,         SCY,                                     0,       Full, SuperCluster, true)
+NTP_VECTOR(float,         SCZ,                                     0,       Full, SuperCluster, true)
+NTP_VECTOR(int,           SCXtalListStart,                         0,       Full, SuperCluster, true)
+NTP_VECTOR(int,           SCNXtals,                                0,       Full, SuperCluster, true)
+
+// Crystals of the stored superclusters
+NTP_SCALAR(int,           NXtals,                                  0,       Full, Xtal, true)
+NTP_VECTOR(unsigned int,  XtalDetId,                               0,       Full, Xtal, true)
+NTP_VECTOR(float,         XtalX,                                   0,       Full, Xtal, true)
+NTP_VECTOR(float,         XtalY,                                   0,       Full, Xtal, true)
+NTP_VECTOR(float,         XtalZ,                                   0,       Full, Xtal, true)
+NTP_VECTOR(float,         XtalEtaWidth,                            0,       Full, Xtal, true)
+NTP_VECTOR(float,         XtalPhiWidth,                            0,       Full, Xtal, true)
+NTP_VECTOR(float,         XtalFront1X,                             0,       Full, Xtal, true)
+NTP_VECTOR(float,         XtalFront1Y,                             0,       Full, Xtal, true)
+NTP_VECTOR(float,         XtalFront1Z,                             0,       Full, Xtal, true)
+NTP_VECTOR(float,         XtalFront2X,                             0,       Full, Xtal, true)
+NTP_VECTOR(float,         XtalFront2Y,                             0,       Full, Xtal, true)
+NTP_VECTOR(float,         XtalFront2Z,                             0,       Full, Xtal, true)
+NTP_VECTOR(float,         XtalFront3X,                             0,       Full, Xtal, true)
+NTP_VECTOR(float,         XtalFront3Y,                             0,       Full, Xtal, true)
+NTP_VECTOR(float,         XtalFront3Z,                             0,       Full, Xtal, true)
+NTP_VECTOR(float,         XtalFront4X,                             0,       Full, Xtal, true)
+NTP_VECTOR(float,         XtalFront4Y,                             0,       Full, Xtal, true)
+NTP_VECTOR(float,         XtalFront4Z,                             0,       Full, Xtal, true)
+
+// Jets
+NTP_VECTOR(int,           JVrtxListStart,                          0,       Full, Jet, true)
+NTP_SCALAR(int,           NJets,                                   0,       Full, Jet, true)
+NTP_SCALAR(int,           NJetsTot,                                0,       Full, Jet, true)
+NTP_VECTOR(int,           JGood,                                   0,       Full, Jet, true)
+NTP_VECTOR(int,           JTrigMatch,                              0,       Full, Jet, true)
+NTP_VECTOR(float,         JPx,                                     0,       Full, Jet, true)
+NTP_VECTOR(float,         JPy,                                     0,       Full, Jet, true)
+NTP_VECTOR(float,         JPz,                                     0,       Full, Jet, true)
+NTP_VECTOR(float,         JPt,                                     0,       Full, Jet, true)
+NTP_VECTOR(float,         JE,                                      0,       Full, Jet, true)
+NTP_VECTOR(float,         JEt,                                     0,       Full, Jet, true)
+NTP_VECTOR(float,         JEta,                                    0,       Full, Jet, true)
+NTP_VECTOR(float,         JPhi,                                    0,       Full, Jet, true)
+NTP_VECTOR(float,         JEcorr,                                  0,       Full, Jet, true)
+NTP_VECTOR(float,         JArea,                                   0,       Full, Jet, true)
+NTP_VECTOR(float,         JEtaRms,                                 0,       Full, Jet, true)
+NTP_VECTOR(float,         JPhiRms,                                 0,       Full, Jet, true)
+NTP_VECTOR(int,           JNConstituents,                          0,       Full, Jet, true)
+NTP_VECTOR(int,           JNAssoTracks,                            0,       Full, Jet, true)
+NTP_VECTOR(int,           JNNeutrals,                              0,       Full, Jet, true)
+NTP_VECTOR(float,         JChargedEmFrac,                          0,       Full, Jet, true)
+NTP_VECTOR(float,         JNeutralEmFrac,                          0,       Full, Jet, true)
+NTP_VECTOR(float,         JChargedHadFrac,                         0,       Full, Jet, true)
+NTP_VECTOR(float,         JNeutralHadFrac,                         0,       Full, Jet, true)
+NTP_VECTOR(float,         JChargedMuEnergyFrac,                    0,       Full, Jet, true)
+NTP_VECTOR(float,         JPhoFrac,                                0,       Full, Jet, true)
+NTP_VECTOR(float,         JHFHadFrac,                              0,       Full, Jet, true)
+NTP_VECTOR(float,         JHFEMFrac,                               0,       Full, Jet, true)
+NTP_VECTOR(float,         JPtD,                                    0,       Full, Jet, true)
+NTP_VECTOR(float,         JRMSCand,                                0,       Full, Jet, true)
+NTP_VECTOR(float,         JeMinDR,                                 0,       Full, Jet, true)
+NTP_VECTOR(int,           JPartonFlavour,                          0,       Full, Jet, true)
+NTP_VECTOR(float,         JMass,                                   0,       Full, Jet, true)
+NTP_VECTOR(float,         JBetaStar,                               0,       Full, Jet, true)
+NTP_VECTOR(float,         JBeta,                                   0,       Full, Jet, true)
+NTP_VECTOR(float,         JBetaSq,                                 0,       Full, Jet, true)
+NTP_VECTOR(float,         Jtrk1px,                                 0,       Full, Jet, true)
+NTP_VECTOR(float,         Jtrk1py,                                 0,       Full, Jet, true)
+NTP_VECTOR(float,         Jtrk1pz,                                 0,       Full, Jet, true)
+NTP_VECTOR(float,         Jtrk2px,                                 0,       Full, Jet, true)
+NTP_VECTOR(float,         Jtrk2py,                                 0,       Full, Jet, true)
+NTP_VECTOR(float,         Jtrk2pz,                                 0,       Full, Jet, true)
+NTP_VECTOR(float,         Jtrk3px,                                 0,       Full, Jet, true)
+NTP_VECTOR(float,         Jtrk3py,                                 0,       Full, Jet, true)
+NTP_VECTOR(float,         Jtrk3pz,                                 0,       Full, Jet, true)
+NTP_VECTOR(float,         JVtxx,                                   0,       Full, Jet, true)
+NTP_VECTOR(float,         JVtxy,                                   0,       Full, Jet, true)
+NTP_VECTOR(float,         JVtxz,                                   0,       Full, Jet, true)
+NTP_VECTOR(float,         JVtxExx,                                 0,       Full, Jet, true)
+NTP_VECTOR(float,         JVtxEyx,                                 0,       Full, Jet, true)
+NTP_VECTOR(float,         JVtxEyy,                                 0,       Full, Jet, true)
+NTP_VECTOR(float,         JVtxEzy,                                 0,       Full, Jet, true)
+NTP_VECTOR(float,         JVtxEzz,                                 0,       Full, Jet, true)
+NTP_VECTOR(float,         JVtxEzx,                                 0,       Full, Jet, true)
+NTP_VECTOR(float,         JVtxNChi2,                               0,       Full, Jet, true)
+NTP_VECTOR(int,           JGenJetIndex,                            0,       Full, Jet, true)
+NTP_VECTOR(float,         JMetCorrRawEta,                          0,       Full, Jet, true)
+NTP_VECTOR(float,         JMetCorrPhi,                             0,       Full, Jet, true)
+NTP_VECTOR(float,         JMetCorrNoMuPt,                          0,       Full, Jet, true)
+NTP_VECTOR(float,         JMetCorrRawPt,                           0,       Full, Jet, true)
+NTP_VECTOR(float,         JMetCorrEMF,                             0,       Full, Jet, true)
+NTP_VECTOR(float,         JMetCorrArea,                            0,       Full, Jet, true)
+NTP_VECTOR(float,         JQGTagLD,                                0,       Full, Jet, true)
+NTP_VECTOR(float,         JQGTagMLP,                               0,       Full, Jet, true)
+NTP_VECTOR(float,         JSmearedQGL,                             0,       Full, Jet, true)
+
+// Tracks
+NTP_SCALAR(int,           NTracks,                                 0,       Full, Track, true)
+NTP_SCALAR(int,           NTracksTot,                              0,       Full, Track, true)
+NTP_VECTOR(int,           TrkGood,                                 0,       Full, Track, true)
+NTP_VECTOR(float,         TrkPt,                                   0,       Full, Track, true)
+NTP_VECTOR(float,         TrkEta,                                  0,       Full, Track, true)
+NTP_VECTOR(float,         TrkPhi,                                  0,       Full, Track, true)
+NTP_VECTOR(float,         TrkNChi2,                                0,       Full, Track, true)
+NTP_VECTOR(float,         TrkNHits,                                0,       Full, Track, true)
+NTP_VECTOR(float,         TrkVtxDz,                                0,       Full, Track, true)
+NTP_VECTOR(float,         TrkVtxDxy,                               0,       Full, Track, true)
+
+// Missing transverse energy
+NTP_SCALAR(float,         PFType1MET,                              -999.99, Full, MET, true)
+NTP_SCALAR(float,         PFType1METpx,                            -999.99, Full, MET, true)
+NTP_SCALAR(float,         PFType1METpy,                            -999.99, Full, MET, true)
+NTP_SCALAR(float,         PFType1METphi,                           -999.99, Full, MET, true)
+NTP_SCALAR(float,         PFType1METSignificance,                  -999.99, Full, MET, true)
+NTP_SCALAR(float,         PFType1SumEt,                            -999.99, Full, MET, true)
+NTP_SCALAR(float,         TrkPtSumx,                               -999.99, Full, MET, true)
+NTP_SCALAR(float,         TrkPtSumy,                               -999.99, Full, MET, true)
+NTP_SCALAR(float,         TrkPtSum,                                -999.99, Full, MET, true)
+NTP_SCALAR(float,         TrkPtSumPhi,                             -999.99, Full, MET, true)
+NTP_SCALAR(float,         SumEt,                                   -999.99, Full, MET, true)
+NTP_SCALAR(float,         ECALSumEt,                               -999.99, Full, MET, true)
+NTP_SCALAR(float,         HCALSumEt,                               -999.99, Full, MET, true)
+NTP_SCALAR(float,         ECALEsumx,                               -999.99, Full, MET, true)
+NTP_SCALAR(float,         ECALEsumy,                               -999.99, Full, MET, true)
+NTP_SCALAR(float,         ECALEsumz,                               -999.99, Full, MET, true)
+NTP_SCALAR(float,         ECALMET,                                 -999.99, Full, MET, true)
+NTP_SCALAR(float,         ECALMETPhi,                              -999.99, Full, MET, true)
+NTP_SCALAR(float,         ECALMETEta,                              -999.99, Full, MET, true)
+NTP_SCALAR(float,         HCALEsumx,                               -999.99, Full, MET, true)
+NTP_SCALAR(float,         HCALEsumy,                               -999.99, Full, MET, true)
+NTP_SCALAR(float,         HCALEsumz,                               -999.99, Full, MET, true)
+NTP_SCALAR(float,         HCALMET,                                 -999.99, Full, MET, true)
+NTP_SCALAR(float,         HCALMETPhi,                              -999.99, Full, MET, true)
+NTP_SCALAR(float,         HCALMETeta,                              -999.99, Full, MET, true)
+NTP_SCALAR(float,         RawMET,                                  -999.99, Full, MET, true)
+NTP_SCALAR(float,         RawMETpx,                                -999.99, Full, MET, true)
+NTP_SCALAR(float,         RawMETpy,                                -999.99, Full, MET, true)
+NTP_SCALAR(float,         RawMETphi,                               -999.99, Full, MET, true)
+NTP_SCALAR(float,         RawMETemEtFrac,                          -999.99, Full, MET, true)
+NTP_SCALAR(float,         RawMETemEtInEB,                          -999.99, Full, MET, true)
+NTP_SCALAR(float,         RawMETemEtInEE,                          -999.99, Full, MET, true)
+NTP_SCALAR(float,         RawMETemEtInHF,                          -999.99, Full, MET, true)
+NTP_SCALAR(float,         RawMEThadEtFrac,                         -999.99, Full, MET, true)
+NTP_SCALAR(float,         RawMEThadEtInHB,                         -999.99, Full, MET, true)
+NTP_SCALAR(float,         RawMEThadEtInHE,                         -999.99, Full, MET, true)
+NTP_SCALAR(float,         RawMEThadEtInHF,                         -999.99, Full, MET, true)
+NTP_SCALAR(float,         RawMETSignificance,                      -999.99, Full, MET, true)
+NTP_SCALAR(float,         TCMET,                                   -999.99, Full, MET, true)
+NTP_SCALAR(float,         TCMETpx,                                 -999.99, Full, MET, true)
+NTP_SCALAR(float,         TCMETpy,                                 -999.99, Full, MET, true)
+NTP_SCALAR(float,         TCMETphi,                                -999.99, Full, MET, true)
+NTP_SCALAR(float,         TCMETSignificance,                       -999.99, Full, MET, true)
+NTP_SCALAR(float,         MuJESCorrMET,                            -999.99, Full, MET, true)
+NTP_SCALAR(float,         MuJESCorrMETpx,                          -999.99, Full, MET, true)
+NTP_SCALAR(float,         MuJESCorrMETpy,                          -999.99, Full, MET, true)
+NTP_SCALAR(float,         MuJESCorrMETphi,                         -999.99, Full, MET, true)
+NTP_SCALAR(float,         PFMET,                                   -999.99, Full, MET, true)
+NTP_SCALAR(float,         PFMETpx,                                 -999.99, Full, MET, true)
+NTP_SCALAR(float,         PFMETpy,                                 -999.99, Full, MET, true)
+NTP_SCALAR(float,         PFMETphi,                                -999.99, Full, MET, true)
+NTP_SCALAR(float,         PFMETSignificance,                       -999.99, Full, MET, true)
+NTP_SCALAR(float,         PFSumEt,                                 -999.99, Full, MET, true)
+NTP_SCALAR(float,         METR12,                                  -999.99, Full, MET, true)
+NTP_SCALAR(float,         METR21,                                  -999.99, Full, MET, true)
+
+// PF candidates
+NTP_SCALAR(int,           NPfCand,                                 0,       Full, PfCand, true)
+NTP_VECTOR(int,           PfCandPdgId,                             0,       Full, PfCand, true)
+NTP_VECTOR(float,         PfCandEta,                               0,       Full, PfCand, true)
+NTP_VECTOR(float,         PfCandPhi,                               0,       Full, PfCand, true)
+NTP_VECTOR(float,         PfCandEnergy,                            0,       Full, PfCand, true)
+NTP_VECTOR(float,         PfCandEcalEnergy,                        0,       Full, PfCand, true)
+NTP_VECTOR(float,         PfCandPt,                                0,       Full, PfCand, true)
+NTP_VECTOR(float,         PfCandVx,                                0,       Full, PfCand, true)
+NTP_VECTOR(float,         PfCandVy,                                0,       Full, PfCand, true)
+NTP_VECTOR(float,         PfCandVz,                                0,       Full, PfCand, true)
+NTP_VECTOR(int,           PfCandBelongsToJet,                      0,       Full, PfCand, true)
@@ -0,0 +1,43 @@
+#ifndef __DiLeptonAnalysis_NTupleProducer_PFCandidateArrays_H__
+#define __DiLeptonAnalysis_NTupleProducer_PFCandidateArrays_H__
+//
+// Package: NTupleProducer
+// Class:   PFCandidateArrays
+//
+/* class PFCandidateArrays
+   PFCandidateArrays.h
+   Description:  event-scoped structure-of-arrays copy of the PF candidate
+                 kinematics and vertices, for the photon isolation kernels.
+
+   Kinematics are taken from TLorentzVector::SetPtEtaPhiE exactly as in the
+   former per-candidate code, so sums built on these arrays are unchanged.
+*/
+//
+
+#include <vector>
+
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidateFwd.h"
+
+class PFCandidateArrays {
+public:
+  PFCandidateArrays(void) {}
+  ~PFCandidateArrays(void) {}
+
+  /// Copy the collection; types[i] is the FindPFCandType type of pfcands[i]
+  void fill(const reco::PFCandidateCollection& pfcands, const std::vector<int>& types);
+
+  size_t size(void) const { return pt.size(); }
+
+  std::vector<double> pt;
+  std::vector<double> px;
+  std::vector<double> py;
+  std::vector<double> eta;
+  std::vector<double> phi;
+  std::vector<double> vx;
+  std::vector<double> vy;
+  std::vector<double> vz;
+  std::vector<int>    type;
+};
+
+#endif
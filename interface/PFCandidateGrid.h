@@ -0,0 +1,72 @@
+#ifndef __DiLeptonAnalysis_NTupleProducer_PFCandidateGrid_H__
+#define __DiLeptonAnalysis_NTupleProducer_PFCandidateGrid_H__
+//
+// Package: NTupleProducer
+// Class:   PFCandidateGrid
+//
+/* class PFCandidateGrid
+   PFCandidateGrid.h
+   Description:  event-scoped eta-phi binned index over the PF candidates,
+                 split by candidate type (see NTupleProducer::FindPFCandType).
+
+   Cone queries return a superset of the candidates within dR of the axis,
+   as collection indices in ascending order, so that callers applying their
+   own exact selection sum up in the same order as a full linear scan.
+*/
+//
+
+#include <vector>
+
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidateFwd.h"
+
+class PFCandidateGrid {
+public:
+  PFCandidateGrid(int ntypes = 5, int netabins = 100, double etamax = 5.0, int nphibins = 64, double conepad = 0.01);
+  ~PFCandidateGrid(void) {}
+
+  /// Index all candidates with pt>0 and a type in [0,ntypes); types[i] is the type of pfcands[i]
+  void build(const reco::PFCandidateCollection& pfcands, const std::vector<int>& types);
+
+  /// Number of candidates in the collection the grid was built from
+  size_t size(void) const { return fNCands; }
+
+  /// Candidates of a given type in the eta-phi box of half-width dR+conepad around (eta,phi);
+  /// the pad absorbs float rounding of the callers' dR and eta/phi recomputations
+  const std::vector<unsigned>& coneCandidates(int type, double eta, double phi, double dR);
+  /// All indexed candidates of a given type
+  const std::vector<unsigned>& typeCandidates(int type);
+
+  /// True if all indexed candidates of a given type share one production vertex
+  bool hasCommonVertex(int type) const { return fCommonVertex[type]; }
+  const reco::PFCandidate::Point& commonVertex(int type) const { return fVertex[type]; }
+
+private:
+  int etaBin(double eta) const;
+  int phiBin(double phi) const;
+  size_t cell(int type, int ieta, int iphi) const { return ((size_t)type*fNEta + ieta)*fNPhi + iphi; }
+
+  int fNTypes;
+  int fNEta;
+  double fEtaMax;
+  double fEtaWidth;
+  int fNPhi;
+  double fPhiWidth;
+  double fConePad;
+
+  size_t fNCands;
+
+  // Compressed cell storage: candidates of cell c are fCellCands[fCellStart[c]..fCellStart[c+1])
+  std::vector<unsigned> fCellStart;
+  std::vector<unsigned> fCellCands;
+  std::vector<unsigned> fCandCell;
+  // Per-type candidate lists, in collection order
+  std::vector<std::vector<unsigned> > fTypeCands;
+
+  std::vector<bool> fCommonVertex;
+  std::vector<reco::PFCandidate::Point> fVertex;
+
+  std::vector<unsigned> fQuery;
+};
+
+#endif
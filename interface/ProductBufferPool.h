@@ -0,0 +1,80 @@
+#ifndef __DiLeptonAnalysis_NTupleProducer_ProductBufferPool_H__
+#define __DiLeptonAnalysis_NTupleProducer_ProductBufferPool_H__
+//
+// Package: NTupleProducer
+// Class:   ProductBufferPool
+//
+/* class ProductBufferPool
+   ProductBufferPool.h
+   Description:  hands out the per-event vector products pre-reserved to the
+                 largest size seen so far for that branch.
+
+   Products are handed over to the event with edm::Event::put(std::auto_ptr),
+   so the buffers themselves cannot be recycled. Instead each branch keeps a
+   high-water mark of its size at put time, and the vector of the next event
+   is reserved to it, so it does not regrow from zero capacity.
+   Usage: reset() in resetProducts(), collect() at the start of putProducts().
+*/
+//
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class ProductBufferPool {
+public:
+  ProductBufferPool(void) {}
+  ~ProductBufferPool(void) {}
+
+  /// Replace the product with a new vector, reserved to the branch high-water mark
+  /// or to minReserve, whichever is larger
+  template <class T> void reset(std::auto_ptr<std::vector<T> >& product, const char* name, size_t minReserve=0);
+
+  /// Record the sizes of all products before they are put in the event
+  void collect(void);
+
+  /// Log the allocations avoided, in total and per branch
+  void report(const std::string& title) const;
+
+  /// Estimated number of allocations avoided so far, all branches
+  unsigned long nAvoided(void) const;
+
+private:
+  typedef size_t (*SizeFunction)(const void*);
+
+  struct Entry {
+    const void*   owner;    // address of the auto_ptr member
+    SizeFunction  size;
+    std::string   name;
+    size_t        highWater;
+    size_t        reserved; // capacity handed out for the current event
+    unsigned long nPut;
+    unsigned long nAvoided;
+  };
+
+  template <class T> static size_t vectorSize(const void* owner) {
+    const std::vector<T>* v = static_cast<const std::auto_ptr<std::vector<T> >*>(owner)->get();
+    return v ? v->size() : 0;
+  }
+
+  Entry& entry(const void* owner, SizeFunction size, const char* name);
+
+  std::vector<Entry> fEntries;
+  std::map<const void*,size_t> fIndex;
+};
+
+//________________________________________________________________________________________
+template <class T>
+void ProductBufferPool::reset(std::auto_ptr<std::vector<T> >& product, const char* name, size_t minReserve) {
+
+  Entry& e = entry(&product, &vectorSize<T>, name);
+  std::vector<T>* v = new std::vector<T>;
+  size_t n = e.highWater > minReserve ? e.highWater : minReserve;
+  if (n > 0) v->reserve(n);
+  e.reserved = n;
+  product.reset(v);
+
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef __DiLeptonAnalysis_NTupleProducer_StageScheduler_H__
+#define __DiLeptonAnalysis_NTupleProducer_StageScheduler_H__
+//
+// Package: NTupleProducer
+// Class:   StageScheduler
+//
+/* class StageScheduler
+   StageScheduler.h
+   Description:  runs a fixed graph of tasks once per event on a small pool of
+                 threads; a task starts as soon as all the tasks it depends on
+                 are done.
+
+   With one thread the tasks are run in the calling thread in the order they
+   were added, and the first task returning false stops the run, exactly as a
+   plain loop would. With more threads the calling thread works as well, and
+   the tasks not yet started are skipped once a task returned false or threw.
+   The first exception is re-thrown by run() after all running tasks are done.
+*/
+//
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/function.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+class StageScheduler {
+public:
+  typedef boost::function<bool (void)> Task;
+
+  /// Start nThreads-1 worker threads (none for nThreads <= 1)
+  explicit StageScheduler(unsigned nThreads);
+  ~StageScheduler(void);
+
+  /// Add a task to be run after the given tasks (which must already be added)
+  unsigned add(const Task& task, const std::vector<unsigned>& after);
+
+  /// Run all tasks once; false if any task returned false
+  bool run(void);
+
+  unsigned nThreads(void) const { return fNThreads; }
+
+private:
+  StageScheduler(const StageScheduler&);
+  StageScheduler& operator=(const StageScheduler&);
+
+  struct Node {
+    Task task;
+    std::vector<unsigned> next; // tasks waiting for this one
+    unsigned nAfter;            // number of tasks this one waits for
+    unsigned nPending;          // of which not yet done in this run
+  };
+
+  void work(void);
+  void execute(unsigned node, boost::mutex::scoped_lock& lock);
+
+  std::vector<Node> fNodes;
+  unsigned fNThreads;
+
+  // Shared between the threads, protected by fMutex
+  boost::mutex fMutex;
+  boost::condition_variable fWake;
+  std::deque<unsigned> fReady;
+  unsigned fNDone;
+  bool fAccept;
+  bool fStop;
+  std::auto_ptr<cms::Exception> fError;
+
+  boost::thread_group fWorkers;
+};
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef __DiLeptonAnalysis_NTupleProducer_StageTimer_H__
+#define __DiLeptonAnalysis_NTupleProducer_StageTimer_H__
+//
+// Package: NTupleProducer
+// Class:   StageTimer
+//
+/* class StageTimer
+   StageTimer.h
+   Description:  wall-clock timers for the stages of the NTupleProducer event
+                 loop, with mean, median, 99% quantile and share of the total
+                 time per stage.
+
+   Quantiles are taken from a logarithmic histogram of the per-event latency
+   (50 bins per decade from 100 ns to 1000 s), so the memory does not grow
+   with the number of events. Each stage keeps its own start time, so
+   different stages may be timed concurrently.
+   Usage: add() every stage once, then start()/stop() around each call.
+*/
+//
+
+#include <string>
+#include <vector>
+
+class StageTimer {
+public:
+  StageTimer(void) {}
+  ~StageTimer(void) {}
+
+  /// Register a stage, returns its index
+  unsigned add(const std::string& name);
+
+  void start(unsigned stage) { fStages[stage].start = now(); }
+  void stop(unsigned stage);
+
+  /// Log one line per stage: calls, mean, p50, p99 (in ms) and share of the total
+  void report(const std::string& title) const;
+
+  /// Monotonic wall-clock time in seconds
+  static double now(void);
+
+private:
+  struct Stage {
+    std::string   name;
+    double        start;
+    double        sum;
+    double        max;
+    unsigned long n;
+    std::vector<unsigned long> hist;
+  };
+
+  double quantile(const Stage& s, double q) const;
+
+  std::vector<Stage> fStages;
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef __DiLeptonAnalysis_NTupleProducer_TrackVertexTable_H__
+#define __DiLeptonAnalysis_NTupleProducer_TrackVertexTable_H__
+//
+// Package: NTupleProducer
+// Class:   TrackVertexTable
+//
+/* class TrackVertexTable
+   TrackVertexTable.h
+   Description:  event-scoped association between the vertices and the tracks
+                 they were fitted with, readable in both directions: the
+                 tracks of a vertex (with their weights) and the vertices of
+                 a track, looked up by the track Ref (product id and key).
+
+   Both directions are stored in compressed arrays, built in two passes over
+   the vertex tracks; the vertices of a track are in increasing index order.
+*/
+//
+
+#include <vector>
+
+#include "DataFormats/Provenance/interface/ProductID.h"
+#include "DataFormats/VertexReco/interface/Vertex.h"
+#include "DataFormats/VertexReco/interface/VertexFwd.h"
+
+class TrackVertexTable {
+public:
+  struct Entry {
+    unsigned vertex;
+    unsigned collection; // index of the track product id, see productID()
+    unsigned key;        // track key in that collection
+    float    weight;     // weight of the track in the vertex fit
+  };
+  typedef std::vector<Entry>::const_iterator const_iterator;
+
+  TrackVertexTable(void) {}
+  ~TrackVertexTable(void) {}
+
+  void fill(const reco::VertexCollection& vertices);
+
+  /// Tracks of a vertex, in the order of the vertex
+  const_iterator vertexBegin(unsigned vertex) const { return fEntries.begin() + fVertexStart[vertex]; }
+  const_iterator vertexEnd(unsigned vertex)   const { return fEntries.begin() + fVertexStart[vertex+1]; }
+
+  /// Vertices of a track, an empty range if the track is in none
+  std::pair<const Entry* const*, const Entry* const*> trackVertices(const edm::ProductID& id, size_t key) const;
+
+  const edm::ProductID& productID(unsigned collection) const { return fCollections[collection].id; }
+
+private:
+  struct Collection {
+    edm::ProductID id;
+    std::vector<unsigned> start; // per key, into fTrackEntries; size nkeys+1
+  };
+  int collectionIndex(const edm::ProductID& id) const;
+
+  std::vector<Entry> fEntries;              // grouped by vertex
+  std::vector<unsigned> fVertexStart;       // per vertex, into fEntries; size nvertices+1
+  std::vector<Collection> fCollections;     // in practice a single track collection
+  std::vector<const Entry*> fTrackEntries;  // grouped by track
+};
+
+#endif
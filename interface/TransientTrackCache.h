@@ -0,0 +1,65 @@
+#ifndef __DiLeptonAnalysis_NTupleProducer_TransientTrackCache_H__
+#define __DiLeptonAnalysis_NTupleProducer_TransientTrackCache_H__
+//
+// Package: NTupleProducer
+// Class:   TransientTrackCache
+//
+/* class TransientTrackCache
+   TransientTrackCache.h
+   Description:  per-event cache of the transient tracks, keyed by the track
+                 Ref, so that a track used by several blocks (a muon or an
+                 electron and the jet it is in) is built only once per event.
+
+   Usage: call newEvent() with the builder at the start of each event, then
+   get() the transient track of a track or GSF track Ref. get() may be called
+   from concurrent stages, but a transient track is not thread-safe (shared
+   reference count, lazily computed states): stages using the same tracks
+   must not run at the same time.
+*/
+//
+
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+
+#include "DataFormats/TrackReco/interface/TrackFwd.h"
+#include "DataFormats/GsfTrackReco/interface/GsfTrackFwd.h"
+#include "TrackingTools/TransientTrack/interface/TransientTrack.h"
+
+class TransientTrackBuilder;
+
+class TransientTrackCache {
+public:
+  TransientTrackCache(void);
+  ~TransientTrackCache(void) {}
+
+  /// Drop the tracks of the previous event
+  void newEvent(const TransientTrackBuilder* builder);
+
+  reco::TransientTrack get(const reco::TrackRef& track);
+  reco::TransientTrack get(const reco::GsfTrackRef& track);
+
+  /// Counters summed over all events
+  unsigned long nTotRequests(void) const { return fNTotRequests; }
+  unsigned long nTotBuilds(void)   const { return fNTotBuilds; }
+
+private:
+  TransientTrackCache(const TransientTrackCache&);
+  TransientTrackCache& operator=(const TransientTrackCache&);
+
+  typedef boost::unordered_map<unsigned long long, reco::TransientTrack> TrackMap;
+
+  bool find(unsigned long long key, reco::TransientTrack& track);
+  void insert(unsigned long long key, const reco::TransientTrack& track);
+  static unsigned long long key(const edm::ProductID& id, size_t index) {
+    return ((unsigned long long)id.processIndex() << 48) | ((unsigned long long)id.productIndex() << 32) | index;
+  }
+
+  const TransientTrackBuilder* fBuilder;
+  TrackMap fTracks;
+  boost::mutex fMutex;
+
+  unsigned long fNTotRequests;
+  unsigned long fNTotBuilds;
+};
+
+#endif
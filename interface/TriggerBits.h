@@ -0,0 +1,76 @@
+#ifndef __DiLeptonAnalysis_NTupleProducer_TriggerBits_H__
+#define __DiLeptonAnalysis_NTupleProducer_TriggerBits_H__
+//
+// Package: NTupleProducer
+// Class:   TriggerBits
+//
+/* class TriggerBits
+   TriggerBits.h
+   Description:  packed trigger decisions, as stored in the HLTResultBits,
+                 L1PhysResultBits and L1TechResultBits branches: bit i of
+                 the decision list is bit (i%64) of word i/64.
+
+   On the reader side, give it the words of the event and, to test paths by
+   name, the names of the run (HLTNames or L1PhysMenu of the run tree):
+
+     TriggerBits hlt(HLTResultBits, HLTNames);
+     if (hlt.fired("HLT_Mu17_Mu8_v16")) ...
+
+   Header only and without framework dependencies, so that it can be used
+   from ROOT macros as well.
+*/
+//
+
+#include <map>
+#include <string>
+#include <vector>
+
+class TriggerBits {
+public:
+  typedef unsigned long long Word;
+  static const unsigned int kBitsPerWord = 64;
+
+  TriggerBits(void) : fWords(0) {}
+  TriggerBits(const std::vector<Word>* words, const std::vector<std::string>* names = 0) : fWords(words) {
+    setNames(names);
+  }
+
+  /// Writer side: the words for nbits decisions, all off
+  static void clear(std::vector<Word>& words, unsigned int nbits) {
+    words.assign((nbits + kBitsPerWord - 1)/kBitsPerWord, 0);
+  }
+  static void set(std::vector<Word>& words, unsigned int bit) {
+    words[bit/kBitsPerWord] |= Word(1) << (bit%kBitsPerWord);
+  }
+
+  /// Reader side: the words change with each event, the names with each run
+  void setWords(const std::vector<Word>* words) { fWords = words; }
+  void setNames(const std::vector<std::string>* names) {
+    fIndex.clear();
+    if (names == 0) return;
+    for (size_t i = 0; i < names->size(); ++i)
+      if (!(*names)[i].empty()) fIndex.insert(std::make_pair((*names)[i], i));
+  }
+
+  /// Decision of a bit; false beyond the stored bits
+  bool fired(unsigned int bit) const {
+    if (fWords == 0 || bit/kBitsPerWord >= fWords->size()) return false;
+    return ((*fWords)[bit/kBitsPerWord] >> (bit%kBitsPerWord)) & 1;
+  }
+  /// Decision of a path; false if the name is not in the menu
+  bool fired(const std::string& name) const {
+    int bit = index(name);
+    return bit >= 0 && fired((unsigned int)bit);
+  }
+  /// Bit of a path, -1 if the name is not in the menu
+  int index(const std::string& name) const {
+    std::map<std::string, unsigned int>::const_iterator it = fIndex.find(name);
+    return it == fIndex.end() ? -1 : int(it->second);
+  }
+
+private:
+  const std::vector<Word>* fWords;
+  std::map<std::string, unsigned int> fIndex;
+};
+
+#endif
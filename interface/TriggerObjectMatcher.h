@@ -0,0 +1,45 @@
+#ifndef __DiLeptonAnalysis_NTupleProducer_TriggerObjectMatcher_H__
+#define __DiLeptonAnalysis_NTupleProducer_TriggerObjectMatcher_H__
+//
+// Package: NTupleProducer
+// Class:   TriggerObjectMatcher
+//
+/* class TriggerObjectMatcher
+   TriggerObjectMatcher.h
+   Description:  event-scoped matching of offline objects to HLT objects.
+                 Each trigger object carries the mask of the filters it
+                 passed (bit f for filter f); a match returns the OR of the
+                 masks of the trigger objects within the given dR.
+
+   The trigger objects are kept sorted in eta, so that a query only looks
+   at the ones inside its cone.
+*/
+//
+
+#include <vector>
+
+class TriggerObjectMatcher {
+public:
+  static const unsigned int kMaxFilters = 32;
+
+  TriggerObjectMatcher(void) {}
+  ~TriggerObjectMatcher(void) {}
+
+  void clear(void) { fObjects.clear(); }
+  void add(double eta, double phi, unsigned int mask);
+  /// To be called after the last add() and before the first match()
+  void build(void);
+
+  unsigned int match(double eta, double phi, double maxDR) const;
+
+private:
+  struct Object {
+    double eta;
+    double phi;
+    unsigned int mask;
+    bool operator<(const Object& other) const { return eta < other.eta; }
+  };
+  std::vector<Object> fObjects;
+};
+
+#endif
@@ -0,0 +1,6 @@
+#include "FWCore/Framework/interface/MakerMacros.h"
+
+#include "DiLeptonAnalysis/NTupleProducer/interface/NTupleProducer.h"
+
+//define this as a plug-in
+DEFINE_FWK_MODULE(NTupleProducer);
@@ -47,6 +47,11 @@ analyze = cms.EDFilter('NTupleProducer',
         hlt_labels = cms.vstring('HLT_IsoMu24_eta2p1_v',
                                  'HLT_Ele27_WP80_v',
                                  'HLT_Photon36_R9Id85_OR_CaloId10_Iso50_Photon22_R9Id85_OR_CaloId10_Iso50_v'),
+	# HLT filters to match the muons, electrons, photons and jets to (at most 32): bit i of
+	# MuTrigMatch, ElTrigMatch, PhoTrigMatch and JTrigMatch is set for a match to filter i
+	trigmatch_filters   = cms.vstring(),
+	trigmatch_deltaR    = cms.double(0.2),
+	trigmatch_jetDeltaR = cms.double(0.3),
 	# Event Selection Criteria
 	# Muons:
 	sel_minmupt       = cms.double(5.0),
@@ -98,6 +103,18 @@ analyze = cms.EDFilter('NTupleProducer',
 	pu_mc   = cms.vstring('', ''), # replace this by cms.vstring('mc_pileup.root'  , 'name_of_histo')
 
         tag_doPhotonStuff = cms.bool(False), # overwritten from test/ntupleproducer_cfg.py
+        # store only the XtalDetId of the crystals in each event, and their geometry once per run
+        # (XtalGeomDetId and XtalGeometry in the run tree) instead of the XtalX, ..., XtalFront4Z branches
+        xtalGeometryPerRun = cms.bool(False),
+
+        # branch groups not to be stored, e.g. cms.vstring('Xtal','PfCand'); see interface/NTupleBranchSchema.h
+        disabledBranchGroups = cms.vstring(),
+        # trigger decisions: 'packed' in 64-bit words (HLTResultBits, ..., read with interface/TriggerBits.h),
+        # 'unpacked' with one int per decision (HLTResults, ..., the layout of the existing ntuples), or 'both'
+        triggerBitLayout = cms.string('unpacked'),
+        # event loop stages not to be run, e.g. cms.vstring('GenInfo'); see NTupleProducer constructor
+        # (their branches keep the default values; 'Prepare' cannot be disabled)
+        disabledStages = cms.vstring(),
 
         tag_fTrackCollForVertexing = cms.InputTag("generalTracks"),
         tag_fallConversionsCollForVertexing = cms.InputTag("allConversions"),
@@ -107,6 +124,11 @@ analyze = cms.EDFilter('NTupleProducer',
         tag_puJetIDAlgos = cms.VPSet(cutbased,full_53x),
         tag_WeightsPhotonIDMVA_EB = cms.string("2013FinalPaper_PhotonID_Barrel_BDT_TrainRangePT15.weights.xml"),
         tag_WeightsPhotonIDMVA_EE = cms.string("2013FinalPaper_PhotonID_Endcap_BDT_TrainRangePT15.weights.xml"),
+        # keep the photon ID forests read from the weight files in <weight file>.forest, read instead
+        # of the XML at the next job start as long as the weight file is unchanged; the cache directory
+        # must be writable ('': $CMSSW_BASE/tmp, '.': the job working directory)
+        cachePhotonIDMVAForest = cms.bool(True),
+        photonIDMVAForestCacheDir = cms.string(''),
 
 )
 
@@ -0,0 +1,102 @@
+#include <algorithm>
+
+#include "JetMETCorrections/Objects/interface/JetCorrector.h"
+
+#include "DiLeptonAnalysis/NTupleProducer/interface/CorrectedJetCache.h"
+#include "DiLeptonAnalysis/NTupleProducer/interface/EventCollectionCache.h"
+
+namespace {
+  // Orders (index, corrected pt) pairs by decreasing pt
+  struct ByDecreasingPt {
+    bool operator()(const std::pair<unsigned,double>& j1, const std::pair<unsigned,double>& j2) const {
+      return j1.second > j2.second;
+    }
+  };
+}
+
+//________________________________________________________________________________________
+CorrectedJetCache::CorrectedJetCache(void) :
+  fEvent(NULL),
+  fSetup(NULL),
+  fCollections(NULL),
+  fNTotRequests(0),
+  fNTotCorrected(0)
+{
+}
+
+//________________________________________________________________________________________
+void CorrectedJetCache::newEvent(const edm::Event& iEvent, const edm::EventSetup& iSetup,
+                                 EventCollectionCache* collections) {
+
+  boost::mutex::scoped_lock lock(fMutex);
+  clear();
+  fEvent = &iEvent;
+  fSetup = &iSetup;
+  fCollections = collections;
+
+}
+
+//________________________________________________________________________________________
+const CorrectedJetCache::Jets& CorrectedJetCache::get(const edm::InputTag& tag, const std::string& corrector) {
+
+  Entry* entry;
+  {
+    boost::mutex::scoped_lock lock(fMutex);
+    ++fNTotRequests;
+    std::pair<std::string,std::string> key(tag.encode(), corrector);
+    EntryMap::iterator it = fEntries.find(key);
+    if (it == fEntries.end()) it = fEntries.insert(std::make_pair(key, new Entry)).first;
+    entry = it->second;
+  }
+
+  // Only the consumers of the same key wait for each other here
+  boost::mutex::scoped_lock lock(entry->mutex);
+  if (!entry->done) {
+    fill(tag, corrector, entry->jets);
+    entry->done = true;
+    boost::mutex::scoped_lock countLock(fMutex);
+    ++fNTotCorrected;
+  }
+  return entry->jets;
+
+}
+
+//________________________________________________________________________________________
+void CorrectedJetCache::fill(const edm::InputTag& tag, const std::string& corrector, Jets& jets) {
+
+  edm::Handle<edm::View<reco::Jet> > collection;
+  if (fCollections) fCollections->getByLabel(tag, collection);
+  else fEvent->getByLabel(tag, collection);
+
+  const unsigned nJets = collection->size();
+  jets.scale.resize(nJets);
+  jets.pt.resize(nJets);
+  jets.p4.resize(nJets);
+  std::vector<std::pair<unsigned,double> > ordered(nJets);
+  {
+    EventCollectionCache::Lock lock(fCollections); // corrector may read the event
+    const JetCorrector* jetCorr = JetCorrector::getJetCorrector(corrector, *fSetup);
+    for (unsigned i=0; i<nJets; ++i)
+      jets.scale[i] = jetCorr->correction((*collection)[i], collection->refAt(i), *fEvent, *fSetup);
+  }
+  for (unsigned i=0; i<nJets; ++i) {
+    const reco::Jet& jet = (*collection)[i];
+    jets.pt[i] = jet.pt()*jets.scale[i];
+    jets.p4[i] = jet.p4()*jets.scale[i];
+    ordered[i] = std::make_pair(i, jets.pt[i]);
+  }
+
+  std::sort(ordered.begin(), ordered.end(), ByDecreasingPt());
+  jets.order.resize(nJets);
+  for (unsigned i=0; i<nJets; ++i) jets.order[i] = ordered[i].first;
+
+}
+
+//________________________________________________________________________________________
+void CorrectedJetCache::clear(void) {
+
+  for (EntryMap::iterator it = fEntries.begin(); it != fEntries.end(); ++it)
+    delete it->second;
+  fEntries.clear();
+
+}
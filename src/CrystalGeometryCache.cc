@@ -0,0 +1,51 @@
+#include "DiLeptonAnalysis/NTupleProducer/interface/CrystalGeometryCache.h"
+
+#include "DataFormats/EcalDetId/interface/EBDetId.h"
+#include "DataFormats/EcalDetId/interface/EEDetId.h"
+#include "Geometry/CaloGeometry/interface/CaloCellGeometry.h"
+#include "Geometry/CaloGeometry/interface/CaloSubdetectorGeometry.h"
+#include "Geometry/EcalAlgo/interface/EcalBarrelGeometry.h"
+#include "Geometry/EcalAlgo/interface/EcalEndcapGeometry.h"
+
+//________________________________________________________________________________________
+void CrystalGeometryCache::clear(void) {
+  fIndex.assign(EBDetId::kSizeForDenseIndexing + EEDetId::kSizeForDenseIndexing, -1);
+  fCrystals.clear();
+}
+
+//________________________________________________________________________________________
+unsigned int CrystalGeometryCache::index(const DetId& id, const CaloSubdetectorGeometry* barrel,
+                                         const CaloSubdetectorGeometry* endcap) {
+
+  if (fIndex.empty()) clear();
+  bool isEB = (id.subdetId() == EcalBarrel);
+  unsigned int dense = isEB ? EBDetId(id).hashedIndex() : EBDetId::kSizeForDenseIndexing + EEDetId(id).hashedIndex();
+  if (fIndex[dense] >= 0) return fIndex[dense];
+
+  Crystal xtal;
+  const CaloCellGeometry* cellGeometry;
+  if (isEB) {
+    cellGeometry  = barrel->getGeometry(id);
+    xtal.phiWidth = (dynamic_cast<const EcalBarrelGeometry*>(barrel))->deltaPhi(id);
+    xtal.etaWidth = (dynamic_cast<const EcalBarrelGeometry*>(barrel))->deltaEta(id);
+  } else {
+    cellGeometry  = endcap->getGeometry(id);
+    xtal.phiWidth = (dynamic_cast<const EcalEndcapGeometry*>(endcap))->deltaPhi(id);
+    xtal.etaWidth = (dynamic_cast<const EcalEndcapGeometry*>(endcap))->deltaEta(id);
+  }
+  xtal.rawId = id.rawId();
+  xtal.x = cellGeometry->getPosition().x();
+  xtal.y = cellGeometry->getPosition().y();
+  xtal.z = cellGeometry->getPosition().z();
+  const CaloCellGeometry::CornersVec& cellCorners(cellGeometry->getCorners());
+  for (int k = 0; k < 4; ++k) {
+    xtal.front[k][0] = cellCorners[k].x();
+    xtal.front[k][1] = cellCorners[k].y();
+    xtal.front[k][2] = cellCorners[k].z();
+  }
+
+  fIndex[dense] = fCrystals.size();
+  fCrystals.push_back(xtal);
+  return fIndex[dense];
+
+}
@@ -0,0 +1,31 @@
+#include "DiLeptonAnalysis/NTupleProducer/interface/EventCollectionCache.h"
+
+
+//________________________________________________________________________________________
+EventCollectionCache::EventCollectionCache(void) :
+  fEvent(NULL),
+  fNLookups(0),
+  fNResolved(0),
+  fNTotLookups(0),
+  fNTotResolved(0)
+{
+}
+
+//________________________________________________________________________________________
+void EventCollectionCache::newEvent(const edm::Event& iEvent) {
+
+  clear();
+  fEvent = &iEvent;
+  fNLookups  = 0;
+  fNResolved = 0;
+
+}
+
+//________________________________________________________________________________________
+void EventCollectionCache::clear(void) {
+
+  for (HolderMap::iterator it = fHolders.begin(); it != fHolders.end(); ++it)
+    delete it->second;
+  fHolders.clear();
+
+}
@@ -0,0 +1,345 @@
+#include "DiLeptonAnalysis/NTupleProducer/interface/FastForest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <unistd.h>
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+namespace {
+  const unsigned gCacheMagic   = 0x4646544e; // "NTFF"
+  const unsigned gCacheVersion = 2;
+
+  // Value of the attribute name="..." of a tag, false if it has none
+  bool attribute(const std::string& tag, const char* name, std::string& value) {
+    std::string key = std::string(" ") + name + "=\"";
+    size_t begin = tag.find(key);
+    if (begin == std::string::npos) return false;
+    begin += key.size();
+    size_t end = tag.find('"', begin);
+    if (end == std::string::npos) return false;
+    value = tag.substr(begin, end-begin);
+    return true;
+  }
+
+  double number(const std::string& tag, const char* name, const std::string& path) {
+    std::string value;
+    if (!attribute(tag, name, value))
+      throw cms::Exception("BadConfig") << "FastForest: no " << name << " in " << tag << " of " << path;
+    return std::strtod(value.c_str(), 0);
+  }
+
+  // Text of <Option name="...">, empty if the option is not there
+  std::string option(const std::string& xml, const std::string& name) {
+    size_t begin = xml.find("<Option name=\"" + name + "\"");
+    if (begin == std::string::npos) return "";
+    begin = xml.find('>', begin);
+    if (begin == std::string::npos) return "";
+    ++begin;
+    return xml.substr(begin, xml.find('<', begin)-begin);
+  }
+
+  // FNV-1a, to tell whether a cache was written from this weight file and
+  // whether its content is intact
+  unsigned long long checksum(const std::string& data) {
+    unsigned long long hash = 14695981039346656037ULL;
+    for (std::string::const_iterator c = data.begin(); c != data.end(); ++c) {
+      hash ^= (unsigned char)*c;
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
+  template <class T> void put(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+  template <class T> bool get(std::istream& in, T& value) {
+    return !in.read(reinterpret_cast<char*>(&value), sizeof(T)).fail();
+  }
+  template <class T> void putVector(std::ostream& out, const std::vector<T>& v) {
+    put(out, (unsigned)v.size());
+    if (!v.empty()) out.write(reinterpret_cast<const char*>(&v[0]), v.size()*sizeof(T));
+  }
+  template <class T> bool getVector(std::istream& in, std::vector<T>& v) {
+    unsigned n;
+    if (!get(in, n) || n > (1u<<24)) return false;
+    v.resize(n);
+    return n == 0 || !in.read(reinterpret_cast<char*>(&v[0]), n*sizeof(T)).fail();
+  }
+
+  // A tree as written in the weight file, before flattening
+  struct RawNode {
+    int   var;
+    float cut;
+    int   cutType;  // 1: the cut selects the inputs >= cut to the right
+    int   nodeType; // 0: internal node, +-1: leaf
+    int   child[2]; // left, right
+  };
+}
+
+//________________________________________________________________________________________
+void FastForest::load(const std::string& weightPath, const std::vector<std::string>& variables,
+		      const std::string& cachePath) {
+
+  std::ifstream in(weightPath.c_str(), std::ios::binary);
+  if (!in) throw cms::Exception("BadConfig") << "FastForest: can not read " << weightPath;
+  std::string xml((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  unsigned long long sum = checksum(xml);
+
+  if (!cachePath.empty() && readCache(cachePath, xml.size(), sum) && fVariables == variables) return;
+  parseWeights(xml, variables, weightPath);
+  if (!cachePath.empty()) writeCache(cachePath, xml.size(), sum);
+
+}
+
+//________________________________________________________________________________________
+double FastForest::evaluate(const float* row) const {
+
+  double response = 0.;
+  for (std::vector<int>::const_iterator root = fRoots.begin(); root != fRoots.end(); ++root) {
+    int n = *root;
+    while (n >= 0) n = row[fNodes[n].var] >= fNodes[n].cut ? fNodes[n].ge : fNodes[n].lt;
+    response += fLeaves[~n];
+  }
+  return fNorm > std::numeric_limits<double>::epsilon() ? response/fNorm : 0.;
+
+}
+
+//________________________________________________________________________________________
+void FastForest::evaluate(const float* rows, unsigned nRows, std::vector<double>& responses) const {
+
+  responses.assign(nRows, 0.);
+  for (std::vector<int>::const_iterator root = fRoots.begin(); root != fRoots.end(); ++root) {
+    const float* row = rows;
+    for (unsigned r = 0; r < nRows; ++r, row += fNVariables) {
+      int n = *root;
+      while (n >= 0) n = row[fNodes[n].var] >= fNodes[n].cut ? fNodes[n].ge : fNodes[n].lt;
+      responses[r] += fLeaves[~n];
+    }
+  }
+  for (unsigned r = 0; r < nRows; ++r)
+    responses[r] = fNorm > std::numeric_limits<double>::epsilon() ? responses[r]/fNorm : 0.;
+
+}
+
+//________________________________________________________________________________________
+// Only what TMVA writes for a BDT is understood: one tag per line at most,
+// the leaves as empty <Node .../> tags
+void FastForest::parseWeights(const std::string& xml, const std::vector<std::string>& variables,
+			      const std::string& weightPath) {
+
+  if (option(xml, "BoostType") != "AdaBoost" || option(xml, "UseYesNoLeaf") != "True" ||
+      option(xml, "UseWeightedTrees") != "True" || option(xml, "VarTransform") != "None")
+    throw cms::Exception("BadConfig") << "FastForest: " << weightPath
+				      << " is not a weighted AdaBoost BDT with yes/no leaves and no transformation";
+
+  fVariables.clear();
+  fNodes.clear();
+  fLeaves.clear();
+  fRoots.clear();
+  fNorm = 0.;
+
+  std::vector<RawNode> tree;
+  std::vector<int> open; // internal nodes whose children are being read
+  double boostWeight = 0.;
+  bool inTree = false;
+
+  for (size_t begin = xml.find('<'); begin != std::string::npos; begin = xml.find('<', begin+1)) {
+    size_t end = xml.find('>', begin);
+    if (end == std::string::npos) break;
+    const std::string tag = xml.substr(begin, end-begin+1);
+
+    if (tag.compare(0, 10, "<Variable ") == 0) {
+      std::string expression;
+      attribute(tag, "Expression", expression);
+      fVariables.push_back(expression);
+
+    } else if (tag.compare(0, 12, "<BinaryTree ") == 0) {
+      boostWeight = number(tag, "boostWeight", weightPath);
+      tree.clear();
+      open.clear();
+      inTree = true;
+
+    } else if (tag.compare(0, 6, "<Node ") == 0 && inTree) {
+      if (number(tag, "NCoef", weightPath) != 0.)
+	throw cms::Exception("BadConfig") << "FastForest: Fisher cuts in " << weightPath << " are not supported";
+      RawNode node;
+      node.var      = int(number(tag, "IVar", weightPath));
+      node.cut      = float(number(tag, "Cut", weightPath)); // TMVA compares as float
+      node.cutType  = int(number(tag, "cType", weightPath));
+      node.nodeType = int(number(tag, "nType", weightPath));
+      node.child[0] = node.child[1] = -1;
+      if (!open.empty()) {
+	std::string pos;
+	attribute(tag, "pos", pos);
+	tree[open.back()].child[pos == "r" ? 1 : 0] = tree.size();
+      } else if (!tree.empty()) {
+	throw cms::Exception("BadConfig") << "FastForest: tree " << fRoots.size() << " of " << weightPath << " has two roots";
+      }
+      tree.push_back(node);
+      if (tag[tag.size()-2] != '/') open.push_back(tree.size()-1);
+
+    } else if (tag == "</Node>" && inTree) {
+      if (!open.empty()) open.pop_back();
+
+    } else if (tag == "</BinaryTree>") {
+      if (tree.empty())
+	throw cms::Exception("BadConfig") << "FastForest: empty tree " << fRoots.size() << " in " << weightPath;
+      // Flatten, depth first: a node is followed by its subtrees
+      std::vector<std::pair<int,int> > todo(1, std::make_pair(0, -1)); // raw node, parent slot to set
+      while (!todo.empty()) {
+	std::pair<int,int> item = todo.back();
+	todo.pop_back();
+	const RawNode& raw = tree[item.first];
+	int code;
+	if (raw.nodeType != 0) {
+	  fLeaves.push_back(raw.nodeType*boostWeight);
+	  code = ~int(fLeaves.size()-1);
+	} else {
+	  if (raw.child[0] < 0 || raw.child[1] < 0 || raw.var < 0 || raw.var >= int(fVariables.size()))
+	    throw cms::Exception("BadConfig") << "FastForest: bad node in tree " << fRoots.size() << " of " << weightPath;
+	  code = fNodes.size();
+	  Node node;
+	  node.var = raw.var;
+	  node.cut = raw.cut;
+	  node.ge  = node.lt = 0;
+	  fNodes.push_back(node);
+	  // TMVA goes right if (input >= cut) == (cType == 1)
+	  todo.push_back(std::make_pair(raw.child[raw.cutType == 1 ? 0 : 1], 2*code+1)); // lt
+	  todo.push_back(std::make_pair(raw.child[raw.cutType == 1 ? 1 : 0], 2*code));   // ge
+	}
+	if (item.second < 0)            fRoots.push_back(code);
+	else if (item.second % 2 == 0)  fNodes[item.second/2].ge = code;
+	else                            fNodes[item.second/2].lt = code;
+      }
+      fNorm += boostWeight;
+      inTree = false;
+    }
+  }
+
+  if (fVariables != variables) {
+    cms::Exception error("BadConfig");
+    error << "FastForest: the variables of " << weightPath << " are";
+    for (size_t i = 0; i < fVariables.size(); ++i) error << " " << fVariables[i];
+    error << ", expected";
+    for (size_t i = 0; i < variables.size(); ++i) error << " " << variables[i];
+    throw error;
+  }
+  if (fRoots.empty()) throw cms::Exception("BadConfig") << "FastForest: no trees in " << weightPath;
+  fNVariables = fVariables.size();
+
+}
+
+//________________________________________________________________________________________
+// The flattened trees are only used if every index they hold is in range, and
+// children come after their parent (so that evaluate() always ends in a leaf)
+bool FastForest::isValid(const std::vector<Node>& nodes, size_t nLeaves, const std::vector<int>& roots,
+			 unsigned nVariables) {
+
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    const Node& node = nodes[i];
+    if (node.var < 0 || unsigned(node.var) >= nVariables) return false;
+    const int children[2] = { node.ge, node.lt };
+    for (int c = 0; c < 2; ++c) {
+      if (children[c] >= 0 ? (size_t(children[c]) <= i || size_t(children[c]) >= nodes.size())
+	                   : size_t(~children[c]) >= nLeaves) return false;
+    }
+  }
+  for (std::vector<int>::const_iterator root = roots.begin(); root != roots.end(); ++root)
+    if (*root >= 0 ? size_t(*root) >= nodes.size() : size_t(~*root) >= nLeaves) return false;
+  return !roots.empty();
+
+}
+
+//________________________________________________________________________________________
+bool FastForest::readCache(const std::string& cachePath, unsigned long long size, unsigned long long sum) {
+
+  std::ifstream in(cachePath.c_str(), std::ios::binary);
+  if (!in) return false;
+
+  unsigned magic, version, nVariables;
+  unsigned long long cachedSize, cachedSum, dataSum;
+  if (!get(in, magic) || magic != gCacheMagic || !get(in, version) || version != gCacheVersion) return false;
+  if (!get(in, cachedSize) || cachedSize != size || !get(in, cachedSum) || cachedSum != sum) return false;
+  if (!get(in, dataSum)) return false;
+  const std::string payload((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  if (checksum(payload) != dataSum) return false;
+  std::istringstream data(payload);
+
+  std::vector<std::string> names;
+  if (!get(data, nVariables) || nVariables > 1000) return false;
+  for (unsigned i = 0; i < nVariables; ++i) {
+    std::vector<char> name;
+    if (!getVector(data, name)) return false;
+    names.push_back(std::string(name.begin(), name.end()));
+  }
+  std::vector<Node> nodes;
+  std::vector<double> leaves;
+  std::vector<int> roots;
+  double norm;
+  if (!getVector(data, nodes) || !getVector(data, leaves) || !getVector(data, roots) || !get(data, norm)) return false;
+  if (data.peek() != std::char_traits<char>::eof() || norm != norm) return false;
+  if (!isValid(nodes, leaves.size(), roots, nVariables)) {
+    edm::LogWarning("NTP") << "FastForest: ignoring the inconsistent cache " << cachePath;
+    return false;
+  }
+
+  fVariables.swap(names);
+  fNodes.swap(nodes);
+  fLeaves.swap(leaves);
+  fRoots.swap(roots);
+  fNorm = norm;
+  fNVariables = fVariables.size();
+  return true;
+
+}
+
+//________________________________________________________________________________________
+// Written under a temporary name of this process first, and renamed once
+// complete, so that jobs sharing the cache never read a partial file nor
+// write into the same one
+void FastForest::writeCache(const std::string& cachePath, unsigned long long size, unsigned long long sum) const {
+
+  std::ostringstream data(std::ios::binary);
+  put(data, fNVariables);
+  for (std::vector<std::string>::const_iterator name = fVariables.begin(); name != fVariables.end(); ++name)
+    putVector(data, std::vector<char>(name->begin(), name->end()));
+  putVector(data, fNodes);
+  putVector(data, fLeaves);
+  putVector(data, fRoots);
+  put(data, fNorm);
+  const std::string payload = data.str();
+
+  char host[256] = "";
+  gethostname(host, sizeof(host)-1);
+  std::ostringstream tmpName;
+  tmpName << cachePath << ".tmp." << host << "." << getpid();
+  const std::string tmpPath = tmpName.str();
+  {
+    std::ofstream out(tmpPath.c_str(), std::ios::binary | std::ios::trunc);
+    if (out) {
+      put(out, gCacheMagic);
+      put(out, gCacheVersion);
+      put(out, size);
+      put(out, sum);
+      put(out, checksum(payload));
+      out.write(payload.data(), payload.size());
+    }
+    if (out) out.close();
+    if (!out) {
+      edm::LogWarning("NTP") << "FastForest: could not write the cache " << cachePath;
+      std::remove(tmpPath.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmpPath.c_str(), cachePath.c_str()) != 0) {
+    edm::LogWarning("NTP") << "FastForest: could not write the cache " << cachePath;
+    std::remove(tmpPath.c_str());
+  }
+
+}
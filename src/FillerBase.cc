@@ -3,7 +3,7 @@
 
 //________________________________________________________________________________________
 FillerBase::FillerBase( const edm::ParameterSet& cfg, const bool& isRealData )
-  : fIsRealData(isRealData){
+  : fIsRealData(isRealData), fCollections(NULL){
 	
   // Retrieve configuration parameters
   fPrefix = cfg.getParameter<std::string>("prefix");
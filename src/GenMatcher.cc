@@ -0,0 +1,131 @@
+#include "DiLeptonAnalysis/NTupleProducer/interface/GenMatcher.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "DataFormats/Math/interface/deltaR.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+//________________________________________________________________________________________
+void GenMatcher::fillParticles(const reco::GenParticleCollection& particles) {
+
+  fParticles = &particles;
+  fStable.clear();
+  for (size_t i = 0; i < particles.size(); ++i) {
+    const reco::GenParticle& p = particles[i];
+    if (p.status() != 1) continue;
+    Point point;
+    point.eta   = p.eta();
+    point.phi   = p.phi();
+    point.pt    = p.pt();
+    point.index = i;
+    fStable.push_back(point);
+  }
+  std::sort(fStable.begin(), fStable.end());
+
+}
+
+//________________________________________________________________________________________
+void GenMatcher::fillJets(const std::vector<float>& pt, const std::vector<float>& eta, const std::vector<float>& phi) {
+
+  fJets.clear();
+  for (size_t i = 0; i < pt.size(); ++i) {
+    Point point;
+    point.eta   = eta[i];
+    point.phi   = phi[i];
+    point.pt    = pt[i];
+    point.index = i;
+    fJets.push_back(point);
+  }
+  std::sort(fJets.begin(), fJets.end());
+
+}
+
+//________________________________________________________________________________________
+void GenMatcher::clear(void) {
+  fParticles = 0;
+  fStable.clear();
+  fJets.clear();
+}
+
+//________________________________________________________________________________________
+GenMatcher::Match GenMatcher::matchParticle(double pt, double eta, double phi) const {
+
+  Match match;
+  match.particle    = closest(fStable, 0.1, pt, eta, phi);
+  match.mother      = -1;
+  match.grandMother = -1;
+  if (match.particle < 0) return match;
+
+  const reco::GenParticle& cand = (*fParticles)[match.particle];
+  if (!cand.mother()) return match;
+  match.mother = differentAncestor(match.particle, cand.pdgId(), "mother");
+  if (match.mother < 0) return match;
+
+  const reco::GenParticle& mom = (*fParticles)[match.mother];
+  if (!mom.mother()) return match;
+  match.grandMother = differentAncestor(match.mother, mom.pdgId(), "grand-mother");
+  return match;
+
+}
+
+//________________________________________________________________________________________
+int GenMatcher::matchJet(double pt, double eta, double phi) const {
+  return closest(fJets, 0.3, pt, eta, phi);
+}
+
+//________________________________________________________________________________________
+// Smallest dR inside the cone, for a pt within a factor 2; on equal dR the
+// last in the original order, as the linear scans this replaces did
+int GenMatcher::closest(const std::vector<Point>& points, double maxDR, double pt, double eta, double phi) {
+
+  Point low;
+  low.eta = eta - maxDR;
+  double mindr = 999.99;
+  int best = -1;
+  for (std::vector<Point>::const_iterator p = std::lower_bound(points.begin(), points.end(), low);
+       p != points.end() && p->eta <= eta + maxDR; ++p) {
+    double dr = reco::deltaR(p->eta, p->phi, eta, phi);
+    if (dr > maxDR) continue;
+    if (std::fabs(p->pt - pt)/p->pt > 2.) continue;
+    if (dr > mindr || (dr == mindr && p->index < best)) continue;
+    mindr = dr;
+    best  = p->index;
+  }
+  return best;
+
+}
+
+//________________________________________________________________________________________
+// Walk up the first mothers of a particle until the PDG id differs from the
+// given one; the direct mother if that takes more than 10 steps
+int GenMatcher::differentAncestor(int index, int pdgId, const char* what) const {
+
+  const reco::Candidate* first = (*fParticles)[index].mother();
+  const reco::Candidate* anc = first;
+  int loop_counter = 0;
+  while (anc->pdgId() == pdgId) {
+    if (++loop_counter >= 10) {
+      edm::LogWarning("NTP") << "@SUB=analyze"
+                             << " WARNING: accessing GenParticle " << what << " results in loop";
+      anc = first;
+      break;
+    }
+    if (!anc->mother()) break;
+    anc = anc->mother();
+  }
+  return indexOf(anc);
+
+}
+
+//________________________________________________________________________________________
+// The mothers point into the same collection
+int GenMatcher::indexOf(const reco::Candidate* particle) const {
+
+  if (fParticles->empty()) return -1;
+  const reco::GenParticle* first = &fParticles->front();
+  const reco::GenParticle* p = dynamic_cast<const reco::GenParticle*>(particle);
+  if (p == 0 || p < first || p >= first + fParticles->size()) return -1;
+  return p - first;
+
+}
@@ -13,7 +13,7 @@
 
 //________________________________________________________________________________________
 JetFillerBase::JetFillerBase( const edm::ParameterSet& cfg, const bool& isRealData )
-    : FillerBase(cfg,isRealData)
+    : FillerBase(cfg,isRealData), fCorrectedJets(0)
 {
 	
     // Retrieve configuration parameters
@@ -94,52 +94,52 @@ void JetFillerBase::resetProducts(void) {
 
     fTNObjs.reset(new int(0));
 	
-    fTPx     .reset(new std::vector<float>);
-    fTPy     .reset(new std::vector<float>);
-    fTPz     .reset(new std::vector<float>);
-    fTPt     .reset(new std::vector<float>);
-    fTE      .reset(new std::vector<float>);
-    fTEt     .reset(new std::vector<float>);
-    fTEta    .reset(new std::vector<float>);
-    fTPhi    .reset(new std::vector<float>);
-    fTArea   .reset(new std::vector<float>);
-    fTScale  .reset(new std::vector<float>);
-    fTL1FastJetScale.reset(new std::vector<float>);
-    fTFlavour.reset(new std::vector<int>);
+    fBufferPool.reset(fTPx, "JPx");
+    fBufferPool.reset(fTPy, "JPy");
+    fBufferPool.reset(fTPz, "JPz");
+    fBufferPool.reset(fTPt, "JPt");
+    fBufferPool.reset(fTE, "JE");
+    fBufferPool.reset(fTEt, "JEt");
+    fBufferPool.reset(fTEta, "JEta");
+    fBufferPool.reset(fTPhi, "JPhi");
+    fBufferPool.reset(fTArea, "JArea");
+    fBufferPool.reset(fTScale, "JScale");
+    fBufferPool.reset(fTL1FastJetScale, "JL1FastJetScale");
+    fBufferPool.reset(fTFlavour, "JFlavour");
     size_t ibtag = 0;
     for ( std::vector<std::string>::const_iterator it = fBtagNames.begin();
         it != fBtagNames.end(); ++it ) {
-        fTJbTagProb[ibtag++].reset(new std::vector<float> );
+        fBufferPool.reset(fTJbTagProb[ibtag++], "JbTagProb");
     }
-    fTIDLoose.reset(new std::vector<int>);
+    fBufferPool.reset(fTIDLoose, "JIDLoose");
     if (fJetType==CALO) {	
-        fTNConstituents.reset(new std::vector<int>);		
-        fTNAssoTracks .reset(new std::vector<int>);
-        fTChfrac      .reset(new std::vector<float>);
-        fTEMfrac       .reset(new std::vector<float>);
-        fTID_RBX       .reset(new std::vector<float>);
-        fTID_HPD       .reset(new std::vector<float>);
-        fTID_n90Hits   .reset(new std::vector<float>);
-        fTn90          .reset(new std::vector<int>);
-        fTID_resEMF    .reset(new std::vector<float>);
+        fBufferPool.reset(fTNConstituents, "JNConstituents");		
+        fBufferPool.reset(fTNAssoTracks, "JNAssoTracks");
+        fBufferPool.reset(fTChfrac, "JChfrac");
+        fBufferPool.reset(fTEMfrac, "JEMfrac");
+        fBufferPool.reset(fTID_RBX, "JIDRBX");
+        fBufferPool.reset(fTID_HPD, "JIDHPD");
+        fBufferPool.reset(fTID_n90Hits, "JIDn90Hits");
+        fBufferPool.reset(fTn90, "Jn90");
+        fBufferPool.reset(fTID_resEMF, "JIDresEMF");
     } else if (fJetType==JPT) {	
-        fTID_RBX       .reset(new std::vector<float>);
-        fTID_HPD       .reset(new std::vector<float>);
-        fTID_n90Hits   .reset(new std::vector<float>);
-        fTID_resEMF    .reset(new std::vector<float>);
-        fTChMult       .reset(new std::vector<int>);
+        fBufferPool.reset(fTID_RBX, "JIDRBX");
+        fBufferPool.reset(fTID_HPD, "JIDHPD");
+        fBufferPool.reset(fTID_n90Hits, "JIDn90Hits");
+        fBufferPool.reset(fTID_resEMF, "JIDresEMF");
+        fBufferPool.reset(fTChMult, "JChMult");
     } else if (fJetType==PF) {
-        fTNConstituents.reset(new std::vector<int>);
-        fTChMult       .reset(new std::vector<int>);
-        fTNeuMult      .reset(new std::vector<int>);
-        fTChHadfrac    .reset(new std::vector<float>);
-        fTNeuHadfrac   .reset(new std::vector<float>);
-        fTChEmfrac     .reset(new std::vector<float>);
-        fTNeuEmfrac    .reset(new std::vector<float>);
-        fTChMufrac     .reset(new std::vector<float>);
-        fTPhofrac      .reset(new std::vector<float>);
-        fTHFHadfrac    .reset(new std::vector<float>);
-        fTHFEMfrac     .reset(new std::vector<float>);
+        fBufferPool.reset(fTNConstituents, "JNConstituents");
+        fBufferPool.reset(fTChMult, "JChMult");
+        fBufferPool.reset(fTNeuMult, "JNeuMult");
+        fBufferPool.reset(fTChHadfrac, "JChHadfrac");
+        fBufferPool.reset(fTNeuHadfrac, "JNeuHadfrac");
+        fBufferPool.reset(fTChEmfrac, "JChEmfrac");
+        fBufferPool.reset(fTNeuEmfrac, "JNeuEmfrac");
+        fBufferPool.reset(fTChMufrac, "JChMufrac");
+        fBufferPool.reset(fTPhofrac, "JPhofrac");
+        fBufferPool.reset(fTHFHadfrac, "JHFHadfrac");
+        fBufferPool.reset(fTHFEMfrac, "JHFEMfrac");
     }
 }
 
@@ -147,6 +147,8 @@ void JetFillerBase::resetProducts(void) {
 //______________________________________________________________________________
 void JetFillerBase::putProducts( edm::Event& e ) { 
 
+    fBufferPool.collect();
+
     e.put(fTNObjs,fullName("NJets"));
 	
     e.put(fTPx, fullName("JPx"));
@@ -51,7 +51,7 @@ void JetFillerPat::fillProducts(edm::Event& iEvent,const edm::EventSetup& iSetup
 
   // Retrieve collections
   Handle<View<pat::Jet> > jetsHandle;
-  iEvent.getByLabel(fTag,jetsHandle);
+  getByLabel(iEvent,fTag,jetsHandle);
   View<pat::Jet> jets = *jetsHandle;
 
   // PFJetIDSelectionFunctor for LooseID.
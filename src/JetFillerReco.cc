@@ -6,11 +6,8 @@
 #include "DataFormats/Math/interface/deltaR.h"
 #include "DataFormats/JetReco/interface/JetID.h"
 #include "DataFormats/JetReco/interface/Jet.h"
-#include "JetMETCorrections/Objects/interface/JetCorrector.h"
 #include "DataFormats/BTauReco/interface/JetTag.h"
 #include "DataFormats/JetReco/interface/JetTracksAssociation.h"
-#include "TrackingTools/TransientTrack/interface/TransientTrackBuilder.h"
-#include "TrackingTools/Records/interface/TransientTrackRecord.h"
 #include "DataFormats/PatCandidates/interface/Jet.h"
 
 #include "DiLeptonAnalysis/NTupleProducer/interface/JetFillerReco.h"
@@ -49,18 +46,14 @@ void JetFillerReco::fillProducts(edm::Event& iEvent,
 
   // Retrieve collections
   Handle<View<Jet> > jets;
-  iEvent.getByLabel(fTag,jets);
+  getByLabel(iEvent,fTag,jets);
 
   // Jet tracks association (already done in PAT)
   Handle<reco::JetTracksAssociation::Container> jetTracksAssoc;
-  iEvent.getByLabel(fJetTracksTag,jetTracksAssoc);
+  getByLabel(iEvent,fJetTracksTag,jetTracksAssoc);
 
   Handle<edm::ValueMap<reco::JetID> > jetsID;
-  iEvent.getByLabel(fJetID,jetsID);
-
-  // Get Transient Track Builder
-  ESHandle<TransientTrackBuilder> theB;
-  iSetup.get<TransientTrackRecord>().get("TransientTrackBuilder",theB);
+  getByLabel(iEvent,fJetID,jetsID);
 
   // collect information for b-tagging (4 tags)
   // FIXME: THIS SHOULD BE CONFIGURABLE!
@@ -70,48 +63,38 @@ void JetFillerReco::fillProducts(edm::Event& iEvent,
   Handle<JetTagCollection> jetsAndProbsSimpSVHighPur;
 
   if( jetType()==PF ) {
-    iEvent.getByLabel("newPFTrackCountingHighEffBJetTags",jetsAndProbsTkCntHighEff);
-    iEvent.getByLabel("newPFTrackCountingHighPurBJetTags",jetsAndProbsTkCntHighPur);
-    iEvent.getByLabel("newPFSimpleSecondaryVertexHighEffBJetTags",jetsAndProbsSimpSVHighEff);
-    iEvent.getByLabel("newPFSimpleSecondaryVertexHighPurBJetTags",jetsAndProbsSimpSVHighPur);
+    getByLabel(iEvent,"newPFTrackCountingHighEffBJetTags",jetsAndProbsTkCntHighEff);
+    getByLabel(iEvent,"newPFTrackCountingHighPurBJetTags",jetsAndProbsTkCntHighPur);
+    getByLabel(iEvent,"newPFSimpleSecondaryVertexHighEffBJetTags",jetsAndProbsSimpSVHighEff);
+    getByLabel(iEvent,"newPFSimpleSecondaryVertexHighPurBJetTags",jetsAndProbsSimpSVHighPur);
   } else {
-    iEvent.getByLabel("newTrackCountingHighEffBJetTags",jetsAndProbsTkCntHighEff);
-    iEvent.getByLabel("newTrackCountingHighPurBJetTags",jetsAndProbsTkCntHighPur);
-    iEvent.getByLabel("newSimpleSecondaryVertexHighEffBJetTags",jetsAndProbsSimpSVHighEff);
-    iEvent.getByLabel("newSimpleSecondaryVertexHighPurBJetTags",jetsAndProbsSimpSVHighPur);
+    getByLabel(iEvent,"newTrackCountingHighEffBJetTags",jetsAndProbsTkCntHighEff);
+    getByLabel(iEvent,"newTrackCountingHighPurBJetTags",jetsAndProbsTkCntHighPur);
+    getByLabel(iEvent,"newSimpleSecondaryVertexHighEffBJetTags",jetsAndProbsSimpSVHighEff);
+    getByLabel(iEvent,"newSimpleSecondaryVertexHighPurBJetTags",jetsAndProbsSimpSVHighPur);
   }
 
 
-  const JetCorrector* jetCorr = JetCorrector::getJetCorrector(fJetCorrs,iSetup);
-
-  // First loop: just get corrected pt and corresponding indices
-  unsigned int iraw(0);
-  vector<OrderPair> corrIndices; // Vector of indices and pt of corr. jets
-  for( View<Jet>::const_iterator Jit = jets->begin(); 
-       Jit != jets->end(); ++Jit, ++iraw )
-    {
-      // Store the (index,pt) pair, where pt is corrected
-      reco::JetBaseRef jetRef(edm::Ref<JetView>(jets,iraw));
-      double scale = jetCorr->correction(*Jit,jetRef,iEvent,iSetup);
-      corrIndices.push_back(make_pair(iraw,Jit->pt()*scale));
-    }
-
-
-  // Now sort indices by decreasing corrected pt
-  IndexByPt indexComparator;
-  std::sort(corrIndices.begin(), corrIndices.end(), indexComparator);
+  // Corrected jets, shared with the producer and the other fillers if possible
+  CorrectedJetCache ownCorrectedJets;
+  CorrectedJetCache* correctedJets = fCorrectedJets;
+  if (!correctedJets) {
+    ownCorrectedJets.newEvent(iEvent, iSetup, fCollections);
+    correctedJets = &ownCorrectedJets;
+  }
+  const CorrectedJetCache::Jets& corrJets = correctedJets->get(fTag, fJetCorrs);
 
-  // Second loop: get them ordered
+  // Loop over the jets, by decreasing corrected pt
   unsigned int ijet(0);
-  for ( vector<OrderPair>::const_iterator it = corrIndices.begin(); 
-	it != corrIndices.end(); ++it ) {
+  for ( vector<unsigned>::const_iterator it = corrJets.order.begin(); 
+	it != corrJets.order.end(); ++it ) {
 
-    unsigned int index = it->first;
+    unsigned int index = *it;
     const Jet* jet = &((*jets)[index]);
 
     // Cut on corrected pT
-    double scale = it->second/jet->pt();
-    if(jet->pt()*scale < fMinpt) continue;
+    double scale = corrJets.scale[index];
+    if(corrJets.pt[index] < fMinpt) continue;
 
     // Save only the gMaxnjets first uncorrected jets
     if (ijet >= gMaxnobjs){
@@ -122,11 +105,11 @@ void JetFillerReco::fillProducts(edm::Event& iEvent,
     }
 
     // Store the information (corrected)
-    fTPx   ->push_back(jet->px()*scale);
-    fTPy   ->push_back(jet->py()*scale);
-    fTPz   ->push_back(jet->pz()*scale);
-    fTPt   ->push_back(jet->pt()*scale);
-    fTE    ->push_back(jet->energy()*scale);
+    fTPx   ->push_back(corrJets.p4[index].px());
+    fTPy   ->push_back(corrJets.p4[index].py());
+    fTPz   ->push_back(corrJets.p4[index].pz());
+    fTPt   ->push_back(corrJets.pt[index]);
+    fTE    ->push_back(corrJets.p4[index].energy());
     fTEt   ->push_back(jet->et()*scale);
     fTEta  ->push_back(jet->eta());
     fTPhi  ->push_back(jet->phi());
@@ -211,8 +194,7 @@ void JetFillerReco::fillProducts(edm::Event& iEvent,
         AssociatedTracks.push_back( it->get() );
       }
 
-      // Jet-track association: make transient tracks and store information
-      vector<TransientTrack> AssociatedTTracks;
+      // Jet-track association: store information
       fTNAssoTracks->push_back(0);
       fTChfrac->push_back(-1.); // Default (if jet-tracks association cone is outside tracker acceptance)
       if(fabs(jet->eta())<2.9) { // when the cone of dR=0.5 around the jet is (at least partially) inside the tracker acceptance
@@ -220,7 +202,6 @@ void JetFillerReco::fillProducts(edm::Event& iEvent,
         double pXtmp(0.), pYtmp(0.);
         // Loop over associated tracks:
         for(size_t t = 0; t < AssociatedTracks.size(); ++t){
-          AssociatedTTracks.push_back(theB->build(AssociatedTracks[t])); // build transient tracks
           if(AssociatedTracks[t]->normalizedChi2()<10. && AssociatedTracks[t]->numberOfValidHits()>10 && AssociatedTracks[t]->pt()>1.){
             pXtmp += AssociatedTracks[t]->px();
             pYtmp += AssociatedTracks[t]->py();
@@ -230,7 +211,6 @@ void JetFillerReco::fillProducts(edm::Event& iEvent,
         (*fTChfrac)[ijet] = sqrt(pXtmp*pXtmp + pYtmp*pYtmp) / (jet->pt()*scale);
       }
       AssociatedTracks.clear();
-      AssociatedTTracks.clear();
 
     } // ----------------------------
 
@@ -0,0 +1,43 @@
+#include "DiLeptonAnalysis/NTupleProducer/interface/NTupleBranchSchema.h"
+
+#include <cstring>
+
+namespace {
+#define NTP_GROUP_NAME(g) #g,
+  const char* gGroupNames[] = { NTP_BRANCH_GROUPS(NTP_GROUP_NAME) };
+#undef NTP_GROUP_NAME
+#define NTP_GROUP_BUILT(g) (NTP_BUILD_GROUP_##g != 0),
+  const bool gGroupBuilt[] = { NTP_BRANCH_GROUPS(NTP_GROUP_BUILT) };
+#undef NTP_GROUP_BUILT
+}
+
+//________________________________________________________________________________________
+const char* NTupleBranches::groupName(int group) {
+  if (group < 0 || group >= kNGroups) return "";
+  return gGroupNames[group];
+}
+
+//________________________________________________________________________________________
+int NTupleBranches::groupIndex(const std::string& name) {
+  for (int g = 0; g < kNGroups; ++g)
+    if (name == gGroupNames[g]) return g;
+  return kNGroups;
+}
+
+//________________________________________________________________________________________
+bool NTupleBranches::groupBuilt(int group) {
+  if (group < 0 || group >= kNGroups) return false;
+  return gGroupBuilt[group];
+}
+
+//________________________________________________________________________________________
+float NTupleBranches::reducedPrecision(float value) {
+  // Keep sign, exponent and the 10 leading mantissa bits, rounding to nearest
+  unsigned int bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  if ((bits & 0x7f800000u) == 0x7f800000u) return value; // inf or nan
+  bits += 0x00000fffu + ((bits >> 13) & 1u);
+  bits &= 0xffffe000u;
+  std::memcpy(&value, &bits, sizeof(bits));
+  return value;
+}
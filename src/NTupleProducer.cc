@@ -28,13 +28,14 @@
 #include <errno.h>
 #include <sstream>
 #include <map>
+#include <algorithm>
+#include <boost/bind.hpp>
 
 // ROOT includes
 #include "TLorentzVector.h"
 
 // Framework include files
 #include "FWCore/Framework/interface/TriggerNamesService.h"
-#include "FWCore/Framework/interface/MakerMacros.h"
 #include "FWCore/Utilities/interface/Exception.h"
 
 // Utilities
@@ -55,7 +56,6 @@
 
 // Data formats
 #include "DataFormats/VertexReco/interface/VertexFwd.h"
-#include "JetMETCorrections/Objects/interface/JetCorrector.h"
 #include "DataFormats/BTauReco/interface/JetTag.h"
 #include "DataFormats/JetReco/interface/JetID.h"
 #include "DataFormats/JetReco/interface/JetCollection.h"
@@ -120,7 +120,6 @@
 #include "SimDataFormats/JetMatching/interface/MatchedPartons.h"
 #include "SimDataFormats/JetMatching/interface/JetMatchedPartons.h"
 
-#include "DiLeptonAnalysis/NTupleProducer/interface/ETHVertexInfo.h"
 #include "PFIsolation/SuperClusterFootprintRemoval/interface/SuperClusterFootprintRemoval.h"
 
 #include "CMGTools/External/interface/PileupJetIdentifier.h"
@@ -142,14 +141,6 @@ namespace LHAPDF {
   void extrapolate(bool extrapolate=true);
 }
 
-void FlipGenStoreFlag(int index, int Promptness[], int genMo1Index[], int genMo2Index[], bool StoreFlag[]) {
-  if(StoreFlag[index]) return;//particle has already been marked. 
-  StoreFlag[index]=true;
-  if(genMo1Index[index]>0) FlipGenStoreFlag(genMo1Index[index], Promptness, genMo1Index, genMo2Index, StoreFlag);
-  if(genMo2Index[index]>0) FlipGenStoreFlag(genMo2Index[index], Promptness, genMo1Index, genMo2Index, StoreFlag);
-}
-  
-
 NTupleProducer::NTupleProducer(const edm::ParameterSet& iConfig){
   // Main settings
   fIsRealData = iConfig.getParameter<bool>("isRealData");
@@ -195,6 +186,7 @@ NTupleProducer::NTupleProducer(const edm::ParameterSet& iConfig){
   fSCTagBarrel = iConfig.getParameter<edm::InputTag>("tag_SC_barrel");
   fSCTagEndcap = iConfig.getParameter<edm::InputTag>("tag_SC_endcap");
   doPhotonStuff   = iConfig.getParameter<bool>("tag_doPhotonStuff");
+  fXtalGeometryPerRun = iConfig.getParameter<bool>("xtalGeometryPerRun");
   if (fIsModelScan) doPhotonStuff=false;
 
   if (doPhotonStuff){
@@ -288,6 +280,13 @@ NTupleProducer::NTupleProducer(const edm::ParameterSet& iConfig){
   // Create PF candidate fillers
   std::vector<edm::ParameterSet> pfConfigs = iConfig.getParameter<std::vector<edm::ParameterSet> >("pfCandidates");
   for (size_t i=0; i<pfConfigs.size(); ++i) pfFillers.push_back( new PFFiller(pfConfigs[i], fIsRealData) );
+
+  for (size_t i=0; i<jetFillers.size(); ++i)      jetFillers[i]     ->setCollectionCache(&fCollections);
+  for (size_t i=0; i<jetFillers.size(); ++i)      jetFillers[i]     ->setCorrectedJetCache(&fCorrectedJets);
+  for (size_t i=0; i<muonFillers.size(); ++i)     muonFillers[i]    ->setCollectionCache(&fCollections);
+  for (size_t i=0; i<electronFillers.size(); ++i) electronFillers[i]->setCollectionCache(&fCollections);
+  for (size_t i=0; i<tauFillers.size(); ++i)      tauFillers[i]     ->setCollectionCache(&fCollections);
+  for (size_t i=0; i<pfFillers.size(); ++i)       pfFillers[i]      ->setCollectionCache(&fCollections);
   }
 
   // Get list of trigger paths to store the triggering object info. of
@@ -299,6 +298,14 @@ NTupleProducer::NTupleProducer(const edm::ParameterSet& iConfig){
     fHLTLabels.resize(gMaxHltNPaths);
   }
   fTNpaths = fHLTLabels.size();
+  fTrigMatchLabels    = iConfig.getParameter<std::vector<std::string> >("trigmatch_filters");
+  fTrigMatchDeltaR    = iConfig.getParameter<double>("trigmatch_deltaR");
+  fTrigMatchJetDeltaR = iConfig.getParameter<double>("trigmatch_jetDeltaR");
+  if (fTrigMatchLabels.size() > TriggerObjectMatcher::kMaxFilters)
+    throw cms::Exception("BadConfig") << "At most " << TriggerObjectMatcher::kMaxFilters
+                                      << " filters in trigmatch_filters, got " << fTrigMatchLabels.size();
+  fHLTPrescaleRun  = 0;
+  fHLTPrescaleLumi = 0;
   
   //OOT pu reweighting
   if( !fIsRealData ) {
@@ -309,6 +316,71 @@ NTupleProducer::NTupleProducer(const edm::ParameterSet& iConfig){
     }
   }
 
+  // Branch groups switched off at build time or in the configuration
+  for (int g=0; g<NTupleBranches::kNGroups; ++g) fBranchGroupOn[g] = NTupleBranches::groupBuilt(g);
+  std::vector<std::string> disabledGroups = iConfig.getParameter<std::vector<std::string> >("disabledBranchGroups");
+  for (size_t i=0; i<disabledGroups.size(); ++i) {
+    int g = NTupleBranches::groupIndex(disabledGroups[i]);
+    if (g == NTupleBranches::kNGroups)
+      throw cms::Exception("BadConfig") << "Unknown branch group '" << disabledGroups[i] << "' in disabledBranchGroups";
+    fBranchGroupOn[g] = false;
+  }
+  // Trigger decisions packed in 64-bit words, one int per decision (as before), or both
+  std::string triggerBitLayout = iConfig.getParameter<std::string>("triggerBitLayout");
+  if (triggerBitLayout == "packed")        fBranchGroupOn[NTupleBranches::kTriggerUnpacked] = false;
+  else if (triggerBitLayout == "unpacked") fBranchGroupOn[NTupleBranches::kTriggerBits] = false;
+  else if (triggerBitLayout != "both")
+    throw cms::Exception("BadConfig") << "Unknown triggerBitLayout '" << triggerBitLayout
+                                      << "', expected 'packed', 'unpacked' or 'both'";
+  for (int g=0; g<NTupleBranches::kNGroups; ++g)
+    if (!fBranchGroupOn[g]) edm::LogVerbatim("NTP") << "  Branch group " << NTupleBranches::groupName(g) << " not stored";
+
+  // Stages of the event loop, with the stages whose products or state they
+  // read (all of them come after Prepare)
+  addStage("Prepare",        &NTupleProducer::fillPrepare);
+  addStage("GenEvent",       &NTupleProducer::fillGenEventInfo);
+  addStage("Trigger",        &NTupleProducer::fillTrigger);
+  addStage("EventInfo",      &NTupleProducer::fillEventInfo);
+  addStage("GenVertices",    &NTupleProducer::fillGenVertices);
+  addStage("GenLeptons",     &NTupleProducer::fillGenLeptons);
+  addStage("GenPhotons",     &NTupleProducer::fillGenPhotons);
+  addStage("GenJets",        &NTupleProducer::fillGenJets);
+  addStage("Muons",          &NTupleProducer::fillMuons);
+  addStage("SuperClustersEB",&NTupleProducer::fillSuperClusterInfos<EcalBarrel>);
+  addStage("SuperClustersEE",&NTupleProducer::fillSuperClusterInfos<EcalEndcap>);
+  addStage("SuperClusters",  &NTupleProducer::fillSuperClusters,    "SuperClustersEB SuperClustersEE");
+  addStage("ConversionVeto", &NTupleProducer::fillConversionVeto);
+  addStage("Electrons",      &NTupleProducer::fillElectrons,        "SuperClusters ConversionVeto");
+  addStage("EBRechits",      &NTupleProducer::fillEBRechits);
+  addStage("Photons",        &NTupleProducer::fillPhotons,          "EventInfo GenPhotons SuperClusters Electrons ConversionVeto");
+  addStage("DiphotonVertex", &NTupleProducer::fillDiphotonVertices, "EventInfo Photons ConversionVeto");
+  addStage("Jets",           &NTupleProducer::fillJets,             "EventInfo GenJets Muons Electrons"); // shares their transient tracks
+  addStage("PfCandidates",   &NTupleProducer::fillPfCandidates,     "Photons Jets");
+  addStage("MET",            &NTupleProducer::fillMET,              "Jets");
+  addStage("TriggerMatch",   &NTupleProducer::fillTriggerMatch,     "Muons Electrons Photons Jets");
+  addStage("ModelScan",      &NTupleProducer::fillModelScan);
+  addStage("GenInfo",        &NTupleProducer::fillGenParticles,     "ModelScan");
+  addStage("JetFillers",     &NTupleProducer::fillJetCollections); // corrected jets shared with Jets
+  addStage("Fillers",        &NTupleProducer::fillOtherCollections);
+  fPutTimer = fStageTimer.add("PutProducts");
+  fCurrentEvent = NULL;
+  fCurrentSetup = NULL;
+  std::vector<std::string> disabledStages = iConfig.getParameter<std::vector<std::string> >("disabledStages");
+  for (size_t i=0; i<disabledStages.size(); ++i) {
+    std::vector<Stage>::iterator stage = fStages.begin();
+    while (stage != fStages.end() && stage->name != disabledStages[i]) ++stage;
+    if (stage == fStages.end() || stage == fStages.begin())
+      throw cms::Exception("BadConfig") << "Unknown or mandatory stage '" << disabledStages[i] << "' in disabledStages";
+    stage->enabled = false;
+    edm::LogVerbatim("NTP") << "  Stage " << stage->name << " not run";
+  }
+  // The stages run in sequence, in the order they were added: stages reach
+  // products through Refs and Ptrs, whose delayed reads from the event are not
+  // thread-safe, so they can not run concurrently
+  fScheduler.reset(new StageScheduler(1));
+  for (unsigned i=0; i<fStages.size(); ++i)
+    fScheduler->add(boost::bind(&NTupleProducer::runStage, this, i), fStages[i].after);
+
   // Declare all products to be stored (needs to be done at construction time)
   declareProducts();
   std::vector<filler::PPair > list;
@@ -430,42 +502,26 @@ NTupleProducer::NTupleProducer(const edm::ParameterSet& iConfig){
   }
 
   if (doPhotonStuff){
-  photonIDMVA_reader_EB = new TMVA::Reader("!Color:Silent");
-  photonIDMVA_reader_EB->AddVariable("ph.scrawe",   &(photonIDMVA_variables.scrawe) );
-  photonIDMVA_reader_EB->AddVariable("ph.r9",   &(photonIDMVA_variables.r9) );
-  photonIDMVA_reader_EB->AddVariable("ph.sigietaieta",   &(photonIDMVA_variables.sieie) );
-  photonIDMVA_reader_EB->AddVariable("ph.scetawidth",   &(photonIDMVA_variables.etawidth) );
-  photonIDMVA_reader_EB->AddVariable("ph.scphiwidth",   &(photonIDMVA_variables.phiwidth) );
-  photonIDMVA_reader_EB->AddVariable("ph.idmva_CoviEtaiPhi",   &(photonIDMVA_variables.sieip) );
-  photonIDMVA_reader_EB->AddVariable("ph.idmva_s4ratio",   &(photonIDMVA_variables.s4ratio) );
-  photonIDMVA_reader_EB->AddVariable("ph.idmva_GammaIso",   &(photonIDMVA_variables.pfphotoniso03) );
-  photonIDMVA_reader_EB->AddVariable("ph.idmva_ChargedIso_selvtx",   &(photonIDMVA_variables.pfchargedisogood03) );
-  photonIDMVA_reader_EB->AddVariable("ph.idmva_ChargedIso_worstvtx",   &(photonIDMVA_variables.pfchargedisobad03) );
-  photonIDMVA_reader_EB->AddVariable("ph.sceta",   &(photonIDMVA_variables.sceta) );
-  photonIDMVA_reader_EB->AddVariable("rho",   &(photonIDMVA_variables.eventrho) );
-
-  photonIDMVA_reader_EE = new TMVA::Reader("!Color:Silent");
-  photonIDMVA_reader_EE->AddVariable("ph.scrawe",   &(photonIDMVA_variables.scrawe) );
-  photonIDMVA_reader_EE->AddVariable("ph.r9",   &(photonIDMVA_variables.r9) );
-  photonIDMVA_reader_EE->AddVariable("ph.sigietaieta",   &(photonIDMVA_variables.sieie) );
-  photonIDMVA_reader_EE->AddVariable("ph.scetawidth",   &(photonIDMVA_variables.etawidth) );
-  photonIDMVA_reader_EE->AddVariable("ph.scphiwidth",   &(photonIDMVA_variables.phiwidth) );
-  photonIDMVA_reader_EE->AddVariable("ph.idmva_CoviEtaiPhi",   &(photonIDMVA_variables.sieip) );
-  photonIDMVA_reader_EE->AddVariable("ph.idmva_s4ratio",   &(photonIDMVA_variables.s4ratio) );
-  photonIDMVA_reader_EE->AddVariable("ph.idmva_GammaIso",   &(photonIDMVA_variables.pfphotoniso03) );
-  photonIDMVA_reader_EE->AddVariable("ph.idmva_ChargedIso_selvtx",   &(photonIDMVA_variables.pfchargedisogood03) );
-  photonIDMVA_reader_EE->AddVariable("ph.idmva_ChargedIso_worstvtx",   &(photonIDMVA_variables.pfchargedisobad03) );
-  photonIDMVA_reader_EE->AddVariable("ph.sceta",   &(photonIDMVA_variables.sceta) );
-  photonIDMVA_reader_EE->AddVariable("rho",   &(photonIDMVA_variables.eventrho) );
-  photonIDMVA_reader_EE->AddVariable("ph.idmva_PsEffWidthSigmaRR",   &(photonIDMVA_variables.ESEffSigmaRR) );
-
-  {
+    // Photon ID BDTs, in the variable order of the weight files; the EE one has the preshower width in addition
+    static const char* photonIDVariables[] = { "ph.scrawe", "ph.r9", "ph.sigietaieta", "ph.scetawidth", "ph.scphiwidth",
+					       "ph.idmva_CoviEtaiPhi", "ph.idmva_s4ratio", "ph.idmva_GammaIso",
+					       "ph.idmva_ChargedIso_selvtx", "ph.idmva_ChargedIso_worstvtx", "ph.sceta", "rho",
+					       "ph.idmva_PsEffWidthSigmaRR" };
+    std::vector<std::string> variablesEE(photonIDVariables, photonIDVariables+13);
+    std::vector<std::string> variablesEB(photonIDVariables, photonIDVariables+12);
     WeightsPhotonIDMVA_EB = iConfig.getParameter<std::string>("tag_WeightsPhotonIDMVA_EB");
     WeightsPhotonIDMVA_EE = iConfig.getParameter<std::string>("tag_WeightsPhotonIDMVA_EE");
+    bool cacheForest = iConfig.getParameter<bool>("cachePhotonIDMVAForest");
     TString descr = getenv("CMSSW_BASE");
-    photonIDMVA_reader_EB->BookMVA("AdaBoost",Form("%s/src/DiLeptonAnalysis/NTupleProducer/data/%s",descr.Data(),WeightsPhotonIDMVA_EB.c_str()));
-    photonIDMVA_reader_EE->BookMVA("AdaBoost",Form("%s/src/DiLeptonAnalysis/NTupleProducer/data/%s",descr.Data(),WeightsPhotonIDMVA_EE.c_str()));
-  }
+    std::string pathEB = Form("%s/src/DiLeptonAnalysis/NTupleProducer/data/%s",descr.Data(),WeightsPhotonIDMVA_EB.c_str());
+    std::string pathEE = Form("%s/src/DiLeptonAnalysis/NTupleProducer/data/%s",descr.Data(),WeightsPhotonIDMVA_EE.c_str());
+    // The caches go to a writable directory, $CMSSW_BASE/tmp unless configured
+    std::string cacheDir = iConfig.getParameter<std::string>("photonIDMVAForestCacheDir");
+    if (cacheDir.empty()) cacheDir = std::string(descr.Data()) + "/tmp";
+    std::string cacheEB = cacheForest ? cacheDir + "/" + WeightsPhotonIDMVA_EB + ".forest" : "";
+    std::string cacheEE = cacheForest ? cacheDir + "/" + WeightsPhotonIDMVA_EE + ".forest" : "";
+    fPhotonIDForestEB.load(pathEB, variablesEB, cacheEB);
+    fPhotonIDForestEE.load(pathEE, variablesEE, cacheEE);
   }
 
 }
@@ -487,11 +543,9 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
 
   ++fNTotEvents;
 
-  using namespace edm;
-  using namespace std;
-  using namespace reco;
-  using reco::MuonCollection;
-  using reco::JetTagCollection;
+  // Each collection is retrieved once per event, for the producer and the fillers
+  fCollections.newEvent(iEvent);
+  fCorrectedJets.newEvent(iEvent, iSetup, &fCollections);
 
   // Reset all the variables
   resetProducts();
@@ -511,39 +565,95 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
         it != pfFillers.end(); ++it ) 
     (*it)->resetProducts();
 
+  // Run the enabled stages
+  fCurrentEvent = &iEvent;
+  fCurrentSetup = &iSetup;
+  if ( !fScheduler->run() ) return false;
 
-  ////////////////////////////////////////////////////////////////////////////////
-  // Get the collections /////////////////////////////////////////////////////////
-  Handle<View<Muon> > muons;
-  iEvent.getByLabel(fMuonTag,muons); // 'muons'
+  ///////////////////////////////////////////////////////////////////////////////
+  // Fill Tree //////////////////////////////////////////////////////////////////
+  fStageTimer.start(fPutTimer);
+  putProducts( iEvent );
+  for ( std::vector<JetFillerBase*>::iterator it = jetFillers.begin();
+        it != jetFillers.end(); ++it )
+    (*it)->putProducts(iEvent);
+  for ( std::vector<PatMuonFiller*>::iterator it = muonFillers.begin(); 
+        it != muonFillers.end(); ++it ) 
+    (*it)->putProducts(iEvent);
+  for ( std::vector<PatElectronFiller*>::iterator it = electronFillers.begin(); 
+        it != electronFillers.end(); ++it ) 
+    (*it)->putProducts(iEvent);
+  for ( std::vector<PatTauFiller*>::iterator it = tauFillers.begin(); 
+        it != tauFillers.end(); ++it ) 
+    (*it)->putProducts(iEvent);
+  for ( std::vector<PFFiller*>::iterator it = pfFillers.begin(); 
+        it != pfFillers.end(); ++it ) 
+    (*it)->putProducts(iEvent);
+  fStageTimer.stop(fPutTimer);
+  
+  fNFillTree++;
+  
+  // Not used as a filter right now
+  return true;
+}
 
-  Handle<View<GsfElectron> > electrons;
-  iEvent.getByLabel(fElectronTag, electrons); // 'gsfElectrons'
+//________________________________________________________________________________________
+// Register a stage of the event loop, with its own timer
+// 'after' lists the names of earlier stages this one depends on, besides Prepare
+void NTupleProducer::addStage(const std::string& name, StageFunction fill, const std::string& after) {
+  Stage stage;
+  stage.name    = name;
+  stage.fill    = fill;
+  stage.enabled = true;
+  stage.timer   = fStageTimer.add(name);
+  if (!fStages.empty()) stage.after.push_back(0);
+  std::istringstream names(after);
+  std::string dep;
+  while (names >> dep) {
+    unsigned i = 0;
+    while (i < fStages.size() && fStages[i].name != dep) ++i;
+    if (i == fStages.size())
+      throw cms::Exception("LogicError") << "Stage " << name << " depends on unknown stage " << dep;
+    stage.after.push_back(i);
+  }
+  fStages.push_back(stage);
+}
 
-  // Jets and Jet Correctors
-  Handle<View<Jet> > jets;
-  iEvent.getByLabel(fJetTag,jets);
+//________________________________________________________________________________________
+// Run one stage of the current event, possibly in a worker thread
+bool NTupleProducer::runStage(unsigned i) {
+  const Stage& stage = fStages[i];
+  if (!stage.enabled) return true;
+  fStageTimer.start(stage.timer);
+  bool accept = (this->*(stage.fill))(*fCurrentEvent, *fCurrentSetup);
+  fStageTimer.stop(stage.timer);
+  return accept;
+}
+
+//________________________________________________________________________________________
+// Event-wide quantities and per-event helpers used by the later stages
+bool NTupleProducer::fillPrepare(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+  using namespace edm;
+  using namespace std;
 
   // rho for L1FastJet
   edm::Handle<double> rho;
-  iEvent.getByLabel(fSrcRho,rho);
+  fCollections.getByLabel(fSrcRho,rho);
   *fTRho = *rho;
 	
   // sigma for L1FastJet
   edm::Handle<double> sigma;
-  iEvent.getByLabel(fSrcSigma,sigma);
+  fCollections.getByLabel(fSrcSigma,sigma);
   *fTSigma = *sigma;
 
   // rho for correcting isolation
   edm::Handle<double> rhoForIso;
-  iEvent.getByLabel(fSrcRhoForIso,rhoForIso);
+  fCollections.getByLabel(fSrcRhoForIso,rhoForIso);
   *fTRhoForIso = *rhoForIso;
 
   // rho for QG tagger systematics 
-  edm::Handle<double> rhoForQG;
-
   if (doPhotonStuff)  {
-    iEvent.getByLabel("kt6PFJetsForQGSyst","rho",rhoForQG);
     TString descr = getenv("CMSSW_BASE");
     std::string systDB_fullPath;
     if (QGSystString=="pythia") systDB_fullPath = Form("%s/src/QuarkGluonTagger/EightTeV/data/SystDatabase.txt",descr.Data()); // for Pythia
@@ -551,143 +661,54 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     qgsyst.ReadDatabaseDoubleMin(systDB_fullPath);
   }
 
-  edm::Handle<reco::GenParticleCollection> GlobalGenParticles;
-  if (!fIsRealData) iEvent.getByLabel(fGenPartTag, GlobalGenParticles);
-
   // beam halo
   if(!fIsFastSim){
   edm::Handle<BeamHaloSummary> TheBeamHaloSummary;
-  iEvent.getByLabel("BeamHaloSummary",TheBeamHaloSummary);
+  fCollections.getByLabel("BeamHaloSummary",TheBeamHaloSummary);
   const BeamHaloSummary TheSummary = (*TheBeamHaloSummary.product());
   *fTCSCTightHaloID = (TheSummary.CSCTightHaloId()) ? 0:1;
   }
-  // collect information for b-tagging (4 tags)
-  Handle<JetTagCollection> jetsBtag[gMaxNBtags];
-  size_t ibtag = 0;
-  for ( std::vector<edm::InputTag>::const_iterator it=fBtagTags.begin(); it!=fBtagTags.end(); ++it ) 
-    iEvent.getByLabel((*it),jetsBtag[ibtag++]);
 
-  FlavourMap flavours;
-  if(!fIsRealData){
-  // Get matching parton flavour for jets
-  edm::Handle<reco::JetFlavourMatchingCollection> jetMC;
-  iEvent.getByLabel(fPartonMatch, jetMC);
-  for (reco::JetFlavourMatchingCollection::const_iterator iter = jetMC->begin();
-       iter != jetMC->end(); iter++) {
-    int fl = iter->second.getFlavour();
-    //std::cout << "flavour " << fl << " ";
-    flavours.insert(FlavourMap::value_type(iter->first, fl));
-    }
-  }
-
-  //Get Tracks collection
-  Handle<TrackCollection> tracks;
-  iEvent.getByLabel(fTrackTag, tracks);
-
-  //Get Photon collection
-  Handle<View<Photon> > photons;
-  iEvent.getByLabel(fPhotonTag, photons);
-
-  //Get SC collections
-  Handle<SuperClusterCollection> BarrelSuperClusters;
-  Handle<SuperClusterCollection> EndcapSuperClusters;
-  Handle<edm::View<reco::Candidate> > GoodSuperClusters;
-
-  iEvent.getByLabel(fSCTagBarrel,BarrelSuperClusters);
-  iEvent.getByLabel(fSCTagEndcap,EndcapSuperClusters);
-  iEvent.getByLabel("goodSuperClustersClean", GoodSuperClusters);
-
-	
   // PFcandidates
   edm::Handle<reco::PFCandidateCollection> pfCandidates;
-  iEvent.getByLabel(pfProducerTag, pfCandidates);
-  const  PFCandidateCollection thePfColl = *(pfCandidates.product());
-
-  // PF candidate isolation
-  Handle< edm::ValueMap<float> > muonPfIsoTagsCustom[gMaxNPfIsoTags];
-  size_t ipfisotag = 0;
-  for ( std::vector<edm::InputTag>::const_iterator it=fMuonPfIsoTagsCustom.begin(); 
-        it!=fMuonPfIsoTagsCustom.end(); ++it ) 
-    iEvent.getByLabel((*it),muonPfIsoTagsCustom[ipfisotag++]);
-  Handle< edm::ValueMap<float> > elePfIsoTagsCustom[gMaxNPfIsoTags];
-  ipfisotag = 0;
-  for ( std::vector<edm::InputTag>::const_iterator it=fElePfIsoTagsCustom.begin(); 
-        it!=fElePfIsoTagsCustom.end(); ++it ) 
-    iEvent.getByLabel((*it),elePfIsoTagsCustom[ipfisotag++]);
-  Handle< edm::ValueMap<double> > elePfIsoTagsEvent[gMaxNPfIsoTags];
-  ipfisotag = 0;
-  for ( std::vector<edm::InputTag>::const_iterator it=fElePfIsoTagsEvent.begin(); 
-        it!=fElePfIsoTagsEvent.end(); ++it ) 
-    iEvent.getByLabel((*it),elePfIsoTagsEvent[ipfisotag++]);
-	
-  //Electron collection
-  edm::Handle<reco::GsfElectronCollection> electronHandle;
-  iEvent.getByLabel(fElectronTag, electronHandle);
-	
-  //PF Photon collection
-  edm::Handle<reco::PhotonCollection> pfPhotonHandle;
-  iEvent.getByLabel(pfphotonsProducerTag,pfPhotonHandle);
-	
-  // MET
-  Handle<CaloMETCollection> calomet;
-  iEvent.getByLabel(fRawCaloMETTag, calomet);
-
-  Handle<METCollection> tcmet;
-  iEvent.getByLabel(fTCMETTag, tcmet);
-
-  Handle<View<PFMET> > pfmet;
-  iEvent.getByLabel(fPFMETTag, pfmet);
-	
-  Handle<CaloMETCollection> corrmujesmet;
-  iEvent.getByLabel(fCorrCaloMETTag, corrmujesmet);
-
-  // Get beamspot for d0 determination
-  BeamSpot beamSpot;
-  Handle<BeamSpot> beamSpotHandle;
-  iEvent.getByLabel("offlineBeamSpot", beamSpotHandle);
-  beamSpot = *beamSpotHandle;
-
-  // Primary vertex
-  edm::Handle<VertexCollection> vertices;
-  iEvent.getByLabel(fVertexTag, vertices);
-  const reco::Vertex *primVtx = (vertices->size()>0) ? &(*(vertices.product()))[0] : NULL; // Just take first vertex ...
-
-  // Get Muon IsoDeposits
-  // ECAL:
-  edm::Handle<edm::ValueMap<reco::IsoDeposit> > IsoDepECValueMap;
-  iEvent.getByLabel(fMuIsoDepECTag, IsoDepECValueMap);
-  const edm::ValueMap<reco::IsoDeposit> &ECDepMap = *IsoDepECValueMap.product();
-  // HCAL:
-  edm::Handle<edm::ValueMap<reco::IsoDeposit> > IsoDepHCValueMap;
-  iEvent.getByLabel(fMuIsoDepHCTag, IsoDepHCValueMap);
-  const edm::ValueMap<reco::IsoDeposit> &HCDepMap = *IsoDepHCValueMap.product();
-
-  // Get CaloTowers
-  edm::Handle<CaloTowerCollection> calotowers;
-  iEvent.getByLabel(fCalTowTag, calotowers);
-
-  // For ECAL cleaning: rechit and channel status
-  edm::Handle<EcalRecHitCollection> ebRecHits;
-  edm::Handle<EcalRecHitCollection> eeRecHits;
-  iEvent.getByLabel(fEBRecHitsTag,ebRecHits);
-  iEvent.getByLabel(fEERecHitsTag,eeRecHits);
-  // edm::ESHandle<EcalChannelStatus> chStatus;
-  // iSetup.get<EcalChannelStatusRcd>().get(chStatus);
-  // const EcalChannelStatus * channelStatus = chStatus.product();
-
-  edm::ESHandle<CaloGeometry> geometry ;
-  iSetup.get<CaloGeometryRecord>().get(geometry);
-  const CaloSubdetectorGeometry *barrelGeometry = geometry->getSubdetectorGeometry(DetId::Ecal, EcalBarrel);
-  const CaloSubdetectorGeometry *endcapGeometry = geometry->getSubdetectorGeometry(DetId::Ecal, EcalEndcap);
-
-  edm::ESHandle<CaloTopology> theCaloTopo;
-  iSetup.get<CaloTopologyRecord>().get(theCaloTopo);
-  const CaloTopology *topology = theCaloTopo.product();
+  fCollections.getByLabel(pfProducerTag, pfCandidates);
+
+  // Eta-phi index used by the CiC isolation sums
+  fPFCandTypes.resize(pfCandidates->size());
+  for (size_t i=0; i<pfCandidates->size(); ++i) fPFCandTypes[i] = FindPFCandType((*pfCandidates)[i].pdgId());
+  fPFCandGrid.build(*pfCandidates, fPFCandTypes);
+  fPFCandArrays.fill(*pfCandidates, fPFCandTypes);
+
+  // PF gammas by supercluster and PF electrons by GSF track, for the photon matching
+  // (the last candidate wins, as in the scans this replaces)
+  fPFGammaBySC.clear();
+  fPFElectronByGsf.clear();
+  fSCIndexByRef.clear();
+  fGenPhotonByIndex.clear();
+  fConvTrackKeys.clear();
+  fPromptElectronBySC.clear();
+  fPFPhotonsBySC.clear();
+  const double MVACut_ = -0.1; //42X
+  //const double MVACut_ = -1.; //44X
+  for (size_t i=0; i<pfCandidates->size() && doPhotonStuff; ++i) {
+    const reco::PFCandidate& cand = (*pfCandidates)[i];
+    if (cand.particleId()==reco::PFCandidate::gamma && cand.mva_nothing_gamma()>0 && cand.superClusterRef().isNonnull())
+      fPFGammaBySC[refKey(cand.superClusterRef().id(), cand.superClusterRef().key())] = i;
+    if (cand.particleId()==reco::PFCandidate::e && cand.gsfTrackRef().isNull()==false && cand.mva_e_pi()>MVACut_)
+      fPFElectronByGsf[refKey(cand.gsfTrackRef().id(), cand.gsfTrackRef().key())] = i;
+  }
 
   CrackCorrFunc->init(iSetup);
   LocalCorrFunc->init(iSetup);
 
-  EcalClusterLazyTools lazyTools( iEvent, iSetup, edm::InputTag("reducedEcalRecHitsEB"), edm::InputTag("reducedEcalRecHitsEE") );
+  // Event setup products of the later stages, which may run concurrently
+  iSetup.get<TransientTrackRecord>().get("TransientTrackBuilder",fTheB);
+  fTransientTracks.newEvent(fTheB.product());
+  iSetup.get<CaloGeometryRecord>().get(fCaloGeometry);
+  iSetup.get<CaloTopologyRecord>().get(fCaloTopology);
+
+  // Shared by the electron and photon stages
+  fLazyTools.reset(new EcalClusterLazyTools( iEvent, iSetup, edm::InputTag("reducedEcalRecHitsEB"), edm::InputTag("reducedEcalRecHitsEE") ));
 
   if (doPhotonStuff) {
   if (!corSemiParm.IsInitialized() && (regrVersion==5 || regrVersion==8)) {
@@ -707,19 +728,9 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
   }
   }
 
-  Handle<double> hRhoRegr;
-  iEvent.getByLabel(edm::InputTag("kt6PFJets","rho"), hRhoRegr); 
-
-  edm::Handle<edm::ValueMap<float> >  QGTagsHandleMLP;
-  edm::Handle<edm::ValueMap<float> >  QGTagsHandleLikelihood;
-  if (doPhotonStuff){
-    iEvent.getByLabel("QGTagger","qgMLP", QGTagsHandleMLP);
-    iEvent.getByLabel("QGTagger","qgLikelihood", QGTagsHandleLikelihood);
-  }
-
   // type-I corrected MET for 2012 analyses
   edm::Handle<View<PFMET> > typeICorMET;
-  iEvent.getByLabel("pfType1CorrectedMet",typeICorMET);
+  fCollections.getByLabel("pfType1CorrectedMet",typeICorMET);
   // *fTtypeICorMET = (float) *typeICorMET;
   *fTPFType1MET             = (typeICorMET->front()).pt();
   *fTPFType1METpx           = (typeICorMET->front()).px();
@@ -732,10 +743,39 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
   *fTPFType1METSignificance = significance;
   *fTPFType1SumEt           = (typeICorMET->front()).sumEt();
 
+  // Tracks of the vertices, for the diphoton vertexing and the jet beta
+  edm::Handle<VertexCollection> vertices;
+  fCollections.getByLabel(fVertexTag, vertices);
+  fTrackVertexTable.fill(*vertices);
+
+  // Stable generator particles, for the matching of the muons, electrons and photons
+  fGenMatcher.clear();
+  if (!fIsRealData) {
+    edm::Handle<GenParticleCollection> genParticles;
+    fCollections.getByLabel(fGenPartTag, genParticles);
+    fGenMatcher.fillParticles(*genParticles);
+  }
+
+  // State passed between the stages
+  elPtrVector.clear();
+  storethispfcand.assign(pfCandidates->size(), false);
+  PhotonToPFPhotonMatchingArray.assign(gMaxNPhotons, -999);
+  PhotonToPFPhotonMatchingArrayTranslator.assign(gMaxNPhotons, -999);
+  PhotonToPFElectronMatchingArray.assign(gMaxNPhotons, -999);
+  PhotonToPFElectronMatchingArrayTranslator.assign(gMaxNPhotons, -999);
+  list_pfcand_footprint.assign(gMaxNPhotons, std::vector<int>());
+  list_pfcand_footprintTranslator.assign(gMaxNPhotons, std::vector<int>());
+  PfCandToJetMatchingArray.assign(pfCandidates->size(), -999);
 
-  // Get Transient Track Builder
-  ESHandle<TransientTrackBuilder> theB;
-  iSetup.get<TransientTrackRecord>().get("TransientTrackBuilder",theB);
+  return true;
+}
+
+//________________________________________________________________________________________
+// Generator event information, LHE event, pile-up and PDF weights
+bool NTupleProducer::fillGenEventInfo(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+  using namespace edm;
+  using namespace std;
 
   // Get GenEventInfoProduct
   edm::Handle<GenEventInfoProduct> genEvtInfo;
@@ -750,7 +790,11 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
   if(!fIsRealData && !fIsFastSim){
     // Get LHEEventProduct with partonic momenta. 	
     Handle<LHEEventProduct> evt;
-    bool LHEEventProduct_found= iEvent.getByType( evt );
+    bool LHEEventProduct_found;
+    {
+      EventCollectionCache::Lock lock(&fCollections);
+      LHEEventProduct_found= iEvent.getByType( evt );
+    }
     if(LHEEventProduct_found){ 
       const lhef::HEPEUP hepeup_ = evt->hepeup();
       const std::vector<lhef::HEPEUP::FiveVector> pup_ = hepeup_.PUP; // px, py, pz, E, M
@@ -778,7 +822,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
 
       }
     
-    iEvent.getByLabel("generator", genEvtInfo);
+    fCollections.getByLabel("generator", genEvtInfo);
     *fTPtHat       = genEvtInfo->hasBinningValues() ? (genEvtInfo->binningValues())[0] : 0.0;
     *fTSigProcID   = genEvtInfo->signalProcessID();
     *fTPDFScalePDF = genEvtInfo->pdf()->scalePDF;
@@ -790,7 +834,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     *fTPDFxPDF2    = genEvtInfo->pdf()->xPDF.second;
     *fTGenWeight   = genEvtInfo->weight();
      
-    iEvent.getByLabel("addPileupInfo", pileupInfo);
+    fCollections.getByLabel("addPileupInfo", pileupInfo);
     std::vector<PileupSummaryInfo>::const_iterator PVI;
 
     for (PVI = pileupInfo->begin(); PVI !=pileupInfo->end(); ++PVI) {
@@ -802,7 +846,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
           edm::LogWarning("NTP") << "@SUB=analyze()"
                                  << "More than " << static_cast<int>(gMaxNPileup)
                                  << " generated Pileup events found, increase size!";
-          *fTGoodEvent = 1;
+          flagBadEvent();
         }
 		    
         *fTPUnumFilled = (int)PVI->getPU_zpositions().size();
@@ -824,12 +868,13 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     // as well as http://cmslxr.fnal.gov/lxr/source/PhysicsTools/Utilities/src/LumiReWeighting.cc
     if(!fPileUpData[0].empty() && !fPileUpMC[0].empty() ){
       //const EventBase* iEventB = dynamic_cast<const EventBase*>(&iEvent);
+      EventCollectionCache::Lock lock(&fCollections);
       MyWeightTotal  = LumiWeights_.weightOOT( iEvent ); // this is the total weight inTimeWeight * WeightOOTPU * Correct_Weights2011
       MyWeightInTime = LumiWeights_.weight   ( iEvent ); // this is the inTimeWeight only
     }
     if(fIsModelScan) {
       edm::Handle<GenEventInfoProduct> pdfstuff;
-      if (!iEvent.getByLabel("generator", pdfstuff)) {
+      if (!fCollections.getByLabel("generator", pdfstuff)) {
         edm::LogError("PDFWeightProducer") << ">>> PdfInfo not found !!!";
         return false;
       }
@@ -875,26 +920,53 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
   }
   *fTPUWeightTotal  = MyWeightTotal;
   *fTPUWeightInTime = MyWeightInTime;
-	
-	
+
+  return true;
+}
+
+//________________________________________________________________________________________
+// HLT and L1 trigger bits and trigger objects
+bool NTupleProducer::fillTrigger(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+  using namespace edm;
+  using namespace std;
+
   //////////////////////////////////////////////////////////////////////////////
   // Trigger information
   Handle<L1GlobalTriggerReadoutRecord> l1GtReadoutRecord;
-  iEvent.getByLabel(fL1TriggerTag, l1GtReadoutRecord);
+  fCollections.getByLabel(fL1TriggerTag, l1GtReadoutRecord);
 
   Handle<trigger::TriggerEvent> triggerEventHLT;
-  iEvent.getByLabel("hltTriggerSummaryAOD", triggerEventHLT);
+  fCollections.getByLabel("hltTriggerSummaryAOD", triggerEventHLT);
   
   // Retrieve trigger results, with process name auto-discovered in beginRun()
   Handle<TriggerResults> triggers;
-  iEvent.getByLabel(InputTag("TriggerResults","",fHltConfig.processName()), triggers);
+  fCollections.getByLabel(fHLTResultsTag, triggers);
   const TriggerResults& tr = *triggers;
 
+  // The prescale set only changes at lumi block boundaries
+  if ( iEvent.id().run() != fHLTPrescaleRun || iEvent.luminosityBlock() != fHLTPrescaleLumi ) {
+    EventCollectionCache::Lock lock(&fCollections); // prescales are read from the event
+    fHLTPrescaleRun  = iEvent.id().run();
+    fHLTPrescaleLumi = iEvent.luminosityBlock();
+    fHLTPrescales.resize(fRHLTNames->size());
+    for (size_t i = 0; i < fRHLTNames->size(); ++i)
+      fHLTPrescales[i] = fHltConfig.prescaleValue(iEvent, iSetup, (*fRHLTNames)[i]);
+  }
+
   // Get trigger results and prescale
+  const bool packed   = fBranchGroupOn[NTupleBranches::kTriggerBits];
+  const bool unpacked = fBranchGroupOn[NTupleBranches::kTriggerUnpacked];
+  if (packed) {
+    TriggerBits::clear(*fTHLTResultBits, tr.size());
+    TriggerBits::clear(*fTL1PhysResultBits, gMaxL1PhysBits);
+    TriggerBits::clear(*fTL1TechResultBits, gMaxL1TechBits);
+  }
   for(unsigned int i = 0; i < tr.size(); i++ ){
     bool fired = tr[i].accept();
-    fTHLTResults->push_back( fired ? 1:0 );
-    fTHLTPrescale->push_back( fHltConfig.prescaleValue(iEvent, iSetup, (*fRHLTNames)[i]) );
+    if (packed && fired) TriggerBits::set(*fTHLTResultBits, i);
+    if (unpacked) fTHLTResults->push_back( fired ? 1:0 );
+    fTHLTPrescale->push_back( fHLTPrescales[i] );
     //FIXME: TOO MANY ERRORS FOR THE MOMENT.
     //           // Check that there is only 1 L1 seed (otherwise we can't get the combined prescale)
     //           if ( fHltConfig.hltL1GTSeeds(fTHLTmenu[i]).size() == 1 ) {
@@ -907,31 +979,25 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
   }
   for( unsigned int i = 0; i < gMaxL1PhysBits; ++i ){
     bool fired = l1GtReadoutRecord->decisionWord()[i];
-    fTL1PhysResults->push_back( fired ? 1:0 );
+    if (packed && fired) TriggerBits::set(*fTL1PhysResultBits, i);
+    if (unpacked) fTL1PhysResults->push_back( fired ? 1:0 );
   }
   for( unsigned int i = 0; i < gMaxL1TechBits; ++i){
     bool fired = l1GtReadoutRecord->technicalTriggerWord()[i];
-    fTL1TechResults->push_back( fired ? 1:0 );
+    if (packed && fired) TriggerBits::set(*fTL1TechResultBits, i);
+    if (unpacked) fTL1TechResults->push_back( fired ? 1:0 );
   }
 
   // Store information for some trigger paths
   edm::Handle<trigger::TriggerEvent> trgEvent;
-  iEvent.getByLabel(fHLTTrigEventTag, trgEvent);
+  fCollections.getByLabel(fHLTTrigEventTag, trgEvent);
 
 
-  InputTag collectionTag;
-  // Loop over path names and get related objects
-  const std::vector<std::string> allTrigNames = fHltConfig.triggerNames();
+  // Loop over the paths resolved in beginRun() and get related objects
   for (size_t i=0; i<fTNpaths; ++i) {
-    size_t j = 0;
-    for(; j <allTrigNames.size();++j) {
-      if(allTrigNames[j].find(fHLTLabels[i])!=string::npos) break;
-    }
-    if (j==allTrigNames.size()) continue;
-    const std::vector<std::string> filtertags = fHltConfig.moduleLabels(allTrigNames[j]);
-    if(filtertags.size() < 2) continue;
-    collectionTag = edm::InputTag(filtertags[filtertags.size()-2],"",fHltConfig.processName());
-    size_t  filterIndex_ = trgEvent->filterIndex(collectionTag);
+    HLTObjectPath& hltPath = fHLTObjectPaths[i];
+    if (hltPath.path < 0) continue;
+    size_t  filterIndex_ = hltFilterIndex(hltPath.filter, *trgEvent);
     if (filterIndex_<trgEvent->sizeFilters()) {
       const trigger::TriggerObjectCollection& TOC(trgEvent->getObjects());
       const trigger::Keys& keys = trgEvent->filterKeys(filterIndex_);
@@ -948,6 +1014,69 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     }
   }
 
+  return true;
+}
+
+//________________________________________________________________________________________
+// Index of a filter in the TriggerEvent, sizeFilters() if it did not run; the
+// index found in the previous event is tried first
+size_t NTupleProducer::hltFilterIndex(HLTFilter& filter, const trigger::TriggerEvent& trgEvent) const {
+  if (filter.index >= trgEvent.sizeFilters() || trgEvent.filterTag(filter.index) != filter.tag)
+    filter.index = trgEvent.filterIndex(filter.tag);
+  return filter.index;
+}
+
+//________________________________________________________________________________________
+// Matching of the stored muons, electrons, photons and jets to the trigger objects
+bool NTupleProducer::fillTriggerMatch(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+  using namespace edm;
+  using namespace std;
+
+  edm::Handle<trigger::TriggerEvent> trgEvent;
+  fCollections.getByLabel(fHLTTrigEventTag, trgEvent);
+
+  // Filters passed by each trigger object
+  const trigger::TriggerObjectCollection& TOC(trgEvent->getObjects());
+  fTrigObjectMasks.assign(TOC.size(), 0);
+  for (size_t f=0; f<fTrigMatchFilters.size(); ++f) {
+    size_t filterIndex_ = hltFilterIndex(fTrigMatchFilters[f], *trgEvent);
+    if (filterIndex_ >= trgEvent->sizeFilters()) continue;
+    const trigger::Keys& keys = trgEvent->filterKeys(filterIndex_);
+    for (size_t k=0; k<keys.size(); ++k) fTrigObjectMasks[keys[k]] |= 1u << f;
+  }
+  fTrigObjectMatcher.clear();
+  for (size_t i=0; i<TOC.size(); ++i)
+    if (fTrigObjectMasks[i]) fTrigObjectMatcher.add(TOC[i].eta(), TOC[i].phi(), fTrigObjectMasks[i]);
+  fTrigObjectMatcher.build();
+
+  for (size_t i=0; i<fTMuEta->size(); ++i)
+    fTMuTrigMatch->push_back( fTrigObjectMatcher.match((*fTMuEta)[i], (*fTMuPhi)[i], fTrigMatchDeltaR) );
+  for (size_t i=0; i<fTElEta->size(); ++i)
+    fTElTrigMatch->push_back( fTrigObjectMatcher.match((*fTElEta)[i], (*fTElPhi)[i], fTrigMatchDeltaR) );
+  for (size_t i=0; i<fTPhoEta->size(); ++i)
+    fTPhoTrigMatch->push_back( fTrigObjectMatcher.match((*fTPhoEta)[i], (*fTPhoPhi)[i], fTrigMatchDeltaR) );
+  for (size_t i=0; i<fTJEta->size(); ++i)
+    fTJTrigMatch->push_back( fTrigObjectMatcher.match((*fTJEta)[i], (*fTJPhi)[i], fTrigMatchJetDeltaR) );
+
+  return true;
+}
+
+//________________________________________________________________________________________
+// Event numbers, primary vertices and beam spot
+bool NTupleProducer::fillEventInfo(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+  using namespace edm;
+  using namespace std;
+
+  // Get beamspot for d0 determination
+  BeamSpot beamSpot;
+  Handle<BeamSpot> beamSpotHandle;
+  fCollections.getByLabel("offlineBeamSpot", beamSpotHandle);
+  beamSpot = *beamSpotHandle;
+  edm::Handle<VertexCollection> vertices;
+  fCollections.getByLabel(fVertexTag, vertices);
+  const reco::Vertex *primVtx = (vertices->size()>0) ? &(*(vertices.product()))[0] : NULL; // Just take first vertex ...
 
   ////////////////////////////////////////////////////////////////////////////////
   // Dump tree variables /////////////////////////////////////////////////////////
@@ -985,7 +1114,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     if(countVrtx >= gMaxNVrtx){
       edm::LogWarning("NTP") << "@SUB=analyze()"
                              << "Maximum number of vertices exceeded";
-      *fTGoodEvent = 1;
+      flagBadEvent();
       *fTMaxVerticesExceed = 1;
       break;
     }
@@ -1010,14 +1139,22 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
   *fTBeamspoty = (beamSpot.position()).y();
   *fTBeamspotz = (beamSpot.position()).z();
 
-  IndexByPt indexComparator; // Need this to sort collections
+  return true;
+}
+
+//________________________________________________________________________________________
+// Generator vertices
+bool NTupleProducer::fillGenVertices(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+  using namespace edm;
+  using namespace std;
 
   /////////////////////////////////////////
   /// GenVertices 
   if (!fIsRealData && doPhotonStuff){
 
     edm::Handle<reco::GenParticleCollection> gpH;
-    iEvent.getByLabel(fGenPartTag, gpH);
+    fCollections.getByLabel(fGenPartTag, gpH);
 
     const float lowPtThrGenVtx = 0.1;
     const float highPtThrGenVtx = 0.5;
@@ -1029,7 +1166,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
       if (*fTNgv>=gMaxNGenVtx){
         edm::LogWarning("NTP") << "@SUB=analyze"
                                << "Maximum number of gen-vertices exceeded..";
-        *fTGoodEvent = 1;
+        flagBadEvent();
         break;
       }
 
@@ -1083,14 +1220,22 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
 
   } // end gen vertices
 
+  return true;
+}
 
+//________________________________________________________________________________________
+// Generator leptons, with mother and grand-mother
+bool NTupleProducer::fillGenLeptons(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+  using namespace edm;
+  using namespace std;
 
   ////////////////////////////////////////////////////////////////////////////////
   // Get GenLeptons (+ Mother and GMother)
   // FIXME: TO BE REMOVED ONCE WE ARE HAPPY WITH THE FULL GEN. INFO
   if(!fIsRealData){
     edm::Handle<GenParticleCollection> gen;
-    iEvent.getByLabel(fGenPartTag, gen);
+    fCollections.getByLabel(fGenPartTag, gen);
     GenParticleCollection::const_iterator g_part;
     GenParticleCollection::const_iterator g_end = gen->end();
 
@@ -1202,7 +1347,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
           edm::LogWarning("NTP") << "@SUB=analyze"
                                  << "Maximum number of gen-leptons exceeded..";
           *fTMaxGenLepExceed = 1;
-          *fTGoodEvent = 1;
+          flagBadEvent();
           break;
         }
 
@@ -1226,21 +1371,31 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     }
   }
 
+  return true;
+}
+
+//________________________________________________________________________________________
+// Generator photons
+bool NTupleProducer::fillGenPhotons(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+  using namespace edm;
+  using namespace std;
+
   ////////////////////////////////////////////////////////////////////////////////
   // Gen GenPhotons
   // FIXME: TO BE REMOVED ONCE WE ARE HAPPY WITH THE FULL GEN. INFO
   if(!fIsRealData){
     edm::Handle<GenParticleCollection> gen;
-    iEvent.getByLabel(fGenPartTag, gen);
+    fCollections.getByLabel(fGenPartTag, gen);
     GenParticleCollection::const_iterator g_part;
 	
     // Steve Mrenna's status 2 parton jets
     edm::Handle<GenJetCollection> partonGenJets;
-    iEvent.getByLabel("partonGenJets", partonGenJets);
+    fCollections.getByLabel("partonGenJets", partonGenJets);
     GenJetCollection::const_iterator pGenJet;
 
     edm::Handle<View<Candidate> > partons;
-    iEvent.getByLabel("partons", partons);
+    fCollections.getByLabel("partons", partons);
 	 
     std::vector<const GenParticle*> gen_photons;
     std::vector<const GenParticle*> gen_photons_mothers;
@@ -1270,10 +1425,11 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
       if( i >= gMaxNGenPhot){
         edm::LogWarning("NTP") << "@SUB=analyze" << "Maximum number of gen-photons exceeded..";
         *fTMaxPhotonsExceed = 1;
-        *fTGoodEvent = 1;
+        flagBadEvent();
         break;
       }
 
+      fGenPhotonByIndex[gen_photons[i] - &gen->front()] = i;
       fTGenPhotonPt->push_back( gen_photons[i]->pt() );
       fTGenPhotonEta->push_back( gen_photons[i]->eta() );
     
@@ -1302,12 +1458,21 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     }
   }
 
+  return true;
+}
+
+//________________________________________________________________________________________
+// Generator jets
+bool NTupleProducer::fillGenJets(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+  using namespace edm;
+  using namespace std;
 
   ////////////////////////////////////////////////////////////////////////////////
   // Get GenJets
   if(!fIsRealData){
     edm::Handle<GenJetCollection> genjets;
-    iEvent.getByLabel(fGenJetTag, genjets);
+    fCollections.getByLabel(fGenJetTag, genjets);
     GenJetCollection::const_iterator gjet;
 		
     int jqi=-1;
@@ -1320,7 +1485,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
         edm::LogWarning("NTP") << "@SUB=analyze"
                                << "Maximum number of gen-jets exceeded..";
         *fTMaxGenJetExceed = 1;
-        *fTGoodEvent = 1;
+        flagBadEvent();
         break;
       }
 			
@@ -1333,8 +1498,47 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
       fTGenJetInvE->push_back( gjet->invisibleEnergy() );
     }
     *fTNGenJets = jqi+1;
+    fGenMatcher.fillJets(*fTGenJetPt, *fTGenJetEta, *fTGenJetPhi);
   }
 
+  return true;
+}
+
+//________________________________________________________________________________________
+// Muons
+bool NTupleProducer::fillMuons(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+  using namespace edm;
+  using namespace std;
+  using reco::MuonCollection;
+
+  Handle<View<Muon> > muons;
+  fCollections.getByLabel(fMuonTag,muons); // 'muons'
+  edm::Handle<double> rho;
+  fCollections.getByLabel(fSrcRho,rho);
+  edm::Handle<reco::PFCandidateCollection> pfCandidates;
+  fCollections.getByLabel(pfProducerTag, pfCandidates);
+  Handle< edm::ValueMap<float> > muonPfIsoTagsCustom[gMaxNPfIsoTags];
+  size_t ipfisotag = 0;
+  for ( std::vector<edm::InputTag>::const_iterator it=fMuonPfIsoTagsCustom.begin(); 
+        it!=fMuonPfIsoTagsCustom.end(); ++it ) 
+    fCollections.getByLabel((*it),muonPfIsoTagsCustom[ipfisotag++]);
+  // Get beamspot for d0 determination
+  BeamSpot beamSpot;
+  Handle<BeamSpot> beamSpotHandle;
+  fCollections.getByLabel("offlineBeamSpot", beamSpotHandle);
+  beamSpot = *beamSpotHandle;
+  edm::Handle<VertexCollection> vertices;
+  fCollections.getByLabel(fVertexTag, vertices);
+  const reco::Vertex *primVtx = (vertices->size()>0) ? &(*(vertices.product()))[0] : NULL; // Just take first vertex ...
+  edm::Handle<edm::ValueMap<reco::IsoDeposit> > IsoDepECValueMap;
+  fCollections.getByLabel(fMuIsoDepECTag, IsoDepECValueMap);
+  const edm::ValueMap<reco::IsoDeposit> &ECDepMap = *IsoDepECValueMap.product();
+  edm::Handle<edm::ValueMap<reco::IsoDeposit> > IsoDepHCValueMap;
+  fCollections.getByLabel(fMuIsoDepHCTag, IsoDepHCValueMap);
+  const edm::ValueMap<reco::IsoDeposit> &HCDepMap = *IsoDepHCValueMap.product();
+  IndexByPt indexComparator; // Need this to sort collections
+
   ////////////////////////////////////////////////////////
   // Muon Variables:
   int mqi(0);  // Index of qualified muons
@@ -1350,7 +1554,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
       edm::LogWarning("NTP") << "@SUB=analyze()"
                              << "Maximum number of muons exceeded";
       *fTMaxMuExceed = 1;
-      *fTGoodEvent = 1;
+      flagBadEvent();
       break;
     }
     // Muon preselection:
@@ -1466,7 +1670,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     fTMuEhad->push_back( HCDep.candEnergy() );
 
     // 3D impact parameter
-    TransientTrack mutt = theB->build( muon.innerTrack() );
+    TransientTrack mutt = fTransientTracks.get( muon.innerTrack() );
     
     if (primVtx){
       Measurement1D muip3dpv = IPTools::absoluteImpactParameter3D(mutt, *(primVtx)).second;      
@@ -1529,272 +1733,289 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     // MC Matching
     // FIXME: TO BE REMOVED ONCE WE ARE HAPPY WITH THE FULL GEN. INFO
     if(!fIsRealData){
-      std::vector<const GenParticle*> MuMatch = matchRecoCand(&muon, iEvent);
-      if(MuMatch[0] != NULL){
-        fTMuGenID->push_back( MuMatch[0]->pdgId() );
-        fTMuGenStatus->push_back( MuMatch[0]->status() );
-        fTMuGenPt->push_back( MuMatch[0]->pt() );
-        fTMuGenEta->push_back( MuMatch[0]->eta() );
-        fTMuGenPhi->push_back( MuMatch[0]->phi() );
-        fTMuGenE->push_back( MuMatch[0]->energy() );
-
-        fTMuGenMID->push_back( MuMatch[1]->pdgId() );
-        fTMuGenMStatus->push_back( MuMatch[1]->status() );
-        fTMuGenMPt->push_back( MuMatch[1]->pt() );
-        fTMuGenMEta->push_back( MuMatch[1]->eta() );
-        fTMuGenMPhi->push_back( MuMatch[1]->phi() );
-        fTMuGenME->push_back( MuMatch[1]->energy() );
-
-        fTMuGenGMID->push_back( MuMatch[2]->pdgId() );
-        fTMuGenGMStatus->push_back( MuMatch[2]->status() );
-        fTMuGenGMPt->push_back( MuMatch[2]->pt() );
-        fTMuGenGMEta->push_back( MuMatch[2]->eta() );
-        fTMuGenGMPhi->push_back( MuMatch[2]->phi() );
-        fTMuGenGME->push_back( MuMatch[2]->energy() );
-      }
-      MuMatch.clear();
+      GenMatcher::Match match = fGenMatcher.matchParticle(muon.pt(), muon.eta(), muon.phi());
+      const GenParticle& MuGen   = fGenMatcher.particle(match.particle);
+      const GenParticle& MuGenM  = fGenMatcher.particle(match.mother);
+      const GenParticle& MuGenGM = fGenMatcher.particle(match.grandMother);
+      fTMuGenID->push_back( MuGen.pdgId() );
+      fTMuGenStatus->push_back( MuGen.status() );
+      fTMuGenPt->push_back( MuGen.pt() );
+      fTMuGenEta->push_back( MuGen.eta() );
+      fTMuGenPhi->push_back( MuGen.phi() );
+      fTMuGenE->push_back( MuGen.energy() );
+
+      fTMuGenMID->push_back( MuGenM.pdgId() );
+      fTMuGenMStatus->push_back( MuGenM.status() );
+      fTMuGenMPt->push_back( MuGenM.pt() );
+      fTMuGenMEta->push_back( MuGenM.eta() );
+      fTMuGenMPhi->push_back( MuGenM.phi() );
+      fTMuGenME->push_back( MuGenM.energy() );
+
+      fTMuGenGMID->push_back( MuGenGM.pdgId() );
+      fTMuGenGMStatus->push_back( MuGenGM.status() );
+      fTMuGenGMPt->push_back( MuGenGM.pt() );
+      fTMuGenGMEta->push_back( MuGenGM.eta() );
+      fTMuGenGMPhi->push_back( MuGenGM.phi() );
+      fTMuGenGME->push_back( MuGenGM.energy() );
     }
     fTMuGood->push_back( 0 );
     fTMuIsIso->push_back( 1 );
   }
 
+  return true;
+}
 
-  (*fTNGoodSuperClusters)=0;
-  for (edm::View<reco::Candidate>::const_iterator sc = GoodSuperClusters->begin(); sc!=GoodSuperClusters->end(); ++sc){
+//________________________________________________________________________________________
+// Index of a supercluster among the stored ones, -1 if it is not one of them
+int NTupleProducer::storedSCIndex(const reco::SuperClusterRef& sc) const {
+  if (sc.isNull()) return -1;
+  RefIndexMap::const_iterator it = fSCIndexByRef.find(refKey(sc.id(), sc.key()));
+  return it != fSCIndexByRef.end() ? it->second : -1;
+}
 
-    if (*fTNGoodSuperClusters>=gMaxNSC) {
-      edm::LogWarning("NTP") << "@SUB=analyze" << "Maximum number of Super Clusters exceeded";
-      *fTGoodEvent = 1;
-      break;
-    }
+//________________________________________________________________________________________
+// Preselected superclusters of the barrel or the endcap, with their corrections and
+// crystals; stored by fillSuperClusters, after the two subdetectors are done
+template <int Subdet>
+bool NTupleProducer::fillSuperClusterInfos(edm::Event& iEvent, const edm::EventSetup& iSetup) {
 
-    fTGoodSCEnergy->push_back(sc->energy());
-    fTGoodSCEta->push_back(sc->eta());
-    fTGoodSCPhi->push_back(sc->phi());
-    (*fTNGoodSuperClusters)++;
-  }
+  using namespace edm;
+  using namespace std;
 
+  const bool isEB = (Subdet == EcalBarrel);
+  Handle<SuperClusterCollection> superClusters;
+  fCollections.getByLabel(isEB ? fSCTagBarrel : fSCTagEndcap, superClusters);
+  edm::Handle<EcalRecHitCollection> recHits;
+  fCollections.getByLabel(isEB ? fEBRecHitsTag : fEERecHitsTag, recHits);
+  const CaloTopology *topology = fCaloTopology.product();
 
-  // SC variables
-  (*fTNSuperClusters)=0;
-  std::vector<DetId> cristalli_tokeep;
-  for (SuperClusterCollection::const_iterator sc = BarrelSuperClusters->begin(); sc!=BarrelSuperClusters->end(); ++sc){
+  std::vector<SuperClusterInfo>& infos = fSCInfos[isEB ? 0 : 1];
+  std::vector<DetId>& xtals = fSCXtals[isEB ? 0 : 1];
+  infos.clear();
+  xtals.clear();
+  for (SuperClusterCollection::const_iterator sc = superClusters->begin(); sc!=superClusters->end(); ++sc){
 
     if (sc->rawEnergy()<fMinSCraw) continue;
     if (sc->rawEnergy()/TMath::CosH(sc->eta())<fMinSCrawPt) continue;
 
-    if (*fTNSuperClusters>=gMaxNSC) {
-      edm::LogWarning("NTP") << "@SUB=analyze" << "Maximum number of Super Clusters exceeded"; 
-      *fTGoodEvent = 1; 
-      break;
-    }
+    SuperClusterInfo info;
+    info.ref      = refKey(superClusters.id(), sc - superClusters->begin());
+    info.x        = sc->x();
+    info.y        = sc->y();
+    info.z        = sc->z();
+    info.raw      = sc->rawEnergy();
+    info.pre      = sc->preshowerEnergy();
+    info.energy   = sc->energy();
+    info.eta      = sc->eta();
+    info.phi      = sc->phi();
+    info.phiWidth = sc->phiWidth();
+    info.etaWidth = sc->etaWidth();
+    info.brem     = (sc->etaWidth()!=0) ? sc->phiWidth()/sc->etaWidth() : -1;
+    info.r9       = sc->rawEnergy()!=0 ? EcalClusterTools::e3x3(  *(sc->seed()), recHits.product(), &(*topology)) / sc->rawEnergy() : -1;
+
+    float crackcorrseedenergy = sc->rawEnergy();
+    float localcorrseedenergy = sc->rawEnergy();
+    float crackcorrenergy = sc->rawEnergy();
+    float localcorrenergy = sc->rawEnergy();
+    info.hasSeed = false;
+    info.xtalBegin = xtals.size();
+    for(reco::CaloCluster_iterator itClus = sc->clustersBegin(); itClus != sc->clustersEnd(); ++itClus) {
+      const reco::CaloClusterPtr cc = *itClus;
+      float crackcorrfactor = CrackCorrFunc->getValue(*cc);
+      float localcorrfactor = LocalCorrFunc->getValue(*cc);
+      if (&(**itClus)==&(*sc->seed())){
+        crackcorrseedenergy += (*itClus)->energy()*(crackcorrfactor-1);
+        localcorrseedenergy += (*itClus)->energy()*(localcorrfactor-1);
+        info.hasSeed = true;
+        info.crackcorrseedfactor = crackcorrfactor;
+        info.localcorrseedfactor = localcorrfactor;
+      }
+      crackcorrenergy += (*itClus)->energy()*(crackcorrfactor-1);
+      localcorrenergy += (*itClus)->energy()*(localcorrfactor-1);
 
-    fTSCX->push_back(sc->x());
-    fTSCY->push_back(sc->y());
-    fTSCZ->push_back(sc->z());
-    fTSCRaw->push_back(sc->rawEnergy());
-    fTSCPre->push_back(sc->preshowerEnergy());
-    fTSCEnergy->push_back(sc->energy());
-    fTSCEta->push_back(sc->eta());
-    fTSCPhi->push_back(sc->phi());
-    fTSCPhiWidth->push_back(sc->phiWidth());
-    fTSCEtaWidth->push_back(sc->etaWidth());
-    fTSCBrem->push_back((sc->etaWidth()!=0) ? sc->phiWidth()/sc->etaWidth() : -1);
-    fTSCR9->push_back(sc->rawEnergy()!=0 ? EcalClusterTools::e3x3(  *(sc->seed()), ebRecHits.product(), &(*topology)) / sc->rawEnergy() : -1);
-    {
-      float crackcorrseedenergy = sc->rawEnergy();
-      float localcorrseedenergy = sc->rawEnergy();
-      float crackcorrenergy = sc->rawEnergy();
-      float localcorrenergy = sc->rawEnergy();
-      int index=0;
-      for(reco::CaloCluster_iterator itClus = sc->clustersBegin(); itClus != sc->clustersEnd(); ++itClus) {
-        const reco::CaloClusterPtr cc = *itClus;
-        if (&(**itClus)==&(*sc->seed())){
-          crackcorrseedenergy += (*itClus)->energy()*(CrackCorrFunc->getValue(*cc)-1);
-          localcorrseedenergy += (*itClus)->energy()*(LocalCorrFunc->getValue(*cc)-1);
-          fTSCcrackcorrseedfactor->push_back(CrackCorrFunc->getValue(*cc));
-          fTSClocalcorrseedfactor->push_back(LocalCorrFunc->getValue(*cc));		
-        }
-        crackcorrenergy += (*itClus)->energy()*(CrackCorrFunc->getValue(*cc)-1);
-        localcorrenergy += (*itClus)->energy()*(LocalCorrFunc->getValue(*cc)-1);
-        index++;
+      if (doPhotonStuff) {
+        const std::vector< std::pair<DetId, float> > & seedrechits = (*itClus)->hitsAndFractions();
+        for (uint i=0; i<seedrechits.size(); i++) xtals.push_back(seedrechits[i].first);
       }
-      fTSCcrackcorrseed->push_back(crackcorrseedenergy/sc->rawEnergy());
-      fTSCcrackcorr->push_back(crackcorrenergy/sc->rawEnergy());
-      fTSClocalcorrseed->push_back(localcorrseedenergy/sc->rawEnergy());
-      fTSClocalcorr->push_back(localcorrenergy/sc->rawEnergy());
     }
-
-    if (doPhotonStuff) {
-      std::vector<DetId> cristalli;
-      for (reco::CaloCluster_iterator bc=sc->clustersBegin(); bc!=sc->clustersEnd(); ++bc){
-	const std::vector< std::pair<DetId, float> > & seedrechits = (*bc)->hitsAndFractions();
-	for (uint i=0; i<seedrechits.size(); i++) cristalli.push_back(seedrechits[i].first);
-	sort(cristalli.begin(),cristalli.end());
-	std::vector<DetId>::iterator it;
-	it = unique(cristalli.begin(),cristalli.end());
-	cristalli.resize(it-cristalli.begin());
+    info.crackcorrseed = crackcorrseedenergy/sc->rawEnergy();
+    info.crackcorr     = crackcorrenergy/sc->rawEnergy();
+    info.localcorrseed = localcorrseedenergy/sc->rawEnergy();
+    info.localcorr     = localcorrenergy/sc->rawEnergy();
+
+    // Crystals of all the basic clusters, once each, of this subdetector only
+    std::vector<DetId>::iterator first = xtals.begin()+info.xtalBegin;
+    sort(first, xtals.end());
+    xtals.erase(unique(first, xtals.end()), xtals.end());
+    std::vector<DetId>::iterator last = xtals.end();
+    for (std::vector<DetId>::iterator it = first; it != xtals.end(); ++it) {
+      if (it->subdetId()!=Subdet) {
+        edm::LogWarning("NTP") << "@SUB=analyze" << "Problem with xtals subdetId()";
+        continue;
       }
+      *first++ = *it;
+    }
+    xtals.erase(first, last);
+    info.xtalEnd = xtals.size();
 
-      fTSCXtalListStart->push_back(cristalli_tokeep.size());
+    infos.push_back(info);
+  }
 
-      int added=0;      
-      for (unsigned int i=0; i<cristalli.size(); i++){
+  return true;
+}
 
-	if (cristalli.at(i).subdetId()!=EcalBarrel) {
-	  edm::LogWarning("NTP") << "@SUB=analyze" << "Problem with xtals subdetId()";
-	  continue;
-	}
+//________________________________________________________________________________________
+// Superclusters and the crystals of the stored ones
+bool NTupleProducer::fillSuperClusters(edm::Event& iEvent, const edm::EventSetup& iSetup) {
 
-	cristalli_tokeep.push_back(cristalli.at(i));	
-	added++;
+  using namespace edm;
+  using namespace std;
 
-      }
+  Handle<edm::View<reco::Candidate> > GoodSuperClusters;
+  fCollections.getByLabel("goodSuperClustersClean", GoodSuperClusters);
+  const edm::ESHandle<CaloGeometry>& geometry = fCaloGeometry;
+  const CaloSubdetectorGeometry *barrelGeometry = geometry->getSubdetectorGeometry(DetId::Ecal, EcalBarrel);
+  const CaloSubdetectorGeometry *endcapGeometry = geometry->getSubdetectorGeometry(DetId::Ecal, EcalEndcap);
 
-      fTSCNXtals->push_back(added);
+  ////////////////////////////////////////////////////////
+  // Superclusters
+  (*fTNGoodSuperClusters)=0;
+  for (edm::View<reco::Candidate>::const_iterator sc = GoodSuperClusters->begin(); sc!=GoodSuperClusters->end(); ++sc){
 
+    if (*fTNGoodSuperClusters>=gMaxNSC) {
+      edm::LogWarning("NTP") << "@SUB=analyze" << "Maximum number of Super Clusters exceeded";
+      flagBadEvent();
+      break;
     }
 
-    (*fTNSuperClusters)++;
+    fTGoodSCEnergy->push_back(sc->energy());
+    fTGoodSCEta->push_back(sc->eta());
+    fTGoodSCPhi->push_back(sc->phi());
+    (*fTNGoodSuperClusters)++;
   }
 
-  for (SuperClusterCollection::const_iterator sc = EndcapSuperClusters->begin(); sc!=EndcapSuperClusters->end(); ++sc){
-
-    if (sc->rawEnergy()<fMinSCraw) continue;
-    if (sc->rawEnergy()/TMath::CosH(sc->eta())<fMinSCrawPt) continue;
 
-    if (*fTNSuperClusters>=gMaxNSC) {
-      edm::LogWarning("NTP") << "@SUB=analyze" << "Maximum number of Super Clusters exceeded"; 
-      *fTGoodEvent = 1; 
-      break;
-    }
+  // SC variables, barrel then endcap, as prepared by the SuperClustersEB/EE stages
+  (*fTNSuperClusters)=0;
+  std::vector<DetId> cristalli_tokeep;
+  for (int subdet=0; subdet<2; ++subdet) {
+    for (std::vector<SuperClusterInfo>::const_iterator sc = fSCInfos[subdet].begin(); sc!=fSCInfos[subdet].end(); ++sc){
 
-    fTSCX->push_back(sc->x());
-    fTSCY->push_back(sc->y());
-    fTSCZ->push_back(sc->z());
-    fTSCRaw->push_back(sc->rawEnergy());
-    fTSCPre->push_back(sc->preshowerEnergy());
-    fTSCEnergy->push_back(sc->energy());
-    fTSCEta->push_back(sc->eta());
-    fTSCPhi->push_back(sc->phi());
-    fTSCPhiWidth->push_back(sc->phiWidth());
-    fTSCEtaWidth->push_back(sc->etaWidth());
-    fTSCBrem->push_back((sc->etaWidth()!=0) ? sc->phiWidth()/sc->etaWidth() : -1);
-    fTSCR9->push_back(sc->rawEnergy()!=0 ? EcalClusterTools::e3x3(  *(sc->seed()), eeRecHits.product(), &(*topology)) / sc->rawEnergy() : -1);
-    {
-      float crackcorrseedenergy = sc->rawEnergy();
-      float localcorrseedenergy = sc->rawEnergy();
-      float crackcorrenergy = sc->rawEnergy();
-      float localcorrenergy = sc->rawEnergy();
-      int index=0;
-      for(reco::CaloCluster_iterator itClus = sc->clustersBegin(); itClus != sc->clustersEnd(); ++itClus) {
-        const reco::CaloClusterPtr cc = *itClus;
-        if (&(**itClus)==&(*sc->seed())){
-          crackcorrseedenergy += (*itClus)->energy()*(CrackCorrFunc->getValue(*cc)-1);
-          localcorrseedenergy += (*itClus)->energy()*(LocalCorrFunc->getValue(*cc)-1);
-          fTSCcrackcorrseedfactor->push_back(CrackCorrFunc->getValue(*cc));
-          fTSClocalcorrseedfactor->push_back(LocalCorrFunc->getValue(*cc));		
-        }
-        crackcorrenergy += (*itClus)->energy()*(CrackCorrFunc->getValue(*cc)-1);
-        localcorrenergy += (*itClus)->energy()*(LocalCorrFunc->getValue(*cc)-1);
-        index++;
+      if (*fTNSuperClusters>=gMaxNSC) {
+        edm::LogWarning("NTP") << "@SUB=analyze" << "Maximum number of Super Clusters exceeded"; 
+        flagBadEvent(); 
+        break;
       }
-      fTSCcrackcorrseed->push_back(crackcorrseedenergy/sc->rawEnergy());
-      fTSCcrackcorr->push_back(crackcorrenergy/sc->rawEnergy());
-      fTSClocalcorrseed->push_back(localcorrseedenergy/sc->rawEnergy());
-      fTSClocalcorr->push_back(localcorrenergy/sc->rawEnergy());
-    }
 
-    if (doPhotonStuff) {
-      std::vector<DetId> cristalli;
-      for (reco::CaloCluster_iterator bc=sc->clustersBegin(); bc!=sc->clustersEnd(); ++bc){
-	const std::vector< std::pair<DetId, float> > & seedrechits = (*bc)->hitsAndFractions();
-	for (uint i=0; i<seedrechits.size(); i++) cristalli.push_back(seedrechits[i].first);
-	sort(cristalli.begin(),cristalli.end());
-	std::vector<DetId>::iterator it;
-	it = unique(cristalli.begin(),cristalli.end());
-	cristalli.resize(it-cristalli.begin());
+      fSCIndexByRef[sc->ref] = *fTNSuperClusters;
+      fTSCX->push_back(sc->x);
+      fTSCY->push_back(sc->y);
+      fTSCZ->push_back(sc->z);
+      fTSCRaw->push_back(sc->raw);
+      fTSCPre->push_back(sc->pre);
+      fTSCEnergy->push_back(sc->energy);
+      fTSCEta->push_back(sc->eta);
+      fTSCPhi->push_back(sc->phi);
+      fTSCPhiWidth->push_back(sc->phiWidth);
+      fTSCEtaWidth->push_back(sc->etaWidth);
+      fTSCBrem->push_back(sc->brem);
+      fTSCR9->push_back(sc->r9);
+      if (sc->hasSeed) {
+        fTSCcrackcorrseedfactor->push_back(sc->crackcorrseedfactor);
+        fTSClocalcorrseedfactor->push_back(sc->localcorrseedfactor);
       }
-      
-      fTSCXtalListStart->push_back(cristalli_tokeep.size());
-
-      int added=0;
-      for (unsigned int i=0; i<cristalli.size(); i++){
-
-	if (cristalli.at(i).subdetId()!=EcalEndcap) {
-	  edm::LogWarning("NTP") << "@SUB=analyze" << "Problem with xtals subdetId()";
-	  continue;
-	}
-
-	cristalli_tokeep.push_back(cristalli.at(i));	
-	added++;
-
+      fTSCcrackcorrseed->push_back(sc->crackcorrseed);
+      fTSCcrackcorr->push_back(sc->crackcorr);
+      fTSClocalcorrseed->push_back(sc->localcorrseed);
+      fTSClocalcorr->push_back(sc->localcorr);
+
+      if (doPhotonStuff) {
+        fTSCXtalListStart->push_back(cristalli_tokeep.size());
+        fTSCNXtals->push_back(sc->xtalEnd-sc->xtalBegin);
+        cristalli_tokeep.insert(cristalli_tokeep.end(), fSCXtals[subdet].begin()+sc->xtalBegin, fSCXtals[subdet].begin()+sc->xtalEnd);
       }
 
-      fTSCNXtals->push_back(added);
-
+      (*fTNSuperClusters)++;
     }
-
-    (*fTNSuperClusters)++;
+    // Consumed: a disabled SuperClustersEB/EE stage leaves nothing behind
+    fSCInfos[subdet].clear();
+    fSCXtals[subdet].clear();
   }
 
 
-  ////// Xtal position information
+  ////// Xtal position information, from the geometry cache of the run
 
   if (doPhotonStuff) {
   (*fTNXtals)=cristalli_tokeep.size();  
   for (unsigned int i=0; i<cristalli_tokeep.size(); i++){
-    bool isEB = (cristalli_tokeep.at(i).subdetId()==EcalBarrel);
-    CaloCellGeometry *cellGeometry = NULL;
-    TVector3 xtal_position;
-    TVector3 cell_corners[4];
-    float dphi;
-    float deta;
-    if (isEB){
-      EBDetId ebDetId  = cristalli_tokeep.at(i);
-      cellGeometry = (CaloCellGeometry*)(barrelGeometry->getGeometry(ebDetId));
-      xtal_position = TVector3(cellGeometry->getPosition().x(),cellGeometry->getPosition().y(),cellGeometry->getPosition().z());
-      dphi=(dynamic_cast<const EcalBarrelGeometry*>(barrelGeometry))->deltaPhi(ebDetId);
-      deta=(dynamic_cast<const EcalBarrelGeometry*>(barrelGeometry))->deltaEta(ebDetId);
-    }
-    else {
-      EEDetId eeDetId  = cristalli_tokeep.at(i);
-      cellGeometry = (CaloCellGeometry*)(endcapGeometry->getGeometry(eeDetId));
-      xtal_position = TVector3(cellGeometry->getPosition().x(),cellGeometry->getPosition().y(),cellGeometry->getPosition().z());
-      dphi=(dynamic_cast<const EcalEndcapGeometry*>(endcapGeometry))->deltaPhi(eeDetId);
-      deta=(dynamic_cast<const EcalEndcapGeometry*>(endcapGeometry))->deltaEta(eeDetId);
-    }
-    const CaloCellGeometry::CornersVec& cellCorners (cellGeometry->getCorners());
-    for (int k=0; k<4; k++) cell_corners[k] = TVector3((float)(cellCorners[k].x()),(float)(cellCorners[k].y()),(float)(cellCorners[k].z()));
-  
-    fTXtalX->push_back(xtal_position.x());
-    fTXtalY->push_back(xtal_position.y());
-    fTXtalZ->push_back(xtal_position.z());
-    fTXtalPhiWidth->push_back(dphi);
-    fTXtalEtaWidth->push_back(deta);
-    fTXtalFront1X->push_back(cell_corners[0].x());
-    fTXtalFront1Y->push_back(cell_corners[0].y());
-    fTXtalFront1Z->push_back(cell_corners[0].z());
-    fTXtalFront2X->push_back(cell_corners[1].x());
-    fTXtalFront2Y->push_back(cell_corners[1].y());
-    fTXtalFront2Z->push_back(cell_corners[1].z());
-    fTXtalFront3X->push_back(cell_corners[2].x());
-    fTXtalFront3Y->push_back(cell_corners[2].y());
-    fTXtalFront3Z->push_back(cell_corners[2].z());
-    fTXtalFront4X->push_back(cell_corners[3].x());
-    fTXtalFront4Y->push_back(cell_corners[3].y());
-    fTXtalFront4Z->push_back(cell_corners[3].z());
- 
+    const CrystalGeometryCache::Crystal& xtal = fXtalGeometry.crystal(fXtalGeometry.index(cristalli_tokeep.at(i), barrelGeometry, endcapGeometry));
+    fTXtalDetId->push_back(xtal.rawId);
+    if (fXtalGeometryPerRun) continue; // in the XtalGeometry table of the run
+
+    fTXtalX->push_back(xtal.x);
+    fTXtalY->push_back(xtal.y);
+    fTXtalZ->push_back(xtal.z);
+    fTXtalPhiWidth->push_back(xtal.phiWidth);
+    fTXtalEtaWidth->push_back(xtal.etaWidth);
+    fTXtalFront1X->push_back(xtal.front[0][0]);
+    fTXtalFront1Y->push_back(xtal.front[0][1]);
+    fTXtalFront1Z->push_back(xtal.front[0][2]);
+    fTXtalFront2X->push_back(xtal.front[1][0]);
+    fTXtalFront2Y->push_back(xtal.front[1][1]);
+    fTXtalFront2Z->push_back(xtal.front[1][2]);
+    fTXtalFront3X->push_back(xtal.front[2][0]);
+    fTXtalFront3Y->push_back(xtal.front[2][1]);
+    fTXtalFront3Z->push_back(xtal.front[2][2]);
+    fTXtalFront4X->push_back(xtal.front[3][0]);
+    fTXtalFront4Y->push_back(xtal.front[3][1]);
+    fTXtalFront4Z->push_back(xtal.front[3][2]);
   }
   }
-   
+
+  return true;
+}
+
+//________________________________________________________________________________________
+// Electrons
+bool NTupleProducer::fillElectrons(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+  using namespace edm;
+  using namespace std;
+
+  Handle<View<GsfElectron> > electrons;
+  fCollections.getByLabel(fElectronTag, electrons); // 'gsfElectrons'
+  Handle< edm::ValueMap<float> > elePfIsoTagsCustom[gMaxNPfIsoTags];
+  size_t ipfisotag = 0;
+  for ( std::vector<edm::InputTag>::const_iterator it=fElePfIsoTagsCustom.begin(); 
+        it!=fElePfIsoTagsCustom.end(); ++it ) 
+    fCollections.getByLabel((*it),elePfIsoTagsCustom[ipfisotag++]);
+  Handle< edm::ValueMap<double> > elePfIsoTagsEvent[gMaxNPfIsoTags];
+  ipfisotag = 0;
+  for ( std::vector<edm::InputTag>::const_iterator it=fElePfIsoTagsEvent.begin(); 
+        it!=fElePfIsoTagsEvent.end(); ++it ) 
+    fCollections.getByLabel((*it),elePfIsoTagsEvent[ipfisotag++]);
+  // Get beamspot for d0 determination
+  BeamSpot beamSpot;
+  Handle<BeamSpot> beamSpotHandle;
+  fCollections.getByLabel("offlineBeamSpot", beamSpotHandle);
+  beamSpot = *beamSpotHandle;
+  edm::Handle<VertexCollection> vertices;
+  fCollections.getByLabel(fVertexTag, vertices);
+  const reco::Vertex *primVtx = (vertices->size()>0) ? &(*(vertices.product()))[0] : NULL; // Just take first vertex ...
+  edm::Handle<EcalRecHitCollection> ebRecHits;
+  fCollections.getByLabel(fEBRecHitsTag,ebRecHits);
+  edm::Handle<EcalRecHitCollection> eeRecHits;
+  fCollections.getByLabel(fEERecHitsTag,eeRecHits);
+  const CaloTopology *topology = fCaloTopology.product();
+  EcalClusterLazyTools &lazyTools = *fLazyTools;
+  const ESHandle<TransientTrackBuilder>& theB = fTheB;
+  IndexByPt indexComparator; // Need this to sort collections
 
   ////////////////////////////////////////////////////////
   // Electron variables:
   // Keep pointers to electron superCluster in original collections
   std::vector<const SuperCluster*> elecPtr;
   std::vector<const GsfTrack*> trckPtr;
-  std::vector<edm::Ptr<GsfElectron> > elPtrVector;
   int eqi(0);                    // Index of qualified electrons
   (*fTNElesTot) = electrons->size(); // Total number of electrons
 
@@ -1809,7 +2030,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
         edm::LogWarning("NTP") << "@SUB=analyze"
                                << "Maximum number of electrons exceeded..";
         *fTMaxElExceed = 1;
-        *fTGoodEvent = 1;
+        flagBadEvent();
         break;
       }
       // Electron preselection:
@@ -1870,7 +2091,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
       fTElNChi2                  ->push_back(electron.gsfTrack()->normalizedChi2());
 
       // 3D impact parameter
-      TransientTrack eltt = theB->build( electron.gsfTrack() );
+      TransientTrack eltt = fTransientTracks.get( electron.gsfTrack() );
 
       if (primVtx){
 	Measurement1D elip3dpv = IPTools::absoluteImpactParameter3D(eltt, *(primVtx)).second;
@@ -1988,9 +2209,10 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
       }
 
       {
-        fTElSCindex->push_back( -1 ); // Initialize
+        fTElSCindex->push_back( storedSCIndex(electron.superCluster()) );
+        bool stored = (*fTElSCindex)[eqi]>=0; // else the closest in raw energy
         float diff=1e+4;
-        for (int scind=0; scind<*fTNSuperClusters; scind++){
+        for (int scind=0; scind<*fTNSuperClusters && !stored; scind++){
 	  if (fabs((*fTSCEta)[scind]-electron.superCluster()->eta())>0.1) continue;
 	  if (fabs((*fTSCPhi)[scind]-electron.superCluster()->phi())>0.1) continue;
 	  if (fabs((*fTSCRaw)[scind]-electron.superCluster()->rawEnergy())<diff && fabs((*fTSCRaw)[scind]/electron.superCluster()->rawEnergy()-1)<0.5) {
@@ -2004,42 +2226,35 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
       // FIXME: TO BE REMOVED ONCE WE ARE HAPPY WITH THE FULL GEN. INFO
       // MC Matching
       if(!fIsRealData){
-        std::vector<const GenParticle*> ElMatch = matchRecoCand(&electron, iEvent);
-        if(ElMatch[0] != NULL){
-          fTElGenID       ->push_back(ElMatch[0]->pdgId());
-          fTElGenStatus   ->push_back(ElMatch[0]->status());
-          fTElGenPt       ->push_back(ElMatch[0]->pt());
-          fTElGenEta      ->push_back(ElMatch[0]->eta());
-          fTElGenPhi      ->push_back(ElMatch[0]->phi());
-          fTElGenE        ->push_back(ElMatch[0]->energy());
-
-          fTElGenMID      ->push_back(ElMatch[1]->pdgId());
-          fTElGenMStatus  ->push_back(ElMatch[1]->status());
-          fTElGenMPt      ->push_back(ElMatch[1]->pt());
-          fTElGenMEta     ->push_back(ElMatch[1]->eta());
-          fTElGenMPhi     ->push_back(ElMatch[1]->phi());
-          fTElGenME       ->push_back(ElMatch[1]->energy());
-
-          fTElGenGMID     ->push_back(ElMatch[2]->pdgId());
-          fTElGenGMStatus ->push_back(ElMatch[2]->status());
-          fTElGenGMPt     ->push_back(ElMatch[2]->pt());
-          fTElGenGMEta    ->push_back(ElMatch[2]->eta());
-          fTElGenGMPhi    ->push_back(ElMatch[2]->phi());
-          fTElGenGME      ->push_back(ElMatch[2]->energy());
-        }
-        ElMatch.clear();
+        GenMatcher::Match match = fGenMatcher.matchParticle(electron.pt(), electron.eta(), electron.phi());
+        const GenParticle& ElGen   = fGenMatcher.particle(match.particle);
+        const GenParticle& ElGenM  = fGenMatcher.particle(match.mother);
+        const GenParticle& ElGenGM = fGenMatcher.particle(match.grandMother);
+        fTElGenID       ->push_back(ElGen.pdgId());
+        fTElGenStatus   ->push_back(ElGen.status());
+        fTElGenPt       ->push_back(ElGen.pt());
+        fTElGenEta      ->push_back(ElGen.eta());
+        fTElGenPhi      ->push_back(ElGen.phi());
+        fTElGenE        ->push_back(ElGen.energy());
+
+        fTElGenMID      ->push_back(ElGenM.pdgId());
+        fTElGenMStatus  ->push_back(ElGenM.status());
+        fTElGenMPt      ->push_back(ElGenM.pt());
+        fTElGenMEta     ->push_back(ElGenM.eta());
+        fTElGenMPhi     ->push_back(ElGenM.phi());
+        fTElGenME       ->push_back(ElGenM.energy());
+
+        fTElGenGMID     ->push_back(ElGenGM.pdgId());
+        fTElGenGMStatus ->push_back(ElGenGM.status());
+        fTElGenGMPt     ->push_back(ElGenGM.pt());
+        fTElGenGMEta    ->push_back(ElGenGM.eta());
+        fTElGenGMPhi    ->push_back(ElGenGM.phi());
+        fTElGenGME      ->push_back(ElGenGM.energy());
       }
 
 
       // Conversion Information
-      edm::Handle<reco::BeamSpot> beamspotHandle;
-      iEvent.getByLabel("offlineBeamSpot", beamspotHandle);
-      const reco::BeamSpot &beamspot = *beamspotHandle.product();
-      
-      edm::Handle<reco::ConversionCollection> hConversions;
-      iEvent.getByLabel("allConversions", hConversions);
-      
-      bool passconversionveto = !ConversionTools::hasMatchedConversion(electron,hConversions, beamspot.position());
+      bool passconversionveto = !hasMatchedConversion(electron);
       fTElPassConversionVeto->push_back(passconversionveto);
         
       reco::GsfElectron::ConversionRejection ConvRejVars = electron.conversionRejectionVariables();
@@ -2067,6 +2282,22 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     }
   }
 
+  return true;
+}
+
+//________________________________________________________________________________________
+// High-energy barrel rechits
+bool NTupleProducer::fillEBRechits(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+  using namespace edm;
+  using namespace std;
+
+  edm::Handle<EcalRecHitCollection> ebRecHits;
+  fCollections.getByLabel(fEBRecHitsTag,ebRecHits);
+  const edm::ESHandle<CaloGeometry>& geometry = fCaloGeometry;
+
+  ////////////////////////////////////////////////////////
+  // EB rechits
   (*fTNEBhits) = 0;
   for(EcalRecHitCollection::const_iterator ecalrechit = ebRecHits->begin(); ecalrechit!=ebRecHits->end() ; ++ecalrechit)
     {
@@ -2075,7 +2306,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
       if((*fTNEBhits)>=gMaxNEBhits)
         {
           edm::LogWarning("NTP") << "@SUB=analyze" << "Maximum number of EB rechits exceeded"; 
-          *fTGoodEvent = 1; 
+          flagBadEvent(); 
           break;
         }
 
@@ -2102,6 +2333,34 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
       (*fTNEBhits)++;
     }
 
+  return true;
+}
+
+//________________________________________________________________________________________
+// Photons, with their PF isolation and PF candidate footprint
+bool NTupleProducer::fillPhotons(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+  using namespace edm;
+  using namespace std;
+
+  Handle<View<Photon> > photons;
+  fCollections.getByLabel(fPhotonTag, photons);
+  edm::Handle<reco::PFCandidateCollection> pfCandidates;
+  fCollections.getByLabel(pfProducerTag, pfCandidates);
+  const PFCandidateCollection &thePfColl = *(pfCandidates.product());
+  edm::Handle<reco::GsfElectronCollection> electronHandle;
+  fCollections.getByLabel(fElectronTag, electronHandle);
+  edm::Handle<VertexCollection> vertices;
+  fCollections.getByLabel(fVertexTag, vertices);
+  edm::Handle<EcalRecHitCollection> ebRecHits;
+  fCollections.getByLabel(fEBRecHitsTag,ebRecHits);
+  edm::Handle<EcalRecHitCollection> eeRecHits;
+  fCollections.getByLabel(fEERecHitsTag,eeRecHits);
+  const CaloTopology *topology = fCaloTopology.product();
+  EcalClusterLazyTools &lazyTools = *fLazyTools;
+  Handle<double> hRhoRegr;
+  fCollections.getByLabel(edm::InputTag("kt6PFJets","rho"), hRhoRegr); 
+  IndexByPt indexComparator; // Need this to sort collections
 
   ////////////////////////////////////////////////////////
   // Photon Variables:
@@ -2122,7 +2381,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
       edm::LogWarning("NTP") << "@SUB=analyze"
                              << "Maximum number of photons exceeded";
       *fTMaxPhotonsExceed = 1;
-      *fTGoodEvent = 1;
+      flagBadEvent();
       break;
     }
     // Preselection
@@ -2136,13 +2395,13 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
   (*fTNPhotons) = phoOrdered.size();
   phoqi = 0;
 
-  std::vector<bool> storethispfcand(pfCandidates->size(),false);
-  std::vector<int> PhotonToPFPhotonMatchingArray(gMaxNPhotons,-999);
-  std::vector<int> PhotonToPFPhotonMatchingArrayTranslator(gMaxNPhotons,-999);
-  std::vector<int> PhotonToPFElectronMatchingArray(gMaxNPhotons,-999);
-  std::vector<int> PhotonToPFElectronMatchingArrayTranslator(gMaxNPhotons,-999);
-  std::vector<std::vector<int> > list_pfcand_footprint(gMaxNPhotons,std::vector<int>());
-  std::vector<std::vector<int> > list_pfcand_footprintTranslator(gMaxNPhotons,std::vector<int>());
+  // Photon ID MVA inputs of all photons and vertices, EB [0] and EE [1],
+  // filled and evaluated after the photon loop
+  for (int i=0; i<2; i++) {
+    fPhotonIDRows[i].clear();
+    fPhotonIDSlots[i].clear();
+  }
+
 
   for (std::vector<OrderPair>::const_iterator it = phoOrdered.begin();
        it != phoOrdered.end(); ++it, ++phoqi ) {
@@ -2192,6 +2451,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
       ecor=-999;
       sigeovere=-999;
       sigma=-999;
+      EventCollectionCache::Lock lock(&fCollections); // regression reads the event setup
       if (regrVersion==8) corSemiParm.CorrectedEnergyWithErrorV8(photon, *(vertices.product()), *hRhoRegr, lazyTools, iSetup, ecor, sigeovere, mean, sigma, alpha1, n1, alpha2, n2, pdfval);
       else if (regrVersion==5) corSemiParm.CorrectedEnergyWithErrorV5(photon, *(vertices.product()), *hRhoRegr, lazyTools, iSetup, ecor, sigma, alpha1, n1, alpha2, n2, pdfval);
 
@@ -2204,14 +2464,8 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
   the following lines are from:
   https://twiki.cern.ch/twiki/bin/view/CMS/HoverE2012
 */
-    edm::Handle<reco::BeamSpot> beamspotHandle;
-    iEvent.getByLabel("offlineBeamSpot", beamspotHandle);
-    const reco::BeamSpot &beamspot = *beamspotHandle.product();
-
-    edm::Handle<reco::ConversionCollection> hConversions;
-    iEvent.getByLabel("allConversions", hConversions);
-
-    bool passed_PhotonVeto = !ConversionTools::hasMatchedPromptElectron(photon.superCluster(), electronHandle, hConversions, beamspot.position());
+    bool passed_PhotonVeto = photon.superCluster().isNull() ||
+      fPromptElectronBySC.find(refKey(photon.superCluster().id(), photon.superCluster().key())) == fPromptElectronBySC.end();
     fTPhoPassConversionVeto->push_back(passed_PhotonVeto);
 
     if (vertices->size()>0){
@@ -2231,6 +2485,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     //  for(VertexCollection::const_iterator vertexit = vertices->begin(); vertexit != vertices->end(); ++vertexit) {
   	 for(unsigned int it = 0; it < vertices->size(); ++it) {   
    	//MQ write out isolation for each vertex, store it in photon object
+	  EventCollectionCache::Lock lock(&fCollections); // footprint removal reads the event
 	  edm::ParameterSet vtxiConfig = edm::ParameterSet();
 	  vtxiConfig.insert(true,"tag_jets",edm::Entry("tag_jets",edm::InputTag("ak5PFJetsCorrected"),false));
       SuperClusterFootprintRemoval SCFRforallvtx(iEvent,iSetup,vtxiConfig); 
@@ -2246,6 +2501,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     float PhoHCalIso2012ConeDR03 = photon.hcalTowerSumEtConeDR03() + (photon.hadronicOverEm() - photon.hadTowOverEm())*photon.superCluster()->energy()/cosh(photon.superCluster()->eta());
     fTPhoHCalIso2012ConeDR03->push_back(PhoHCalIso2012ConeDR03);
     {
+      EventCollectionCache::Lock lock(&fCollections); // footprint removal reads the event
       edm::ParameterSet myiConfig = edm::ParameterSet();
       myiConfig.insert(true,"tag_jets",edm::Entry("tag_jets",edm::InputTag("ak5PFJetsCorrected"),false));
       SuperClusterFootprintRemoval remover(iEvent,iSetup,myiConfig);
@@ -2345,28 +2601,16 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
 
     if (!fIsRealData){
 
-      edm::Handle<GenParticleCollection> gen;
-      iEvent.getByLabel(fGenPartTag, gen);
-      GenParticleCollection::const_iterator g_part;
-      std::vector<const reco::GenParticle*> matched = matchRecoCand(&photon,iEvent);
-      if (matched[0]==NULL) {
-        fTPhoMCmatchexitcode->push_back(-1);
-        fTPhoMCmatchindex->push_back(-999);
-      }
-      else if (matched[0]->pdgId()!=22) {
+      int genIndex = fGenMatcher.matchParticle(photon.pt(), photon.eta(), photon.phi()).particle;
+      const reco::GenParticle& matched = fGenMatcher.particle(genIndex);
+      if (matched.pdgId()!=22) { // also when nothing matched
         fTPhoMCmatchexitcode->push_back(0);
         fTPhoMCmatchindex->push_back(-999);
       }
       else {
         fTPhoMCmatchexitcode->push_back(-999);
-        fTPhoMCmatchindex->push_back(-999);
-        for(int i=0; i<*fTNGenPhotons; ++i){
-          if ( (fabs((*fTGenPhotonPt)[i]-matched[0]->pt())<0.01*matched[0]->pt()) 
-               && (fabs((*fTGenPhotonEta)[i]-matched[0]->eta())<0.01) 
-               && ( fabs(reco::deltaPhi((*fTGenPhotonPhi)[i],matched[0]->phi()))<0.01 ) ) {
-            (*fTPhoMCmatchindex)[phoqi] = i;
-          }
-        }
+        boost::unordered_map<int, int>::const_iterator it = fGenPhotonByIndex.find(genIndex);
+        fTPhoMCmatchindex->push_back(it != fGenPhotonByIndex.end() ? it->second : -999);
 
         if ((*fTPhoMCmatchindex)[phoqi] != -999) {
           if ( (*fTGenPhotonMotherID)[(*fTPhoMCmatchindex)[phoqi]]>=-6 && (*fTGenPhotonMotherID)[(*fTPhoMCmatchindex)[phoqi]]<=6) (*fTPhoMCmatchexitcode)[phoqi]=1;
@@ -2380,9 +2624,10 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     }
 
     {
-      fTPhotSCindex ->push_back(-1); // Initialize
+      fTPhotSCindex ->push_back( storedSCIndex(photon.superCluster()) );
+      bool stored = (*fTPhotSCindex)[phoqi]>=0; // else the closest in raw energy
       float diff=1e+4;
-      for (int scind=0; scind<*fTNSuperClusters; scind++){
+      for (int scind=0; scind<*fTNSuperClusters && !stored; scind++){
         if (fabs((*fTSCRaw)[scind]-photon.superCluster()->rawEnergy())<diff) {
           (*fTPhotSCindex)[phoqi] = scind;
           diff=fabs((*fTSCRaw)[scind]-photon.superCluster()->rawEnergy());
@@ -2410,16 +2655,10 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
 
       //Find PFPhoton
       int iphot=-1;
-      int ncand=pfCandidates->size();
-      for( int i=0; i<ncand; ++i ) {
-        if ((*pfCandidates)[i].particleId()==reco::PFCandidate::gamma){
-          if ((*pfCandidates)[i].mva_nothing_gamma()>0){
-            if( (*pfCandidates)[i].superClusterRef()==photon.superCluster()) {
-              iphot = i;
-            }
-          }
-        }
-      }    
+      if (photon.superCluster().isNonnull()) {
+        RefIndexMap::const_iterator it = fPFGammaBySC.find(refKey(photon.superCluster().id(), photon.superCluster().key()));
+        if (it != fPFGammaBySC.end()) iphot = it->second;
+      }
 
       if (iphot!=-1) {
 	(*fTPhoisPFPhoton)[phoqi] = 1;
@@ -2441,12 +2680,8 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
       }
 
       if (foundEgSC){
-	double MVACut_ = -0.1; //42X                                                                                                                                                                                                                             
-	//double MVACut_ = -1.; //44X 
-	for( int i=0; i<ncand; ++i ) {
-	  if ((*pfCandidates)[i].particleId()==reco::PFCandidate::e && (*pfCandidates)[i].gsfTrackRef().isNull()==false && (*pfCandidates)[i].mva_e_pi()>MVACut_ && (*pfCandidates)[i].gsfTrackRef()==elPtrSl->gsfTrack())
-	    iel = i;
-	}
+        RefIndexMap::const_iterator it = fPFElectronByGsf.find(refKey(elPtrSl->gsfTrack().id(), elPtrSl->gsfTrack().key()));
+        if (it != fPFElectronByGsf.end()) iel = it->second;
       }
 
       if (iel!=-1) {
@@ -2463,13 +2698,23 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
       fTPhoCiCPFIsoPhotonDR03->push_back(pfEcalIsoCiC(phoqi,*pfCandidates,2,0.3,0.,0.070,0.015,0.,0.,0.));
       fTPhoCiCPFIsoNeutralDR04->push_back(pfEcalIsoCiC(phoqi,*pfCandidates,0,0.4,0.,0.,0.,0.,0.,0.));
       fTPhoCiCPFIsoPhotonDR04->push_back(pfEcalIsoCiC(phoqi,*pfCandidates,2,0.4,0.,0.070,0.015,0.,0.,0.));
-      for (int i=0; i<(*fTNVrtx); i++) {
-	fTPhoCiCPFIsoChargedDR03->push_back(pfTkIsoWithVertexCiC(phoqi,i,*pfCandidates,1,0.3,0.02,0.02,0.0,0.2,0.1));
-	fTPhoCiCPFIsoChargedDR04->push_back(pfTkIsoWithVertexCiC(phoqi,i,*pfCandidates,1,0.4,0.02,0.02,0.0,0.2,0.1));
-      }
     }
 
-    if (doPhotonStuff) { // Photon ID MVA
+  } // end photon loop
+
+  { // CiC charged isolation of all photons, for all vertices and both cones
+    const float chargedIsoCones[2] = {0.3, 0.4};
+    std::vector<float> chargedIso; // [photon][vertex][cone]
+    pfTkIsoWithVerticesCiC(*pfCandidates,1,2,chargedIsoCones,0.02,0.02,0.0,0.2,0.1,chargedIso);
+    for (size_t i=0; i<chargedIso.size(); i+=2) {
+      fTPhoCiCPFIsoChargedDR03->push_back(chargedIso[i]);
+      fTPhoCiCPFIsoChargedDR04->push_back(chargedIso[i+1]);
+    }
+  }
+
+  if (doPhotonStuff) { // Photon ID MVA of all photons and vertices
+
+    for (phoqi=0; phoqi<(*fTNPhotons); phoqi++) {
 
       photonIDMVA_variables.isrescaled = false;
 
@@ -2493,18 +2738,106 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
 
       rescaleClusterShapes(photonIDMVA_variables, fTPhoisEB->at(phoqi));
 
+      const int det = fTPhoisEB->at(phoqi) ? 0 : 1;
+      const float row[] = { photonIDMVA_variables.scrawe, photonIDMVA_variables.r9, photonIDMVA_variables.sieie,
+			    photonIDMVA_variables.etawidth, photonIDMVA_variables.phiwidth, photonIDMVA_variables.sieip,
+			    photonIDMVA_variables.s4ratio, photonIDMVA_variables.pfphotoniso03,
+			    0., // pfchargedisogood03, per vertex
+			    photonIDMVA_variables.pfchargedisobad03, photonIDMVA_variables.sceta,
+			    photonIDMVA_variables.eventrho, photonIDMVA_variables.ESEffSigmaRR };
+      const unsigned nVariables = det==0 ? fPhotonIDForestEB.nVariables() : fPhotonIDForestEE.nVariables();
       for (int ivtx=0; ivtx<*fTNVrtx; ivtx++){
-	photonIDMVA_variables.pfchargedisogood03=fTPhoCiCPFIsoChargedDR03->at(fTPhoVrtxListStart->at(phoqi)+ivtx);
-	fTPhoIDMVA->push_back((fTPhoisEB->at(phoqi)) ? photonIDMVA_reader_EB->EvaluateMVA("AdaBoost") : photonIDMVA_reader_EE->EvaluateMVA("AdaBoost"));
+	fPhotonIDSlots[det].push_back(fTPhoIDMVA->size());
+	fTPhoIDMVA->push_back(0.);
+	const size_t start = fPhotonIDRows[det].size();
+	fPhotonIDRows[det].insert(fPhotonIDRows[det].end(), row, row+nVariables);
+	fPhotonIDRows[det][start+8] = fTPhoCiCPFIsoChargedDR03->at(fTPhoVrtxListStart->at(phoqi)+ivtx);
       }
 
     }
 
+    for (int det=0; det<2; det++) {
+      if (fPhotonIDSlots[det].empty()) continue;
+      const FastForest& forest = det==0 ? fPhotonIDForestEB : fPhotonIDForestEE;
+      forest.evaluate(&fPhotonIDRows[det][0], fPhotonIDSlots[det].size(), fPhotonIDResponses);
+      for (size_t i=0; i<fPhotonIDSlots[det].size(); i++) (*fTPhoIDMVA)[fPhotonIDSlots[det][i]] = fPhotonIDResponses[i];
+    }
+  }
 
-  } // end photon loop
+  return true;
+}
+
+//________________________________________________________________________________________
+// Conversion veto lookups from one pass over the conversions and the electrons,
+// giving the same answers as ConversionTools::hasMatchedConversion and
+// hasMatchedPromptElectron with their default cuts; and the PF photons by
+// supercluster, for the single-leg conversions of the diphoton vertexing
+bool NTupleProducer::fillConversionVeto(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+  edm::Handle<reco::BeamSpot> beamspotHandle;
+  fCollections.getByLabel("offlineBeamSpot", beamspotHandle);
+  const reco::BeamSpot &beamspot = *beamspotHandle.product();
+  edm::Handle<reco::ConversionCollection> hConversions;
+  fCollections.getByLabel("allConversions", hConversions);
+  edm::Handle<reco::GsfElectronCollection> electronHandle;
+  fCollections.getByLabel(fElectronTag, electronHandle);
+
+  // Tracks of the conversions passing the quality cuts
+  const float lxyMin = 2.0, probMin = 1e-6;
+  const unsigned int nHitsBeforeVtxMax = 0;
+  for (size_t i=0; i<hConversions->size(); ++i) {
+    const reco::Conversion& conv = (*hConversions)[i];
+    if (!ConversionTools::isGoodConversion(conv, beamspot.position(), lxyMin, probMin, nHitsBeforeVtxMax)) continue;
+    const std::vector<edm::RefToBase<reco::Track> >& tracks = conv.tracks();
+    for (std::vector<edm::RefToBase<reco::Track> >::const_iterator tk = tracks.begin(); tk != tracks.end(); ++tk)
+      fConvTrackKeys[refKey(tk->id(), tk->key())] = i;
+  }
 
+  // Superclusters of the electrons with no expected inner hit and no conversion
+  for (size_t i=0; i<electronHandle->size(); ++i) {
+    const reco::GsfElectron& electron = (*electronHandle)[i];
+    if (electron.superCluster().isNull()) continue;
+    if (electron.gsfTrack()->trackerExpectedHitsInner().numberOfHits()>0) continue;
+    if (hasMatchedConversion(electron)) continue;
+    fPromptElectronBySC[refKey(electron.superCluster().id(), electron.superCluster().key())] = i;
+  }
 
-  
+  if (doPhotonStuff) {
+    edm::Handle<reco::PhotonCollection> pfPhotonHandle;
+    fCollections.getByLabel(pfphotonsProducerTag, pfPhotonHandle);
+    for (size_t i=0; i<pfPhotonHandle->size(); ++i) {
+      const reco::SuperClusterRef& sc = (*pfPhotonHandle)[i].superCluster();
+      if (sc.isNonnull()) fPFPhotonsBySC.push_back(std::make_pair(refKey(sc.id(), sc.key()), int(i)));
+    }
+    std::sort(fPFPhotonsBySC.begin(), fPFPhotonsBySC.end());
+  }
+
+  return true;
+}
+
+//________________________________________________________________________________________
+// A good conversion has the GSF track or the closest CTF track of the electron
+bool NTupleProducer::hasMatchedConversion(const reco::GsfElectron& electron) const {
+  if (electron.gsfTrack().isNonnull() &&
+      fConvTrackKeys.find(refKey(electron.gsfTrack().id(), electron.gsfTrack().key())) != fConvTrackKeys.end()) return true;
+  if (electron.closestCtfTrackRef().isNonnull() &&
+      fConvTrackKeys.find(refKey(electron.closestCtfTrackRef().id(), electron.closestCtfTrackRef().key())) != fConvTrackKeys.end()) return true;
+  return false;
+}
+
+//________________________________________________________________________________________
+// Vertex choice for the diphoton pairs
+bool NTupleProducer::fillDiphotonVertices(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+  using namespace edm;
+  using namespace std;
+
+  Handle<View<Photon> > photons;
+  fCollections.getByLabel(fPhotonTag, photons);
+  edm::Handle<reco::PhotonCollection> pfPhotonHandle;
+  fCollections.getByLabel(pfphotonsProducerTag,pfPhotonHandle);
+  edm::Handle<VertexCollection> vertices;
+  fCollections.getByLabel(fVertexTag, vertices);
 
   ///////////////////////////////////////////////////////
   // USAGE OF VERTEX CHOICE FOR DIPHOTON EVENTS:
@@ -2525,27 +2858,22 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     bool VTX_MVA_DEBUG = false;
     
     edm::Handle<reco::TrackCollection> tkH;
-    iEvent.getByLabel(fTrackCollForVertexing, tkH);
+    fCollections.getByLabel(fTrackCollForVertexing, tkH);
     
     edm::Handle<VertexCollection> vtxH = vertices;
     
-    std::vector<TVector3> vtxes;
-    std::vector<TVector3> tracks_p3;
-    std::vector<int> tkVtxId;
-    std::vector<float> tk_d0;
-    std::vector<float> tk_d0Err;
-    std::vector<float> tk_dz;
-    std::vector<float> tk_dzErr;
-    std::vector<float> tk_PtErr;
-    std::vector<bool> tk_ishighpurity;
-    std::vector<std::vector<unsigned short> > vtx_std_tkind;
-    std::vector<std::vector<float> > vtx_std_tkweight; // remember: [vertex][track]
-    std::vector<int> vtx_std_ntks;
+    ETHVertexArrays& vtxArrays = fVertexArrays;
+    vtxArrays.clear();
     
     
     { // tracks
       if (VTX_MVA_DEBUG)	   	   cout << "tracks begin" << endl;
-      std::vector<reco::TrackBaseRef>::const_iterator tk;
+
+      // Index of each track among those passing the track cut
+      std::vector<int> tkIndex(tkH->size(), -1);
+      int nSelTracks = 0;
+      for(reco::TrackCollection::size_type j = 0; j<tkH->size(); ++j)
+        if (!TrackCut(reco::TrackRef(tkH, j))) tkIndex[j] = nSelTracks++;
           
       for(unsigned int i=0; i<vtxH->size(); i++) {
 
@@ -2555,42 +2883,31 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
 	  
         if (VTX_MVA_DEBUG)	     	     cout << "vtx tracks " << vtx->tracksSize() << endl;
 	     
-        std::vector<unsigned short> temp;
-        std::vector<float> temp_float;
-
         if (vtx->tracksSize()>0){
-          for(tk=vtx->tracks_begin();tk!=vtx->tracks_end();++tk) {
-            if (VTX_MVA_DEBUG)		 		 cout << "processing vtx track (out of " << vtx->tracksSize() << ")" << endl;
-            int index = 0;
-            for(reco::TrackCollection::size_type j = 0; j<tkH->size(); ++j) {
-              if (VTX_MVA_DEBUG)		   		   std::cout << j << std::endl;
-              reco::TrackRef track(tkH, j);
-              if(TrackCut(track)) continue; 
-              if (&(**tk) == &(*track)) {
-                temp.push_back(index);
-                temp_float.push_back(vtx->trackWeight(track));
-                if (VTX_MVA_DEBUG)		     		     cout << "matching found index" << index << " weight " << vtx->trackWeight(track) << endl;
-                break;
-              }
-              index++;
-            }
+          for(TrackVertexTable::const_iterator tk = fTrackVertexTable.vertexBegin(i); tk != fTrackVertexTable.vertexEnd(i); ++tk) {
+            // only tracks of the vertexing collection which pass the track cut
+            if (fTrackVertexTable.productID(tk->collection) != tkH.id()) continue;
+            if (tk->key >= tkIndex.size() || tkIndex[tk->key] < 0) continue;
+            vtxArrays.vtxTkIndex.push_back(tkIndex[tk->key]);
+            vtxArrays.vtxTkWeight.push_back(tk->weight);
+            if (VTX_MVA_DEBUG)		     		     cout << "matching found index" << tkIndex[tk->key] << " weight " << tk->weight << endl;
           }
         }
         else {
           if (VTX_MVA_DEBUG)	       	       cout << "no vertex tracks found" << endl;
         }
 
-	vtxes.push_back(TVector3(vtx->x(),vtx->y(),vtx->z()));
-	vtx_std_ntks.push_back(temp.size());
-        vtx_std_tkind.push_back(temp);
-        vtx_std_tkweight.push_back(temp_float);
-        if (VTX_MVA_DEBUG)	     	     	     std::cout << "tracks: " <<  temp.size() << std::endl;
+        vtxArrays.vtxX.push_back(vtx->x());
+        vtxArrays.vtxY.push_back(vtx->y());
+        vtxArrays.vtxZ.push_back(vtx->z());
+        vtxArrays.vtxTkStart.push_back(vtxArrays.vtxTkIndex.size());
+        if (VTX_MVA_DEBUG)	     	     	     std::cout << "tracks: " <<  vtxArrays.vtxTkStart[i+1]-vtxArrays.vtxTkStart[i] << std::endl;
 
       }	  
 
       if (VTX_MVA_DEBUG){
         std::cout << "tkWeight is " << std::endl;
-        for (int a=0; a<(int)(vtx_std_tkind.size()); a++) std::cout << a << ":" << vtx_std_tkind.at(a).size() << " " ;
+        for (int a=0; a+1<(int)(vtxArrays.vtxTkStart.size()); a++) std::cout << a << ":" << vtxArrays.vtxTkStart[a+1]-vtxArrays.vtxTkStart[a] << " " ;
         std::cout << std::endl;
       }
 
@@ -2601,14 +2918,11 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
 
         if(TrackCut(tk))continue; 
 	
-	tracks_p3.push_back(TVector3(tk->px(),tk->py(),tk->pz()));
-        tk_d0.push_back(tk->d0());
-        tk_dz.push_back(tk->dz());
-        tk_dzErr.push_back(tk->dzError());
-        tk_d0Err.push_back(tk->d0Error());   
-        tk_PtErr.push_back(tk->ptError());
-        tk_ishighpurity.push_back(tkIsHighPurity(tk));
-        tkVtxId.push_back(-1); 
+        vtxArrays.tkPx.push_back(tk->px());
+        vtxArrays.tkPy.push_back(tk->py());
+        vtxArrays.tkPz.push_back(tk->pz());
+        vtxArrays.tkPtErr.push_back(tk->ptError());
+        vtxArrays.tkIsHighPurity.push_back(tkIsHighPurity(tk));
 	 
       } // for i (loop over all tracks)
 
@@ -2620,7 +2934,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     { // all conversions
 
       edm::Handle<reco::ConversionCollection> hConversions;
-      iEvent.getByLabel("allConversions", hConversions);
+      fCollections.getByLabel("allConversions", hConversions);
 
       for( reco::ConversionCollection::const_iterator  iConv = hConversions->begin(); iConv != hConversions->end(); iConv++) {
 
@@ -2631,7 +2945,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
 	if (*fTNconv >= gMaxNConv){
 	  edm::LogWarning("NTP") << "@SUB=analyze"
 				 << "Maximum number of conversions exceeded";
-	  *fTGoodEvent = 1;
+	  flagBadEvent();
 	  break;
 	}
 
@@ -2660,8 +2974,12 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
 
 
       for (edm::View<reco::Photon>::const_iterator  localPho=photons->begin(); localPho!=photons->end(); localPho++) {
-	for (std::vector<reco::Photon>::const_iterator  iPfCand=pfPhotonHandle->begin(); iPfCand!=pfPhotonHandle->end(); iPfCand++) {
-      if (localPho->superCluster()!=iPfCand->superCluster()) continue;
+	// the PF photons of the same supercluster, in collection order
+	const unsigned long long scKey = refKey(localPho->superCluster().id(), localPho->superCluster().key());
+	std::vector<std::pair<unsigned long long,int> >::const_iterator pfPho =
+	  std::lower_bound(fPFPhotonsBySC.begin(), fPFPhotonsBySC.end(), std::make_pair(scKey, -1));
+	for (; pfPho!=fPFPhotonsBySC.end() && pfPho->first==scKey; ++pfPho) {
+      const reco::Photon* iPfCand = &(*pfPhotonHandle)[pfPho->second];
       reco::ConversionRefVector convsingleleg = iPfCand->conversionsOneLeg();
       for (unsigned int iconvoneleg=0; iconvoneleg<convsingleleg.size(); iconvoneleg++){
       
@@ -2672,7 +2990,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
         if (*fTNconv >= gMaxNConv){
           edm::LogWarning("NTP") << "@SUB=analyze"
                                  << "Maximum number of conversions exceeded";
-				 *fTGoodEvent = 1;
+				 flagBadEvent();
           break;
         }
 
@@ -2712,7 +3030,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
 
     if (VTX_MVA_DEBUG)       cout << "done convs" << endl;
 
-    ETHVertexInfo vinfo(vtxes.size(),&vtxes,tracks_p3.size(),&tracks_p3,&tk_PtErr,&tkVtxId,&tk_d0,&tk_d0Err,&tk_dz,&tk_dzErr,&tk_ishighpurity,&vtx_std_tkind,&vtx_std_tkweight,&vtx_std_ntks);
+    ETHVertexInfo vinfo(vtxArrays);
     
     if (VTX_MVA_DEBUG)	 cout << "ready" << endl;	 
     
@@ -2725,15 +3043,22 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     }
     
     
-    for(unsigned int id=0; id<diphotons_first.size(); ++id ) {
+    // Photon infos and conversion matches once per photon, for the pairs that are
+    // stored (only the first gMax_vertexing_diphoton_pairs are)
+    const unsigned int nPairs = std::min<unsigned int>(diphotons_first.size(), gMax_vertexing_diphoton_pairs);
+    std::vector<PhotonInfo> photonInfos;
+    for (int ip=0; ip<(*fTNPhotons) && nPairs>0; ++ip)
+      photonInfos.push_back(fillPhotonInfos(ip,vtxAlgoParams.useAllConversions,(*fTPhoRegrEnergy)[ip]));
+
+    for(unsigned int id=0; id<nPairs; ++id ) {
     
     if (VTX_MVA_DEBUG)	     cout << "processing diphoton pair " << id << endl;
     
     int ipho1 = diphotons_first[id];
     int ipho2 = diphotons_second[id];
     
-    PhotonInfo pho1=fillPhotonInfos(ipho1,vtxAlgoParams.useAllConversions,(*fTPhoRegrEnergy)[ipho1]);
-    PhotonInfo pho2=fillPhotonInfos(ipho2,vtxAlgoParams.useAllConversions,(*fTPhoRegrEnergy)[ipho2]);
+    PhotonInfo pho1=photonInfos[ipho1];
+    PhotonInfo pho2=photonInfos[ipho2];
 
     if (VTX_MVA_DEBUG)	     cout << "filled photon/tuplevertex info" << endl;
     if (VTX_MVA_DEBUG)	     cout << vinfo.nvtx() << " vertices" << endl;
@@ -2780,7 +3105,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
 
     } // end diphoton loop
  
-    for (int i=0; i<(int)diphotons_first.size() && i<gMax_vertexing_diphoton_pairs; i++) { // write output of vertexing
+    for (int i=0; i<(int)nPairs; i++) { // write output of vertexing
       fTDiphotonsfirst->push_back(diphotons_first.at(i));
       fTDiphotonssecond->push_back(diphotons_second.at(i));
       fTVtxdiphomva->push_back(vtx_dipho_mva.at(i).at(0));
@@ -2794,46 +3119,79 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
 
   //       cout << "end vertex selection MVA" << endl;
 
+  return true;
+}
 
+//________________________________________________________________________________________
+// Jets of the main collection
+bool NTupleProducer::fillJets(edm::Event& iEvent, const edm::EventSetup& iSetup) {
 
-  std::vector<std::vector<int> > Jets_PfCand_content;
+  using namespace edm;
+  using namespace std;
+  using reco::JetTagCollection;
+
+  Handle<View<Jet> > jets;
+  fCollections.getByLabel(fJetTag,jets);
+  edm::Handle<double> rhoForQG;
+  if (doPhotonStuff) fCollections.getByLabel("kt6PFJetsForQGSyst","rho",rhoForQG);
+  edm::Handle<reco::GenParticleCollection> GlobalGenParticles;
+  if (!fIsRealData) fCollections.getByLabel(fGenPartTag, GlobalGenParticles);
+  size_t ibtag = 0;
+  // collect information for b-tagging (4 tags)
+  Handle<JetTagCollection> jetsBtag[gMaxNBtags];
+  for ( std::vector<edm::InputTag>::const_iterator it=fBtagTags.begin(); it!=fBtagTags.end(); ++it ) 
+    fCollections.getByLabel((*it),jetsBtag[ibtag++]);
+  FlavourMap flavours;
+  if(!fIsRealData){
+  // Get matching parton flavour for jets
+  edm::Handle<reco::JetFlavourMatchingCollection> jetMC;
+  fCollections.getByLabel(fPartonMatch, jetMC);
+  for (reco::JetFlavourMatchingCollection::const_iterator iter = jetMC->begin();
+       iter != jetMC->end(); iter++) {
+    int fl = iter->second.getFlavour();
+    //std::cout << "flavour " << fl << " ";
+    flavours.insert(FlavourMap::value_type(iter->first, fl));
+    }
+  }
+  Handle<TrackCollection> tracks;
+  fCollections.getByLabel(fTrackTag, tracks);
+  edm::Handle<reco::PFCandidateCollection> pfCandidates;
+  fCollections.getByLabel(pfProducerTag, pfCandidates);
+  edm::Handle<VertexCollection> vertices;
+  fCollections.getByLabel(fVertexTag, vertices);
+  edm::Handle<edm::ValueMap<float> >  QGTagsHandleMLP;
+  edm::Handle<edm::ValueMap<float> >  QGTagsHandleLikelihood;
+  if (doPhotonStuff){
+    fCollections.getByLabel("QGTagger","qgMLP", QGTagsHandleMLP);
+    fCollections.getByLabel("QGTagger","qgLikelihood", QGTagsHandleLikelihood);
+  }
 
   ////////////////////////////////////////////////////////
   // Jet Variables:
-  const JetCorrector* jetCorr = JetCorrector::getJetCorrector(fJetCorrs, iSetup);
-  std::vector<OrderPair> corrIndices;  // Vector of indices and pt of corr. jets to re-order them
-  int iraw(0);
+  const CorrectedJetCache::Jets& corrJets = fCorrectedJets.get(fJetTag, fJetCorrs); // shared with the jet fillers
   *fTNJetsTot = jets->size();
-  // Loop over uncorr. jets
-  for(View<Jet>::const_iterator Jit = jets->begin(); Jit != jets->end(); ++Jit, ++iraw){
-    // Cut on uncorrected pT (for startup)
-    if(Jit->pt() < fMinRawJPt) continue;
-    double scale = jetCorr->correction(*Jit,iEvent,iSetup);
-    corrIndices.push_back(make_pair(iraw, scale*Jit->pt()));
-  }
-	
-  // Sort corrected jet collection by decreasing pt
-  std::sort(corrIndices.begin(), corrIndices.end(), indexComparator);
 	
   // Determine corrected jets
   int jqi(-1); // counts # of qualified jets
-  // Loop over corr. jet indices
-  for(std::vector<OrderPair>::const_iterator it = corrIndices.begin(); 
-      it != corrIndices.end(); ++it ) {
+  // Loop over jet indices, by decreasing corrected pt
+  for(std::vector<unsigned>::const_iterator it = corrJets.order.begin(); 
+      it != corrJets.order.end(); ++it ) {
+    int index = *it;
+    // Cut on uncorrected pT (for startup)
+    if((*jets)[index].pt() < fMinRawJPt) continue;
     // Check if maximum number of jets is exceeded already
     if(jqi >= gMaxNJets-1) {
       edm::LogWarning("NTP") << "@SUB=analyze"
                              << "Maximum number of jets exceeded";
       *fTMaxJetExceed = 1;
-      *fTGoodEvent = 1;
+      flagBadEvent();
       break;
     }
-    int index = it->first;
     const PFJet* cojet = static_cast<const PFJet*>( &((*jets)[index]) ); // look away...
     std::auto_ptr<PFJet> jet(new PFJet(*cojet));
     
-    // The correction was calculated above: use it
-    double scale = it->second/jet->pt();
+    // The correction was calculated by the cache: use it
+    double scale = corrJets.scale[index];
     jet->scaleEnergy(scale);
 	
     // Jet preselection
@@ -2874,7 +3232,6 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     // see CMSSW/RecoJets/JetProducers/src/JetSpecific.cc
 
     vector<PFCandidatePtr> JetpfCandidates = jet->getPFConstituents();
-    Jets_PfCand_content.push_back(std::vector<int>());
 
     float sumPt_cands=0.;
     float sumPt2_cands=0.;
@@ -2896,8 +3253,11 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
 
       }
 
-      for (int j=0; j<(int)(pfCandidates->size()); j++){
-	if ((*jCand) == edm::Ptr<reco::PFCandidate>(pfCandidates,j)) Jets_PfCand_content.back().push_back(j);
+      // A Ptr into the PF candidate collection has the candidate index as key
+      if (jCand->id() == pfCandidates.id() && jCand->key() < pfCandidates->size()) {
+	int& candJet = PfCandToJetMatchingArray[jCand->key()];
+	if (candJet >= 0) cout << "WRONG: this PFCand is already in another jet!" << endl;
+	else candJet = jqi;
       }
 
     } //for PFCandidates
@@ -2957,40 +3317,21 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
       if ( vertices->size() == 0) continue;
       sumTrkPt += (*i_trk)->pt();
       
-      // check if track is associated to primary vertex
+      // check if track is associated to the primary vertex, or else to another good vertex
       bool isFirstVtx=false;
-      // loop over the tracks associated with the vertex
-      if (!((*vertices)[0].isFake()) && (*vertices)[0].ndof() >= 4 && fabs((*vertices)[0].z()) <= 24.) {
-        for(reco::Vertex::trackRef_iterator i_vtxTrk = (*vertices)[0].tracks_begin(); i_vtxTrk != (*vertices)[0].tracks_end(); ++i_vtxTrk) {
-          // match the jet track to the track from the vertex 
-          reco::TrackRef trkRef(i_vtxTrk->castTo<reco::TrackRef>());
-          // check if the tracks match
-          if (trkRef == (*i_trk)) {
-            isFirstVtx=true; 
-            // for the beta calculation. if the track is associated to the PV, cut on 0.5 cm of dz
-            if ((*i_trk)->dz((*vertices)[0].position()) < 0.5) sumTrkPtBetaSq += (*i_trk)->pt()*(*i_trk)->pt();
-            if ((*i_trk)->dz((*vertices)[0].position()) < 0.5) sumTrkPtBeta += (*i_trk)->pt();
-            break;
-          }
-        }
-      }
-      
-      // if not associated to primary vertex, check other vertices:
       bool isOtherVtx = false;
-      if (!isFirstVtx) {   
-        for(unsigned iotherVtx=1; iotherVtx<vertices->size();iotherVtx++) {
-          if (!((*vertices)[iotherVtx].isFake()) && (*vertices)[iotherVtx].ndof() >= 4 && fabs((*vertices)[iotherVtx].z()) <= 24.) {
-            for(reco::Vertex::trackRef_iterator i_vtxTrk = (*vertices)[iotherVtx].tracks_begin(); 
-                i_vtxTrk != (*vertices)[iotherVtx].tracks_end(); ++i_vtxTrk) {
-              reco::TrackRef trkRef(i_vtxTrk->castTo<reco::TrackRef>());
-              if (trkRef == (*i_trk) ) {
-                isOtherVtx=true;
-                break;
-              }
-            } // for tracks
-          } // if vtx is good
-        } // for other vertices
-      } // if !isFirstVt
+      std::pair<const TrackVertexTable::Entry* const*, const TrackVertexTable::Entry* const*> trkVtxs
+        = fTrackVertexTable.trackVertices(i_trk->id(), i_trk->key());
+      for (const TrackVertexTable::Entry* const* assoc = trkVtxs.first; assoc != trkVtxs.second; ++assoc) {
+        const reco::Vertex& vtx = (*vertices)[(*assoc)->vertex];
+        if (vtx.isFake() || vtx.ndof() < 4 || fabs(vtx.z()) > 24.) continue;
+        if ((*assoc)->vertex == 0) {
+          isFirstVtx=true; 
+          // for the beta calculation. if the track is associated to the PV, cut on 0.5 cm of dz
+          if ((*i_trk)->dz(vtx.position()) < 0.5) sumTrkPtBetaSq += (*i_trk)->pt()*(*i_trk)->pt();
+          if ((*i_trk)->dz(vtx.position()) < 0.5) sumTrkPtBeta += (*i_trk)->pt();
+        } else isOtherVtx = true;
+      }
 
       if(!isFirstVtx && isOtherVtx) { sumTrkPtBetaStar += (*i_trk)->pt(); } 
 
@@ -3011,8 +3352,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     float pT1(0.), pT2(0.), pT3(0.);
     int idx1(-1), idx2(-1), idx3(-1);
 			
-    // Jet-track association: make transient tracks and store information
-    std::vector<TransientTrack> AssociatedTTracks;
+    // Jet-track association: store information
     // Initialization
     fTJMass ->push_back(0.);
     fTJtrk1px->push_back(-999.99 );
@@ -3031,7 +3371,6 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
 
       // Loop over associated tracks:
       for(size_t t = 0; t < AssociatedTracks.size(); ++t){
-        AssociatedTTracks.push_back(theB->build(AssociatedTracks[t])); // build transient tracks for vertex fitting below
         if(AssociatedTracks[t]->normalizedChi2()<10. && AssociatedTracks[t]->numberOfValidHits()>10 && AssociatedTracks[t]->pt()>1.){
           pXtmp += AssociatedTracks[t]->px();
           pYtmp += AssociatedTracks[t]->py();
@@ -3078,7 +3417,10 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     }
 
     // Do a vertex fitting with the tracks
-    if(AssociatedTTracks.size() > 1) {
+    // (the transient tracks are only built for it, or taken from the leptons)
+    if(fabs(jet->eta())<2.9 && AssociatedTracks.size() > 1) {
+      std::vector<TransientTrack> AssociatedTTracks;
+      for(size_t t = 0; t < tracks.size(); ++t) AssociatedTTracks.push_back(fTransientTracks.get(tracks[t]));
       TransientVertex jetVtx = avFitter.vertex(AssociatedTTracks);
       if(jetVtx.isValid()){
         fTJVtxx     ->push_back(jetVtx.position().x());
@@ -3116,10 +3458,9 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
       fTJVtxNChi2 ->push_back(-888.88);
     }
     AssociatedTracks.clear();
-    AssociatedTTracks.clear();
 	
     // GenJet matching
-    if (!fIsRealData && (*fTNGenJets) > 0) fTJGenJetIndex->push_back( matchJet(&(*jet)) );
+    if (!fIsRealData && (*fTNGenJets) > 0) fTJGenJetIndex->push_back( fGenMatcher.matchJet(jet->pt(), jet->eta(), jet->phi()) );
     fTJGood->push_back( 0 );
 
     fTJVrtxListStart->push_back((fTJVrtxListStart->size()==0) ? 0 : fTJVrtxListStart->back()+(*fTNVrtx));
@@ -3194,14 +3535,34 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
 
   }
   (*fTNJets) = jqi+1;
-  corrIndices.clear();
 
+  return true;
+}
+
+//________________________________________________________________________________________
+// PF candidates in the photon footprints and jets
+bool NTupleProducer::fillPfCandidates(edm::Event& iEvent, const edm::EventSetup& iSetup) {
 
+  using namespace edm;
+  using namespace std;
 
+  edm::Handle<reco::PFCandidateCollection> pfCandidates;
+  fCollections.getByLabel(pfProducerTag, pfCandidates);
 
   ////////////////////////////////////////////////////////
   // PfCandidates Variables:
 
+  // Photons pointing at each PF candidate (matched PF photon or electron, footprint), by candidate
+  fPFCandPhotonLinks.clear();
+  for (int j=0; j<(*fTNPhotons) && doPhotonStuff; j++){
+    if (PhotonToPFPhotonMatchingArray[j]>=0)   addPFCandPhotonLink(PhotonToPFPhotonMatchingArray[j], j, kPFPhotonLink);
+    if (PhotonToPFElectronMatchingArray[j]>=0) addPFCandPhotonLink(PhotonToPFElectronMatchingArray[j], j, kPFElectronLink);
+    for (size_t k=0; k<list_pfcand_footprint.at(j).size(); k++)
+      addPFCandPhotonLink(list_pfcand_footprint.at(j).at(k), j, kFootprintLink);
+  }
+  std::sort(fPFCandPhotonLinks.begin(), fPFCandPhotonLinks.end());
+  std::vector<PFCandPhotonLink>::const_iterator link = fPFCandPhotonLinks.begin();
+
   int pfcandIndex(0);
   for (unsigned int i=0; i<pfCandidates->size() && doPhotonStuff; i++){
 
@@ -3210,26 +3571,12 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     int type = FindPFCandType((*pfCandidates)[i].pdgId());
     if (type==2) storethispfcand[i]=true;
 
-    for (int j=0; j<(*fTNPhotons); j++){
-      if (PhotonToPFPhotonMatchingArray[j]==(int)i) {
-	PhotonToPFPhotonMatchingArrayTranslator[j]=pfcandIndex;
-	storethispfcand[i]=true;
-      }
-    }
-    for (int j=0; j<(*fTNPhotons); j++){
-      if (PhotonToPFElectronMatchingArray[j]==(int)i) {
-	PhotonToPFElectronMatchingArrayTranslator[j]=pfcandIndex;
-	storethispfcand[i]=true;
-      }
-    }
-
-    for (int j=0; j<(*fTNPhotons); j++){
-      for (size_t k=0; k<list_pfcand_footprint.at(j).size(); k++){
-	if (list_pfcand_footprint.at(j).at(k)==(int)i){
-	  list_pfcand_footprintTranslator.at(j).push_back(pfcandIndex);
-	  storethispfcand[i]=true;
-	}
-      }
+    while (link != fPFCandPhotonLinks.end() && link->cand < (int)i) ++link;
+    for (; link != fPFCandPhotonLinks.end() && link->cand == (int)i; ++link) {
+      if (link->kind == kPFPhotonLink)   PhotonToPFPhotonMatchingArrayTranslator[link->photon]=pfcandIndex;
+      if (link->kind == kPFElectronLink) PhotonToPFElectronMatchingArrayTranslator[link->photon]=pfcandIndex;
+      if (link->kind == kFootprintLink)  list_pfcand_footprintTranslator.at(link->photon).push_back(pfcandIndex);
+      storethispfcand[i]=true;
     }
   
 
@@ -3238,7 +3585,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     if (pfcandIndex >= gMaxNPfCand){
       edm::LogWarning("NTP") << "@SUB=analyze"
 			     << "Maximum number of pf candidates exceeded";
-      *fTGoodEvent = 1;
+      flagBadEvent();
       break;
     }
 
@@ -3260,15 +3607,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
 //    fTPfCandTrackRefPy->push_back( (type==1) ? (*pfCandidates)[i].trackRef()->py() : -999 );
 //    fTPfCandTrackRefPz->push_back( (type==1) ? (*pfCandidates)[i].trackRef()->pz() : -999 );
 
-    fTPfCandBelongsToJet->push_back(-999);
-    for (int jet=0; jet<(int)(Jets_PfCand_content.size()); jet++){
-      for (int k=0; k<(int)(Jets_PfCand_content.at(jet).size()); k++){
-	if (Jets_PfCand_content.at(jet).at(k)==(int)i) {
-	  if (fTPfCandBelongsToJet->back()>=0) {cout << "WRONG: this PFCand is already in another jet!" << endl; continue;}
-	  fTPfCandBelongsToJet->back()=jet;
-	}
-      }
-    }
+    fTPfCandBelongsToJet->push_back(PfCandToJetMatchingArray[i]);
 
     pfcandIndex++;
 
@@ -3282,6 +3621,35 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     for (size_t k=0; k<list_pfcand_footprintTranslator.at(j).size(); k++) fTPhoFootprintPfCands->push_back(list_pfcand_footprintTranslator.at(j).at(k));
   }
 
+  return true;
+}
+
+//________________________________________________________________________________________
+// Tracks, calorimeter sums and MET
+bool NTupleProducer::fillMET(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+  using namespace edm;
+  using namespace std;
+
+  Handle<View<Jet> > jets;
+  fCollections.getByLabel(fJetTag,jets);
+  Handle<TrackCollection> tracks;
+  fCollections.getByLabel(fTrackTag, tracks);
+  Handle<CaloMETCollection> calomet;
+  fCollections.getByLabel(fRawCaloMETTag, calomet);
+  Handle<METCollection> tcmet;
+  fCollections.getByLabel(fTCMETTag, tcmet);
+  Handle<View<PFMET> > pfmet;
+  fCollections.getByLabel(fPFMETTag, pfmet);
+  Handle<CaloMETCollection> corrmujesmet;
+  fCollections.getByLabel(fCorrCaloMETTag, corrmujesmet);
+  edm::Handle<VertexCollection> vertices;
+  fCollections.getByLabel(fVertexTag, vertices);
+  const reco::Vertex *primVtx = (vertices->size()>0) ? &(*(vertices.product()))[0] : NULL; // Just take first vertex ...
+  edm::Handle<CaloTowerCollection> calotowers;
+  fCollections.getByLabel(fCalTowTag, calotowers);
+  int iraw(0);
+  double sigmaX2, sigmaY2, significance;
 
   if (!doPhotonStuff){
   ////////////////////////////////////////////////////////
@@ -3303,7 +3671,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
       edm::LogWarning("NTP") << "@SUB=analyze"
                              << "Maximum number of tracks exceeded";
       *fTMaxTrkExceed = 1;
-      *fTGoodEvent = 1;
+      flagBadEvent();
       break;
     }
     fTTrkPt    ->push_back(it->pt()*it->charge());
@@ -3373,7 +3741,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
 
   if (!fIsRealData) {
     Handle<View<GenMET> > GenMET;
-    iEvent.getByLabel(fGenMETTag, GenMET);
+    fCollections.getByLabel(fGenMETTag, GenMET);
     *fTGenMET    = (GenMET->front()).pt();
     *fTGenMETpx  = (GenMET->front()).px();
     *fTGenMETpy  = (GenMET->front()).py();
@@ -3436,6 +3804,16 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
   }
   }
 
+  return true;
+}
+
+//________________________________________________________________________________________
+// Model scan parameters
+bool NTupleProducer::fillModelScan(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+  using namespace edm;
+  using namespace std;
+
   ////////////////////////////////////////////////////////////////////////////////
   // Special stuff for Model Scans ///////////////////////////////////////////////
   *fTxSMS=-1;
@@ -3444,7 +3822,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
   if(!fIsRealData&&fIsModelScan && !fIsFastSim) {
     
     Handle<LHEEventProduct> product;
-    iEvent.getByLabel("source", product);
+    fCollections.getByLabel("source", product);
     LHEEventProduct::comments_const_iterator c_begin = product->comments_begin();
     LHEEventProduct::comments_const_iterator c_end = product->comments_end();
 
@@ -3526,140 +3904,133 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     *fTMassLSP = mLSP;
   }
 
+  return true;
+}
+
+//________________________________________________________________________________________
+// Full generator information
+bool NTupleProducer::fillGenParticles(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+  using namespace edm;
+  using namespace std;
 
   ////////////////////////////////////////////////////////////////////////////////
   // Full generator information ///////////////////////////////////////////////
   bool blabalot=false;
   if(!fIsRealData && !doPhotonStuff) {
-    static const size_t maxNGenLocal = 2000;
-    int genNIndex[maxNGenLocal];
-    int genID[maxNGenLocal];
-    float genPt[maxNGenLocal];
-    float genEta[maxNGenLocal];
-    float genPhi[maxNGenLocal];
-    float genM[maxNGenLocal];
-    int genMo1Index[maxNGenLocal];
-    int genMo2Index[maxNGenLocal];
-    int genNMo[maxNGenLocal];
-    int genStatus[maxNGenLocal];
-    int Promptness[maxNGenLocal];
-    bool StoreFlag[maxNGenLocal];
-
-    int nGenParticles=0;
-    
     Handle<GenParticleCollection> genParticles;
-    iEvent.getByLabel("genParticles", genParticles);
-	  
-    // STEP 1: Loop over all particles and store the information.
-    for(size_t i = 0; i < genParticles->size(); ++ i) {
-      if(i>=maxNGenLocal) {
-        edm::LogWarning("NTP") << "@SUB=analyze()"
-                               << "Maximum number of gen particles for local array exceeded";
-        break;
-      }
-      nGenParticles++;
+    fCollections.getByLabel("genParticles", genParticles);
+    const int nGenParticles = genParticles->size();
+
+    // Per-event buffers, indexed as the collection
+    fGenMo1Index.assign(nGenParticles, -1);
+    fGenMo2Index.assign(nGenParticles, -1);
+    fGenPromptness.assign(nGenParticles, -1);
+    fGenNIndex.assign(nGenParticles, -1);
+    fGenStoreFlag.assign(nGenParticles, false);
+
+    // STEP 1: Take the index of the mothers from their Refs into the collection
+    for(int i=0;i<nGenParticles;i++) {
       const GenParticle & p = (*genParticles)[i];
-      genNIndex[i]=0;
-      genID[i]=p.pdgId();
-      genPt[i]=p.pt();
-      genPhi[i]=p.phi();
-      genEta[i]=p.eta();
-      genM[i]=p.mass();
-      genStatus[i]=p.status();
-      genMo1Index[i]=-1;
-      genMo2Index[i]=-1;
-      genNMo[i]=p.numberOfMothers();
-      StoreFlag[i]=false;
-      if(genID[i]==2212 && p.numberOfMothers()==0) Promptness[i]=0;
-      else Promptness[i]=-1;
- 
+      if(blabalot) cout << "Reading particle " << i << " (is pdgid=" << p.pdgId() << ") with " << p.numberOfMothers() << " mothers" << endl;
+      for(unsigned j=0;j<p.numberOfMothers()&&j<2;j++) {
+        const reco::GenParticleRef mom = p.motherRef(j);
+        if (mom.isNull()) break;
+        int idx = (mom.id() == genParticles.id()) ? int(mom.key()) : -1;
+        if(j==0) fGenMo1Index[i]=idx;
+        if(j==1) fGenMo2Index[i]=idx;
+      }
+      if(blabalot) cout << "          Mother 1: " << fGenMo1Index[i] << ", Mother 2: " << fGenMo2Index[i] << endl;
+    }
 
-      if(blabalot) cout << "Reading particle " << i << " (is pdgid=" << genID[i] << ") with " << genNMo[i] << " mothers" << endl;
-      for(int j=0;j<genNMo[i]&&j<2;j++) {
-        int idx = -1;
-        const GenParticle* mom = static_cast<const GenParticle*> (p.mother(j));
-        const GenParticle* gmom = static_cast<const GenParticle*> (mom->mother());
-        if (mom == NULL) break;
-        for (unsigned int k = 0; k < genParticles->size() && k<i; ++k) {
-          const reco::GenParticle& testm = (*genParticles)[k];
-          const GenParticle* testgm = static_cast<const GenParticle*> (testm.mother());
-          if (testm.pt() == mom->pt()) {
-            if( gmom == NULL || ((testgm!=NULL) && (gmom->pt() == testgm->pt())) ) {
-              idx = k;
-              if(blabalot) cout << "     Found a hit for a mother for index " << i << "! It's index " << idx << " (pdgid " << genID[idx] << ")" << endl;
-              break;
-            }
-          }
+    // STEP 2: Order the particles with the mothers before their daughters. This is normally
+    // the collection order; a particle in a mother loop is placed when first reached again.
+    fGenOrder.clear();
+    fGenStack.clear();
+    fGenVisit.assign(nGenParticles, 0);
+    for(int i=0;i<nGenParticles;i++) {
+      if(fGenVisit[i]) continue;
+      fGenStack.push_back(i);
+      while(!fGenStack.empty()) {
+        int k = fGenStack.back();
+        if(fGenVisit[k]==0) { // first time on top: its mothers go first
+          fGenVisit[k] = 1;
+          if(fGenMo2Index[k]>=0 && fGenVisit[fGenMo2Index[k]]==0) fGenStack.push_back(fGenMo2Index[k]);
+          if(fGenMo1Index[k]>=0 && fGenVisit[fGenMo1Index[k]]==0) fGenStack.push_back(fGenMo1Index[k]);
+          continue;
+        }
+        fGenStack.pop_back();
+        if(fGenVisit[k]==1) { // mothers done
+          fGenVisit[k] = 2;
+          fGenOrder.push_back(k);
         }
-        if(j==0) genMo1Index[i]=idx;
-        if(j==1) genMo2Index[i]=idx;
       }
-      if(Promptness[i]==-1&&genMo1Index[i]>=0&&Promptness[genMo1Index[i]]>-1) Promptness[i]=Promptness[genMo1Index[i]]+1;
-      if(blabalot) cout << "                    Promtpness: " << Promptness[i] << endl;
-      if(blabalot) cout << "          Mother 1: " << genMo1Index[i] << " with Promptness " << Promptness[genMo1Index[i]] << endl;
-      if(blabalot) cout << "          Mother 2: " << genMo2Index[i] << endl;
     }
-	  
-    // STEP 2: Loop from end to start flipping storeflag when necessary
+
+    // Promptness: 0 for the incoming protons, then one more than the first mother
+    for(int o=0;o<nGenParticles;o++) {
+      int i = fGenOrder[o];
+      const GenParticle & p = (*genParticles)[i];
+      if(p.pdgId()==2212 && p.numberOfMothers()==0) fGenPromptness[i]=0;
+      else if(fGenMo1Index[i]>=0 && fGenPromptness[fGenMo1Index[i]]>-1) fGenPromptness[i]=fGenPromptness[fGenMo1Index[i]]+1;
+    }
+
+    // STEP 3: Flag the final state particles above threshold, then their ancestors, walking
+    // the ordered array from the daughters up
     float genPtThreshold=5.0; // any particle with less pt than this will not be stored.
-    for(int i=nGenParticles-1;i>=0;i--) {
-      if(genStatus[i]!=1) continue;
-      if(genPt[i]<genPtThreshold) continue;
-      FlipGenStoreFlag(i,Promptness,genMo1Index,genMo2Index,StoreFlag);
+    for(int i=0;i<nGenParticles;i++) {
+      const GenParticle & p = (*genParticles)[i];
+      if(p.status()==1 && p.pt()>=genPtThreshold) fGenStoreFlag[i]=true;
     }
-	  
+    for(int o=nGenParticles-1;o>=0;o--) {
+      int i = fGenOrder[o];
+      if(!fGenStoreFlag[i]) continue;
+      if(fGenMo1Index[i]>=0) fGenStoreFlag[fGenMo1Index[i]]=true;
+      if(fGenMo2Index[i]>=0) fGenStoreFlag[fGenMo2Index[i]]=true;
+    }
+
     // Intermediate step: Make sure that all first particles are stored, and that the earliest particles are stored (i.e. promptness criteria are met)
     for(int i=nGenParticles-1;i>=0;i--) {
-      if(Promptness[i]<4&&Promptness[i]>=0) StoreFlag[i]=true;
-      if(i<20) StoreFlag[i]=true;
+      if(fGenPromptness[i]<4&&fGenPromptness[i]>=0) fGenStoreFlag[i]=true;
+      if(i<20) fGenStoreFlag[i]=true;
     }
-	  
-    // STEP 3: Loop again, setting new index ("nindex") and replacing Mo1 by if(Mo1>-1) Mo1=nindex[index];, same for Mo2. If storeflag, store it directly.
-    *fTnGenParticles =  -1;
+
+    // STEP 4: Set the new indices first, so that a mother later in the collection
+    // already has its own, then store the flagged particles
+    *fTnGenParticles = 0;
     for(int i=0;i<nGenParticles;i++) {
-      if(!StoreFlag[i]) continue;
-      (*fTnGenParticles)++;
-      if( *fTnGenParticles > gMaxNGenParticles ) {
+      if(!fGenStoreFlag[i]) continue;
+      if( *fTnGenParticles >= gMaxNGenParticles ) {
         edm::LogWarning("NTP") << "@SUB=analyze()"
                                << "Maximum number of gen particles exceeded";
         *fTMaxGenPartExceed = 1;
         break;
       }
-	    
-      genNIndex[i] = *fTnGenParticles;
-	    
+      fGenNIndex[i] = (*fTnGenParticles)++;
+    }
+
+    for(int i=0;i<nGenParticles;i++) {
+      if(fGenNIndex[i]<0) continue;
+      const GenParticle & p = (*genParticles)[i];
+      int mo1 = fGenMo1Index[i]>=0 ? fGenNIndex[fGenMo1Index[i]] : -1;
+      int mo2 = fGenMo2Index[i]>=0 ? fGenNIndex[fGenMo2Index[i]] : -1;
+
       //store everything
-      fTgenInfoId ->push_back( genID[i] );
-      fTgenInfoStatus ->push_back( genStatus[i] );
-      fTgenInfoNMo ->push_back( genNMo[i] );
-      if(genMo1Index[i]>=0) {
-        fTgenInfoMo1->push_back( genNIndex[genMo1Index[i]] );
-      } else {
-        fTgenInfoMo1->push_back( -1 );
-      }
-      if(genMo2Index[i]>=0) {
-        fTgenInfoMo2->push_back( genNIndex[genMo2Index[i]] );
-      } else {
-        fTgenInfoMo2->push_back( -1 );
-      }
-          
-      fTPromptnessLevel->push_back( Promptness[i] );
-      fTgenInfoPt ->push_back( genPt[i] );
-      fTgenInfoEta ->push_back( genEta[i] );
-      fTgenInfoPhi ->push_back( genPhi[i] );
-      fTgenInfoM ->push_back( genM[i] );
-
-      if(blabalot) {
-        cout << "Working particle " << i << " with Promptness: " << Promptness[i] << "  (storage number: " << *fTnGenParticles << ")" << endl;
-        cout << "    Mother is Particle " << genMo1Index[i] << " with Promptness " << Promptness[genMo1Index[i]] << endl;
-        cout << "Particle " << *fTnGenParticles << "  (" << i << "): The particle has ID = " << genID[i] 
-             << " and its mother has index " << genNIndex[genMo1Index[i]]     << " mo pt : " << genPt[genMo1Index[i]] << endl;
-        cout << "stored:  " << *fTnGenParticles << "  (" << i << ")                      " << (*fTgenInfoId)[*fTnGenParticles] 
-             << "                          " << (*fTgenInfoMo1)[*fTnGenParticles] << endl;
-      }
+      fTgenInfoId ->push_back( p.pdgId() );
+      fTgenInfoStatus ->push_back( p.status() );
+      fTgenInfoNMo ->push_back( p.numberOfMothers() );
+      fTgenInfoMo1->push_back( mo1 );
+      fTgenInfoMo2->push_back( mo2 );
+      fTPromptnessLevel->push_back( fGenPromptness[i] );
+      fTgenInfoPt ->push_back( p.pt() );
+      fTgenInfoEta ->push_back( p.eta() );
+      fTgenInfoPhi ->push_back( p.phi() );
+      fTgenInfoM ->push_back( p.mass() );
+
+      if(blabalot) cout << "Particle " << fGenNIndex[i] << "  (" << i << "): The particle has ID = " << p.pdgId()
+                        << ", Promptness " << fGenPromptness[i] << " and its mother has index " << mo1 << endl;
     }
-	  
-    (*fTnGenParticles)++;
+
     if(blabalot) cout << "A total of " << *fTnGenParticles << " Particles  have been stored out of " << nGenParticles << " ( " << 100*(*fTnGenParticles)/(float)nGenParticles << " %)" << endl;
 	  
 	  
@@ -3694,12 +4065,29 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
     }
   }// end of bloat with gen information
 
+  return true;
+}
+
+//________________________________________________________________________________________
+// Jet collections of the fillers, as configured
+bool NTupleProducer::fillJetCollections(edm::Event& iEvent, const edm::EventSetup& iSetup) {
 
   ////////////////////////////////////////////////////////
   // Process other jet collections, as configured
   for ( std::vector<JetFillerBase*>::iterator it = jetFillers.begin();
         it != jetFillers.end(); ++it )
     (*it)->fillProducts(iEvent,iSetup);
+
+  return true;
+}
+
+//________________________________________________________________________________________
+// Lepton and PF candidate collections of the fillers
+bool NTupleProducer::fillOtherCollections(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+
+  using namespace edm;
+  using namespace std;
+
   for ( std::vector<PatMuonFiller*>::iterator it = muonFillers.begin(); 
         it != muonFillers.end(); ++it ) 
     (*it)->fillProducts(iEvent,iSetup);
@@ -3712,29 +4100,7 @@ bool NTupleProducer::filter(edm::Event& iEvent, const edm::EventSetup& iSetup){
   for ( std::vector<PFFiller*>::iterator it = pfFillers.begin(); 
         it != pfFillers.end(); ++it ) 
     (*it)->fillProducts(iEvent,iSetup);
-  
-  ///////////////////////////////////////////////////////////////////////////////
-  // Fill Tree //////////////////////////////////////////////////////////////////
-  putProducts( iEvent );
-  for ( std::vector<JetFillerBase*>::iterator it = jetFillers.begin();
-        it != jetFillers.end(); ++it )
-    (*it)->putProducts(iEvent);
-  for ( std::vector<PatMuonFiller*>::iterator it = muonFillers.begin(); 
-        it != muonFillers.end(); ++it ) 
-    (*it)->putProducts(iEvent);
-  for ( std::vector<PatElectronFiller*>::iterator it = electronFillers.begin(); 
-        it != electronFillers.end(); ++it ) 
-    (*it)->putProducts(iEvent);
-  for ( std::vector<PatTauFiller*>::iterator it = tauFillers.begin(); 
-        it != tauFillers.end(); ++it ) 
-    (*it)->putProducts(iEvent);
-  for ( std::vector<PFFiller*>::iterator it = pfFillers.begin(); 
-        it != pfFillers.end(); ++it ) 
-    (*it)->putProducts(iEvent);
-  
-  fNFillTree++;
-  
-  // Not used as a filter right now
+
   return true;
 }
 
@@ -3789,59 +4155,26 @@ void NTupleProducer::declareProducts(void) {
   produces<int,edm::InRun>("MaxNConv"    );
   produces<int,edm::InRun>("MaxNPfCand"    );
   produces<int,edm::InRun>("MaxNXtals"    );
+  produces<std::vector<unsigned int>,edm::InRun>("XtalGeomDetId");
+  produces<std::vector<float>,edm::InRun>("XtalGeometry");
 
   produces<std::vector<std::string>,edm::InRun>("HLTNames");
   produces<std::vector<std::string>,edm::InRun>("L1PhysMenu");
   produces<std::vector<std::string>,edm::InRun>("HLTLabels");
+  produces<std::vector<std::string>,edm::InRun>("TrigMatchFilters");
 
   produces<std::vector<std::string>,edm::InRun>("PileUpData");
   produces<std::vector<std::string>,edm::InRun>("PileUpMC");
 
-  // Event products
-  produces<int>("Run");
-  produces<unsigned int>("Event");
-  produces<int>("LumiSection");
-  produces<float>("PtHat");
-  produces<float>("QCDPartonicHT");
-  produces<std::vector<int> >("LHEEventID");
-  produces<std::vector<int> >("LHEEventStatus");
-  produces<std::vector<int> >("LHEEventMotherFirst");
-  produces<std::vector<int> >("LHEEventMotherSecond");
-  produces<std::vector<float> >("LHEEventPx");
-  produces<std::vector<float> >("LHEEventPy");
-  produces<std::vector<float> >("LHEEventPz");
-  produces<std::vector<float> >("LHEEventE");
-  produces<std::vector<float> >("LHEEventM");
-  produces<int>("SigProcID");
-  produces<float>("PDFScalePDF");
-  produces<int>("PDFID1");
-  produces<int>("PDFID2");
-  produces<float>("PDFx1");
-  produces<float>("PDFx2");
-  produces<float>("PDFxPDF1");
-  produces<float>("PDFxPDF2");
-  produces<float>("GenWeight");
-  produces<std::vector<float> >("pdfW");
-  produces<float>("pdfWsum");
-  produces<int>("NPdfs");
-  produces<int>("PUnumInteractions");
-  produces<int>("PUnumTrueInteractions");
-  produces<int>("PUnumFilled");
-  produces<int>("PUOOTnumInteractionsEarly");
-  produces<int>("PUOOTnumInteractionsLate");
-  produces<std::vector<float> >("PUzPositions");
-  produces<std::vector<float> >("PUsumPtLowPt");
-  produces<std::vector<float> >("PUsumPtHighPt");
-  produces<std::vector<float> >("PUnTrksLowPt");
-  produces<std::vector<float> >("PUnTrksHighPt");
-  produces<float>("Rho");
-  produces<float>("RhoForIso");
-  produces<float>("Weight");
-  produces<std::vector<int> >("HLTResults");
-  produces<std::vector<int> >("HLTPrescale");
-  produces<std::vector<int> >("L1PhysResults");
-  produces<std::vector<int> >("L1TechResults");
-  produces<std::vector<int> >("NHLTObjs");
+  // Regular event products, see NTupleBranches.h
+#define NTP_SCALAR(type, name, init, precision, group, enabled) \
+  if (branchEnabled(enabled, NTupleBranches::k##group)) produces<type>(#name);
+#define NTP_VECTOR(type, name, hint, precision, group, enabled) \
+  if (branchEnabled(enabled, NTupleBranches::k##group)) produces<std::vector<type> >(#name);
+#include "DiLeptonAnalysis/NTupleProducer/interface/NTupleBranches.h"
+#undef NTP_SCALAR
+#undef NTP_VECTOR
+
   for ( size_t i=0; i<gMaxHltNPaths; ++i ) {
     std::ostringstream s;
     s << i;
@@ -3850,283 +4183,18 @@ void NTupleProducer::declareProducts(void) {
     produces<std::vector<float> >(("HLTObjectEta"+s.str()).c_str());
     produces<std::vector<float> >(("HLTObjectPhi"+s.str()).c_str());
   }
-  produces<float>("PUWeightTotal");
-  produces<float>("PUWeightInTime");
-  produces<float>("MassGlu");
-  produces<float>("MassChi");
-  produces<float>("MassLSP");
-  produces<float>("xSMS");
-  produces<float>("xbarSMS");
-  produces<float>("M0");
-  produces<float>("M12");
-  produces<float>("signMu");
-  produces<float>("A0");
-  produces<int>("process");
-
-  produces<std::vector<int> >("PhoVrtxListStart");
-  produces<std::vector<int> >("JVrtxListStart");
-
-  produces<int>("MaxGenPartExceed");
-  produces<int>("nGenParticles");
-  produces<std::vector<int> >("genInfoId");
-  produces<std::vector<int> >("genInfoStatus");
-  produces<std::vector<int> >("genInfoNMo");
-  produces<std::vector<int> >("genInfoMo1");
-  produces<std::vector<int> >("genInfoMo2");
-  produces<std::vector<int> >("PromptnessLevel");
-  produces<std::vector<float> >("genInfoPt");
-  produces<std::vector<float> >("genInfoEta");
-  produces<std::vector<float> >("genInfoPhi");
+
+
   produces<std::vector<float> >("genInfoPx");
   produces<std::vector<float> >("genInfoPy");
   produces<std::vector<float> >("genInfoPz");
-  produces<std::vector<float> >("genInfoM");
-  produces<std::vector<float> >("genInfoPromptFlag");
-
-  produces<int>("PrimVtxGood");
-  produces<float>("PrimVtxx");
-  produces<float>("PrimVtxy");
-  produces<float>("PrimVtxz");
-  produces<float>("PrimVtxRho");
-  produces<float>("PrimVtxxE");
-  produces<float>("PrimVtxyE");
-  produces<float>("PrimVtxzE");
-  produces<float>("PrimVtxNChi2");
-  produces<float>("PrimVtxNdof");
-  produces<int>("PrimVtxIsFake");
-  produces<float>("PrimVtxPtSum");
-  produces<float>("Beamspotx");
-  produces<float>("Beamspoty");
-  produces<float>("Beamspotz");
-  produces<int>("NCaloTowers");
-  produces<int>("GoodEvent");
-  produces<int>("MaxMuExceed");
-  produces<int>("MaxElExceed");
-  produces<int>("MaxJetExceed");
-  produces<int>("MaxUncJetExceed");
-  produces<int>("MaxTrkExceed");
-  produces<int>("MaxPhotonsExceed");
-  produces<int>("MaxGenLepExceed");
-  produces<int>("MaxGenPhoExceed");
-  produces<int>("MaxGenJetExceed");
-  produces<int>("MaxVerticesExceed");
-  produces<int>("CSCTightHaloID");
-  produces<float>("PFType1MET");
-  produces<float>("PFType1METpx");
-  produces<float>("PFType1METpy");
-  produces<float>("PFType1METphi");
-  produces<float>("PFType1METSignificance");
-  produces<float>("PFType1SumEt");
+
   //FR produces<int>("PBNRFlag");
-  produces<int>("NGenLeptons");
-  produces<std::vector<int> >("GenLeptonID");
-  produces<std::vector<float> >("GenLeptonPt");
-  produces<std::vector<float> >("GenLeptonEta");
-  produces<std::vector<float> >("GenLeptonPhi");
-  produces<std::vector<int> >("GenLeptonMID");
-  produces<std::vector<int> >("GenLeptonMStatus");
-  produces<std::vector<float> >("GenLeptonMPt");
-  produces<std::vector<float> >("GenLeptonMEta");
-  produces<std::vector<float> >("GenLeptonMPhi");
-  produces<std::vector<int> >("GenLeptonGMID");
-  produces<std::vector<int> >("GenLeptonGMStatus");
-  produces<std::vector<float> >("GenLeptonGMPt");
-  produces<std::vector<float> >("GenLeptonGMEta");
-  produces<std::vector<float> >("GenLeptonGMPhi");
-  produces<int>("NGenPhotons");
-  produces<std::vector<float> >("GenPhotonPt");
-  produces<std::vector<float> >("GenPhotonVx");
-  produces<std::vector<float> >("GenPhotonVy");
-  produces<std::vector<float> >("GenPhotonVz");
-  produces<std::vector<float> >("GenPhotonEta");
-  produces<std::vector<float> >("GenPhotonPhi");
-  produces<std::vector<float> >("GenPhotonPartonMindR");
-  produces<std::vector<int> >("GenPhotonMotherID");
-  produces<std::vector<int> >("GenPhotonMotherStatus");
-  produces<int>("NGenJets");
-  produces<std::vector<float> >("GenJetPt");
-  produces<std::vector<float> >("GenJetEta");
-  produces<std::vector<float> >("GenJetPhi");
-  produces<std::vector<float> >("GenJetE");
-  produces<std::vector<float> >("GenJetEmE");
-  produces<std::vector<float> >("GenJetHadE");
-  produces<std::vector<float> >("GenJetInvE");
-  produces<int>("NVrtx");
-  produces<std::vector<float> >("VrtxX");
-  produces<std::vector<float> >("VrtxY");
-  produces<std::vector<float> >("VrtxZ");
-  produces<std::vector<float> >("VrtxXE");
-  produces<std::vector<float> >("VrtxYE");
-  produces<std::vector<float> >("VrtxZE");
-  produces<std::vector<float> >("VrtxNdof");
-  produces<std::vector<float> >("VrtxChi2");
-  produces<std::vector<float> >("VrtxNtrks");
-  produces<std::vector<float> >("VrtxSumPt");
-  produces<std::vector<int> >("VrtxIsFake");
-
-  produces<int>("NMus");
-  produces<int>("NMusTot");
-  produces<int>("NGMus");
-  produces<int>("NTMus");
-  produces<std::vector<int> >("MuGood");
-  produces<std::vector<int> >("MuIsIso");
-  produces<std::vector<int> >("MuIsGlobalMuon");
-  produces<std::vector<int> >("MuIsTrackerMuon");
-  produces<std::vector<int> >("MuIsPFMuon");
-  produces<std::vector<int> >("MuIsStandaloneMuon");
-  produces<std::vector<float> >("MuPx");
-  produces<std::vector<float> >("MuPy");
-  produces<std::vector<float> >("MuPz");
-  produces<std::vector<float> >("MuPt");
-  produces<std::vector<float> >("MuInnerTkPt");
-  produces<std::vector<float> >("MuTkPtE");
-  produces<std::vector<float> >("MuTkD0E");
-  produces<std::vector<float> >("MuTkDzE");
-  produces<std::vector<float> >("MuPtE");
-  produces<std::vector<float> >("MuE");
-  produces<std::vector<float> >("MuEt");
-  produces<std::vector<float> >("MuEta");
-  produces<std::vector<float> >("MuPhi");
-  produces<std::vector<int> >("MuCharge");
-  produces<std::vector<float> >("MuRelIso03");
-  produces<std::vector<float> >("MuIso03SumPt");
-  produces<std::vector<float> >("MuIso03EmEt");
-  produces<std::vector<float> >("MuIso03HadEt");
-  produces<std::vector<float> >("MuIso03EMVetoEt");
-  produces<std::vector<float> >("MuIso03HadVetoEt");
-  produces<std::vector<float> >("MuIso05SumPt");
-  produces<std::vector<float> >("MuIso05EmEt");
-  produces<std::vector<float> >("MuIso05HadEt");
-  produces<std::vector<float> >("MuPfIsoR03ChHad");
-  produces<std::vector<float> >("MuPfIsoR03NeHad");
-  produces<std::vector<float> >("MuPfIsoR03Photon");
-  produces<std::vector<float> >("MuPfIsoR03NeHadHighThresh");
-  produces<std::vector<float> >("MuPfIsoR03PhotonHighThresh");
-  produces<std::vector<float> >("MuPfIsoR03SumPUPt");
-  produces<std::vector<float> >("MuPfIsoR04ChHad");
-  produces<std::vector<float> >("MuPfIsoR04NeHad");
-  produces<std::vector<float> >("MuPfIsoR04Photon");
-  produces<std::vector<float> >("MuPfIsoR04NeHadHighThresh");
-  produces<std::vector<float> >("MuPfIsoR04PhotonHighThresh");
-  produces<std::vector<float> >("MuPfIsoR04SumPUPt");
+
   for ( std::vector<edm::InputTag>::const_iterator it = fMuonPfIsoTagsCustom.begin();
         it != fMuonPfIsoTagsCustom.end(); ++it ) {
     produces<std::vector<float> >(("Mu"+(*it).label()).c_str());
   }
-  produces<std::vector<float> >("MuEem");
-  produces<std::vector<float> >("MuEhad");
-  produces<std::vector<float> >("MuD0BS");
-  produces<std::vector<float> >("MuD0PV");
-  produces<std::vector<float> >("MuD03DPV");
-  produces<std::vector<float> >("MuD03DE");
-  produces<std::vector<float> >("MuD0E");
-  produces<std::vector<float> >("MuDzBS");
-  produces<std::vector<float> >("MuDzPV");
-  produces<std::vector<float> >("MuDzE");
-  produces<std::vector<float> >("MuNChi2");
-  produces<std::vector<int> >("MuNGlHits");
-  produces<std::vector<int> >("MuNGlMuHits");
-  produces<std::vector<int> >("MuNMuHits");
-  produces<std::vector<int> >("MuNTkHits");
-  produces<std::vector<int> >("MuNPxHits");
-  produces<std::vector<float> >("MuInnerTkNChi2");
-  produces<std::vector<int> >("MuNSiLayers");
-  produces<std::vector<int> >("MuNMatches");
-  produces<std::vector<int> >("MuNMatchedStations");
-  produces<std::vector<int> >("MuNChambers");
-  produces<std::vector<float> >("MuIsoMVA");
-  produces<std::vector<float> >("MuCaloComp");
-  produces<std::vector<float> >("MuSegmComp");
-  produces<std::vector<int> >("MuIsGMPT");
-  produces<std::vector<int> >("MuIsGMTkChiComp");
-  produces<std::vector<int> >("MuIsGMStaChiComp");
-  produces<std::vector<int> >("MuIsGMTkKinkTight");
-  produces<std::vector<int> >("MuIsAllStaMuons");
-  produces<std::vector<int> >("MuIsAllTrkMuons");
-  produces<std::vector<int> >("MuIsTrkMuonArbitrated");
-  produces<std::vector<int> >("MuIsAllArbitrated");
-  produces<std::vector<int> >("MuIsTMLSLoose");
-  produces<std::vector<int> >("MuIsTMLSTight");
-  produces<std::vector<int> >("MuIsTM2DCompLoose");
-  produces<std::vector<int> >("MuIsTM2DCompTight");
-  produces<std::vector<int> >("MuIsTMOneStationLoose");
-  produces<std::vector<int> >("MuIsTMOneStationTight");
-  produces<std::vector<int> >("MuIsTMLSOptLowPtLoose");
-  produces<std::vector<int> >("MuIsTMLSAngLoose");
-  produces<std::vector<int> >("MuIsTMLSAngTight");
-  produces<std::vector<int> >("MuIsTMOneStationAngTight");
-  produces<std::vector<int> >("MuIsTMOneStationAngLoose");
-  produces<std::vector<int> >("MuGenID");
-  produces<std::vector<int> >("MuGenStatus");
-  produces<std::vector<float> >("MuGenPt");
-  produces<std::vector<float> >("MuGenEta");
-  produces<std::vector<float> >("MuGenPhi");
-  produces<std::vector<float> >("MuGenE");
-  produces<std::vector<int> >("MuGenMID");
-  produces<std::vector<int> >("MuGenMStatus");
-  produces<std::vector<float> >("MuGenMPt");
-  produces<std::vector<float> >("MuGenMEta");
-  produces<std::vector<float> >("MuGenMPhi");
-  produces<std::vector<float> >("MuGenME");
-  produces<std::vector<int> >("MuGenGMID");
-  produces<std::vector<int> >("MuGenGMStatus");
-  produces<std::vector<float> >("MuGenGMPt");
-  produces<std::vector<float> >("MuGenGMEta");
-  produces<std::vector<float> >("MuGenGMPhi");
-  produces<std::vector<float> >("MuGenGME");
-  produces<int>("NEBhits");
-  produces<std::vector<float> >("EBrechitE");
-  produces<std::vector<float> >("EBrechitPt");
-  produces<std::vector<float> >("EBrechitEta");
-  produces<std::vector<float> >("EBrechitPhi");
-  produces<std::vector<float> >("EBrechitChi2");
-  produces<std::vector<float> >("EBrechitTime");
-  produces<std::vector<float> >("EBrechitE4oE1");
-  produces<std::vector<float> >("EBrechitE2oE9");
-  produces<int>("NEles");
-  produces<int>("NElesTot");
-  produces<std::vector<int> >("ElGood");
-  produces<std::vector<int> >("ElIsIso");
-  produces<std::vector<int> >("ElChargeMisIDProb");
-  produces<std::vector<float> >("ElPx");
-  produces<std::vector<float> >("ElPy");
-  produces<std::vector<float> >("ElPz");
-  produces<std::vector<float> >("ElPt");
-  produces<std::vector<float> >("ElPtE");
-  produces<std::vector<float> >("ElE");
-  produces<std::vector<float> >("ElEt");
-  produces<std::vector<float> >("ElEta");
-  produces<std::vector<float> >("ElTheta");
-  produces<std::vector<float> >("ElSCEta");
-  produces<std::vector<float> >("ElPhi");
-  produces<std::vector<int> >("ElIsEB");
-  produces<std::vector<int> >("ElIsEE");
-  produces<std::vector<float> >("ElGsfTkPt");
-  produces<std::vector<float> >("ElGsfTkEta");
-  produces<std::vector<float> >("ElGsfTkPhi");
-  produces<std::vector<float> >("ElTrkMomentumError");
-  produces<std::vector<float> >("ElEcalEnergyError");
-  produces<std::vector<float> >("ElEleMomentumError");
-  produces<std::vector<int> >("ElNBrems");
-  produces<std::vector<float> >("ElD0BS");
-  produces<std::vector<float> >("ElD0PV");
-  produces<std::vector<float> >("ElD0E");
-  produces<std::vector<float> >("ElD03DPV");
-  produces<std::vector<float> >("ElD03DE");
-  produces<std::vector<float> >("ElDzBS");
-  produces<std::vector<float> >("ElDzPV");
-  produces<std::vector<float> >("ElDzE");
-  produces<std::vector<float> >("ElRelIso03");
-  produces<std::vector<float> >("ElRelIso04");
-  produces<std::vector<float> >("ElPfIsoChHad03");
-  produces<std::vector<float> >("ElPfIsoNeHad03");
-  produces<std::vector<float> >("ElPfIsoPhoton03");
-  produces<std::vector<float> >("ElDR03TkSumPt");
-  produces<std::vector<float> >("ElDR04TkSumPt");
-  produces<std::vector<float> >("ElDR03EcalRecHitSumEt");
-  produces<std::vector<float> >("ElDR04EcalRecHitSumEt");
-  produces<std::vector<float> >("ElDR03HcalTowerSumEt");
-  produces<std::vector<float> >("ElDR04HcalTowerSumEt");
   for ( std::vector<edm::InputTag>::const_iterator it = fElePfIsoTagsCustom.begin();
         it != fElePfIsoTagsCustom.end(); ++it ) {
     produces<std::vector<float> >(("El"+(*it).label()).c_str());
@@ -4135,152 +4203,6 @@ void NTupleProducer::declareProducts(void) {
         it != fElePfIsoTagsEvent.end(); ++it ) {
     produces<std::vector<float> >(("ElEvent"+(*it).label()).c_str());
   }
-  produces<std::vector<float> >("ElNChi2");
-  produces<std::vector<float> >("ElKfTrkchi2");
-  produces<std::vector<float> >("ElKfTrkhits");
-  produces<std::vector<int> >("ElCharge");
-  produces<std::vector<int> >("ElCInfoIsGsfCtfCons");
-  produces<std::vector<int> >("ElCInfoIsGsfCtfScPixCons");
-  produces<std::vector<int> >("ElCInfoIsGsfScPixCons");
-  produces<std::vector<int> >("ElScPixCharge");
-  produces<std::vector<float> >("ElClosestCtfTrackPt");
-  produces<std::vector<float> >("ElClosestCtfTrackEta");
-  produces<std::vector<float> >("ElClosestCtfTrackPhi");
-  produces<std::vector<int> >("ElClosestCtfTrackCharge");
-  produces<std::vector<float> >("ElIDMva");
-  produces<std::vector<float> >("ElIDMVATrig");
-  produces<std::vector<float> >("ElIDMVANoTrig");
-  produces<std::vector<int> >("ElInGap");
-  produces<std::vector<int> >("ElEcalDriven");
-  produces<std::vector<int> >("ElTrackerDriven");
-  produces<std::vector<int> >("ElBasicClustersSize");
-  produces<std::vector<float> >("Elfbrem");
-  produces<std::vector<float> >("ElHcalOverEcal");
-  produces<std::vector<float> >("ElHcalOverEcalBc");
-  produces<std::vector<float> >("ElE1x5");
-  produces<std::vector<float> >("ElE5x5");
-  produces<std::vector<float> >("ElE2x5Max");
-  produces<std::vector<float> >("ElR9");
-  produces<std::vector<float> >("ElSigmaIetaIeta");
-  produces<std::vector<float> >("ElSigmaIphiIphi");
-  produces<std::vector<float> >("ElScEtaWidth");
-  produces<std::vector<float> >("ElScPhiWidth");
-  produces<std::vector<float> >("ElDeltaPhiSeedClusterAtCalo");
-  produces<std::vector<float> >("ElDeltaEtaSeedClusterAtCalo");
-  produces<std::vector<float> >("ElDeltaPhiSuperClusterAtVtx");
-  produces<std::vector<float> >("ElDeltaEtaSuperClusterAtVtx");
-  produces<std::vector<float> >("ElCaloEnergy");
-  produces<std::vector<float> >("ElTrkMomAtVtx");
-  produces<std::vector<float> >("ElESuperClusterOverP");
-  produces<std::vector<float> >("ElPreShowerOverRaw");
-  produces<std::vector<float> >("ElEoPout");
-  produces<std::vector<float> >("ElIoEmIoP");
-  produces<std::vector<int> >("ElNumberOfMissingInnerHits");
-  produces<std::vector<int> >("ElSCindex");
-  produces<std::vector<float> >("ElConvPartnerTrkDist");
-  produces<std::vector<float> >("ElConvPartnerTrkDCot");
-  produces<std::vector<float> >("ElConvPartnerTrkPt");
-  produces<std::vector<float> >("ElConvPartnerTrkEta");
-  produces<std::vector<float> >("ElConvPartnerTrkPhi");
-  produces<std::vector<float> >("ElConvPartnerTrkCharge");
-  produces<std::vector<int> >("ElScSeedSeverity");
-  produces<std::vector<float> >("ElE1OverE9");
-  produces<std::vector<float> >("ElS4OverS1");
-  produces<std::vector<int> >("ElGenID");
-  produces<std::vector<int> >("ElGenStatus");
-  produces<std::vector<float> >("ElGenPt");
-  produces<std::vector<float> >("ElGenEta");
-  produces<std::vector<float> >("ElGenPhi");
-  produces<std::vector<float> >("ElGenE");
-  produces<std::vector<int> >("ElGenMID");
-  produces<std::vector<int> >("ElGenMStatus");
-  produces<std::vector<float> >("ElGenMPt");
-  produces<std::vector<float> >("ElGenMEta");
-  produces<std::vector<float> >("ElGenMPhi");
-  produces<std::vector<float> >("ElGenME");
-  produces<std::vector<int> >("ElGenGMID");
-  produces<std::vector<int> >("ElGenGMStatus");
-  produces<std::vector<float> >("ElGenGMPt");
-  produces<std::vector<float> >("ElGenGMEta");
-  produces<std::vector<float> >("ElGenGMPhi");
-  produces<std::vector<float> >("ElGenGME");
-  produces<int>("NPhotons");
-  produces<int>("NPhotonsTot");
-  produces<std::vector<int> >("PhoGood");
-  produces<std::vector<int> >("PhoIsIso");
-  produces<std::vector<float> >("PhoPt");
-  produces<std::vector<float> >("PhoPx");
-  produces<std::vector<float> >("PhoPy");
-  produces<std::vector<float> >("PhoPz");
-  produces<std::vector<float> >("PhoEta");
-  produces<std::vector<float> >("PhoPhi");
-  produces<std::vector<float> >("PhoEnergy");
-  produces<std::vector<float> >("PhoIso03Ecal");
-  produces<std::vector<float> >("PhoIso03Hcal");
-  produces<std::vector<float> >("PhoIso03TrkSolid");
-  produces<std::vector<float> >("PhoIso03TrkHollow");
-  produces<std::vector<float> >("PhoIso03");
-  produces<std::vector<float> >("PhoIso04Ecal");
-  produces<std::vector<float> >("PhoIso04Hcal");
-  produces<std::vector<float> >("PhoIso04TrkSolid");
-  produces<std::vector<float> >("PhoIso04TrkHollow");
-  produces<std::vector<float> >("PhoIso04");
-  produces<std::vector<float> >("PhoR9");
-  produces<std::vector<float> >("PhoCaloPositionX");
-  produces<std::vector<float> >("PhoCaloPositionY");
-  produces<std::vector<float> >("PhoCaloPositionZ");
-  produces<std::vector<float> >("PhoHoverE");
-  produces<std::vector<float> >("PhoH1overE");
-  produces<std::vector<float> >("PhoH2overE");
-  produces<std::vector<float> >("PhoHoverE2012");
-  produces<std::vector<float> >("PhoSigmaIetaIeta");
-  produces<std::vector<float> >("PhoSigmaIetaIphi");
-  produces<std::vector<float> >("PhoSigmaIphiIphi");
-  produces<std::vector<float> >("PhoS4Ratio");
-  produces<std::vector<float> >("PhoLambdaRatio");
-  produces<std::vector<float> >("PhoSCRawEnergy");
-  produces<std::vector<float> >("PhoSCEtaWidth");
-  produces<std::vector<float> >("PhoSCSigmaPhiPhi");
-  produces<std::vector<int> >("PhoHasPixSeed");
-  produces<std::vector<int> >("PhoHasConvTrks");
-  produces<std::vector<int> >("PhoScSeedSeverity");
-  produces<std::vector<float> >("PhoE1OverE9");
-  produces<std::vector<float> >("PhoS4OverS1");
-  produces<std::vector<float> >("PhoSigmaEtaEta");
-  produces<std::vector<float> >("PhoSigmaRR");
-  produces<std::vector<float> >("PhoNewIsoPFCharged");
-  produces<std::vector<float> >("PhoNewIsoPFPhoton");
-  produces<std::vector<float> >("PhoNewIsoPFNeutral");
-  produces<std::vector<float> >("PhoE1x5");
-  produces<std::vector<float> >("PhoE2x5");
-  produces<std::vector<float> >("PhoE3x3");
-  produces<std::vector<float> >("PhoE5x5");
-  produces<std::vector<float> >("PhomaxEnergyXtal");
-  produces<std::vector<float> >("PhoIso03HcalDepth1");
-  produces<std::vector<float> >("PhoIso03HcalDepth2");
-  produces<std::vector<float> >("PhoIso04HcalDepth1");
-  produces<std::vector<float> >("PhoIso04HcalDepth2");
-  produces<std::vector<int> >("PhoIso03nTrksSolid");
-  produces<std::vector<int> >("PhoIso03nTrksHollow");
-  produces<std::vector<int> >("PhoIso04nTrksSolid");
-  produces<std::vector<int> >("PhoIso04nTrksHollow");
-  produces<std::vector<int> >("PhoisEB");
-  produces<std::vector<int> >("PhoisEE");
-  produces<std::vector<int> >("PhoisEBEtaGap");
-  produces<std::vector<int> >("PhoisEBPhiGap");
-  produces<std::vector<int> >("PhoisEERingGap");
-  produces<std::vector<int> >("PhoisEEDeeGap");
-  produces<std::vector<int> >("PhoisEBEEGap");
-  produces<std::vector<int> >("PhoisPFlowPhoton");
-  produces<std::vector<int> >("PhoisStandardPhoton");
-  produces<std::vector<int> >("PhoMCmatchindex");
-  produces<std::vector<int> >("PhoMCmatchexitcode");
-  produces<std::vector<float> >("PhoChargedHadronIso");
-  produces<std::vector<float> >("PhoNeutralHadronIso");
-  produces<std::vector<float> >("PhoPhotonIso");
-  produces<std::vector<int> >("PhoisPFPhoton");
-  produces<std::vector<int> >("PhoisPFElectron");
-  produces<std::vector<int> >("PhotSCindex");
 //  produces<std::vector<float> >("PhoCone04PhotonIsodR0dEta0pt0");
 //  produces<std::vector<float> >("PhoCone04PhotonIsodR0dEta0pt5");
 //  produces<std::vector<float> >("PhoCone04PhotonIsodR8dEta0pt0");
@@ -4327,19 +4249,7 @@ void NTupleProducer::declareProducts(void) {
 //  produces<std::vector<float> >("PhoCone04ChargedHadronIsodR015dEta0pt0dz0");
 //  produces<std::vector<float> >("PhoCone04ChargedHadronIsodR015dEta0pt0dz1dxy01");
 //  produces<std::vector<float> >("PhoCone04ChargedHadronIsodR015dEta0pt0PFnoPU");
-  produces<std::vector<float> >("PhoCiCPFIsoChargedDR03");
-  produces<std::vector<float> >("PhoCiCPFIsoNeutralDR03");
-  produces<std::vector<float> >("PhoCiCPFIsoPhotonDR03");
-  produces<std::vector<float> >("PhoCiCPFIsoChargedDR04");
-  produces<std::vector<float> >("PhoCiCPFIsoNeutralDR04");
-  produces<std::vector<float> >("PhoCiCPFIsoPhotonDR04");
-  produces<std::vector<float> >("PhoSCEta");
-  produces<std::vector<float> >("PhoSCPhiWidth");
-  produces<std::vector<float> >("PhoIDMVA");
   produces<std::vector<bool> > ("PhoConvValidVtx");
-  produces<std::vector<bool> > ("ElPassConversionVeto");
-  produces<std::vector<bool> > ("PhoPassConversionVeto");
-  produces<std::vector<float> >("PhoHCalIso2012ConeDR03");
   produces<std::vector<int> >  ("PhoConvNtracks");
   produces<std::vector<float> >("PhoConvChi2Probability");
   produces<std::vector<float> >("PhoConvEoverP");
@@ -4349,95 +4259,10 @@ void NTupleProducer::declareProducts(void) {
   produces<std::vector<float> >("ConvChi2Probability");
   produces<std::vector<float> >("ConvEoverP");
   produces<std::vector<float> >("ConvZofPrimVtxFromTrks");
-  produces<int>("Ngv");
-  produces<std::vector<float> >("gvSumPtHi");
-  produces<std::vector<float> >("gvSumPtLo");
-  produces<std::vector<int> >("gvNTkHi");
-  produces<std::vector<int> >("gvNTkLo");
-  produces<int>("NGoodSuperClusters");
-  produces<std::vector<float> >("GoodSCEnergy");
-  produces<std::vector<float> >("GoodSCEta");
-  produces<std::vector<float> >("GoodSCPhi");
-  produces<int>("NSuperClusters");
-  produces<std::vector<float> >("SCRaw");
-  produces<std::vector<float> >("SCPre");
-  produces<std::vector<float> >("SCEnergy");
-  produces<std::vector<float> >("SCEta");
-  produces<std::vector<float> >("SCPhi");
-  produces<std::vector<float> >("SCPhiWidth");
-  produces<std::vector<float> >("SCEtaWidth");
-  produces<std::vector<float> >("SCBrem");
-  produces<std::vector<float> >("SCR9");
-  produces<std::vector<float> >("SCcrackcorrseed");
-  produces<std::vector<float> >("SCcrackcorr");
-  produces<std::vector<float> >("SClocalcorrseed");
-  produces<std::vector<float> >("SClocalcorr");
-  produces<std::vector<float> >("SCcrackcorrseedfactor");
-  produces<std::vector<float> >("SClocalcorrseedfactor");
-  produces<int>("NJets");
-  produces<int>("NJetsTot");
-  produces<std::vector<int> >("JGood");
-  produces<std::vector<float> >("JPx");
-  produces<std::vector<float> >("JPy");
-  produces<std::vector<float> >("JPz");
-  produces<std::vector<float> >("JPt");
-  produces<std::vector<float> >("JE");
-  produces<std::vector<float> >("JEt");
-  produces<std::vector<float> >("JEta");
-  produces<std::vector<float> >("JPhi");
-  produces<std::vector<float> >("JEcorr");
-  produces<std::vector<float> >("JArea");
-  produces<std::vector<float> >("JEtaRms");
-  produces<std::vector<float> >("JPhiRms");
-  produces<std::vector<int> >("JNConstituents");
-  produces<std::vector<int> >("JNAssoTracks");
-  produces<std::vector<int> >("JNNeutrals");
-  produces<std::vector<float> >("JChargedEmFrac");
-  produces<std::vector<float> >("JNeutralEmFrac");
-  produces<std::vector<float> >("JChargedHadFrac");
-  produces<std::vector<float> >("JNeutralHadFrac");
-  produces<std::vector<float> >("JChargedMuEnergyFrac");
-  produces<std::vector<float> >("JPhoFrac");
-  produces<std::vector<float> >("JHFHadFrac");
-  produces<std::vector<float> >("JHFEMFrac");
-  produces<std::vector<float> >("JPtD");
-  produces<std::vector<float> >("JRMSCand");
-  produces<std::vector<float> >("JeMinDR");
   for ( std::vector<edm::InputTag>::const_iterator it = fBtagTags.begin();
 	it != fBtagTags.end(); ++it ) {
     produces<std::vector<float> >(("J"+(*it).label()).c_str());
   }
-  produces<std::vector<int>   >("JPartonFlavour");
-  produces<std::vector<float> >("JMass");
-  produces<std::vector<float> >("JBetaStar");
-  produces<std::vector<float> >("JBeta");
-  produces<std::vector<float> >("JBetaSq");
-  produces<std::vector<float> >("Jtrk1px");
-  produces<std::vector<float> >("Jtrk1py");
-  produces<std::vector<float> >("Jtrk1pz");
-  produces<std::vector<float> >("Jtrk2px");
-  produces<std::vector<float> >("Jtrk2py");
-  produces<std::vector<float> >("Jtrk2pz");
-  produces<std::vector<float> >("Jtrk3px");
-  produces<std::vector<float> >("Jtrk3py");
-  produces<std::vector<float> >("Jtrk3pz");
-  produces<std::vector<float> >("JVtxx");
-  produces<std::vector<float> >("JVtxy");
-  produces<std::vector<float> >("JVtxz");
-  produces<std::vector<float> >("JVtxExx");
-  produces<std::vector<float> >("JVtxEyx");
-  produces<std::vector<float> >("JVtxEyy");
-  produces<std::vector<float> >("JVtxEzy");
-  produces<std::vector<float> >("JVtxEzz");
-  produces<std::vector<float> >("JVtxEzx");
-  produces<std::vector<float> >("JVtxNChi2");
-  produces<std::vector<int> >("JGenJetIndex");
-  produces<std::vector<float> >("JMetCorrRawEta"); 
-  produces<std::vector<float> >("JMetCorrPhi");  
-  produces<std::vector<float> >("JMetCorrNoMuPt");  
-  produces<std::vector<float> >("JMetCorrRawPt");  
-  produces<std::vector<float> >("JMetCorrEMF"); 
-  produces<std::vector<float> >("JMetCorrArea");
   for ( size_t i=0; i<gMaxNPileupJetIDAlgos; ++i ) {
     std::ostringstream s;
     s << i;
@@ -4445,123 +4270,11 @@ void NTupleProducer::declareProducts(void) {
     produces<std::vector<bool> >(("JPassPileupIDM"+s.str()).c_str());
     produces<std::vector<bool> >(("JPassPileupIDT"+s.str()).c_str());
   }
-  produces<std::vector<float> >("JQGTagLD");
-  produces<std::vector<float> >("JQGTagMLP");
-  produces<std::vector<float> >("JSmearedQGL");
-  produces<int>("NTracks");
-  produces<int>("NTracksTot");
-  produces<std::vector<int> >("TrkGood");
-  produces<std::vector<float> >("TrkPt");
-  produces<std::vector<float> >("TrkEta");
-  produces<std::vector<float> >("TrkPhi");
-  produces<std::vector<float> >("TrkNChi2");
-  produces<std::vector<float> >("TrkNHits");
-  produces<std::vector<float> >("TrkVtxDz");
-  produces<std::vector<float> >("TrkVtxDxy");
-  produces<float>("TrkPtSumx");
-  produces<float>("TrkPtSumy");
-  produces<float>("TrkPtSum");
-  produces<float>("TrkPtSumPhi");
-  produces<float>("SumEt");
-  produces<float>("ECALSumEt");
-  produces<float>("HCALSumEt");
-  produces<float>("ECALEsumx");
-  produces<float>("ECALEsumy");
-  produces<float>("ECALEsumz");
-  produces<float>("ECALMET");
-  produces<float>("ECALMETPhi");
-  produces<float>("ECALMETEta");
-  produces<float>("HCALEsumx");
-  produces<float>("HCALEsumy");
-  produces<float>("HCALEsumz");
-  produces<float>("HCALMET");
-  produces<float>("HCALMETPhi");
-  produces<float>("HCALMETeta");
-  produces<float>("RawMET");
-  produces<float>("RawMETpx");
-  produces<float>("RawMETpy");
-  produces<float>("RawMETphi");
-  produces<float>("RawMETemEtFrac");
-  produces<float>("RawMETemEtInEB");
-  produces<float>("RawMETemEtInEE");
-  produces<float>("RawMETemEtInHF");
-  produces<float>("RawMEThadEtFrac");
-  produces<float>("RawMEThadEtInHB");
-  produces<float>("RawMEThadEtInHE");
-  produces<float>("RawMEThadEtInHF");
-  produces<float>("RawMETSignificance");
-  produces<float>("GenMET");
-  produces<float>("GenMETpx");
-  produces<float>("GenMETpy");
-  produces<float>("GenMETphi");
-  produces<float>("TCMET");
-  produces<float>("TCMETpx");
-  produces<float>("TCMETpy");
-  produces<float>("TCMETphi");
-  produces<float>("TCMETSignificance");
-  produces<float>("MuJESCorrMET");
-  produces<float>("MuJESCorrMETpx");
-  produces<float>("MuJESCorrMETpy");
-  produces<float>("MuJESCorrMETphi");
-  produces<float>("PFMET");
-  produces<float>("PFMETpx");
-  produces<float>("PFMETpy");
-  produces<float>("PFMETphi");
-  produces<float>("PFMETSignificance");
-  produces<float>("PFSumEt");
-  produces<float>("METR12");
-  produces<float>("METR21");
-
-produces<float>("Sigma");
-produces<std::vector<float> >("GenPhotonIsoDR03");
-produces<std::vector<float> >("GenPhotonIsoDR04");
-produces<std::vector<float> >("SCX");
-produces<std::vector<float> >("SCY");
-produces<std::vector<float> >("SCZ");
-produces<std::vector<int> >("SCXtalListStart");
-produces<std::vector<int> >("SCNXtals");
-produces<int>("NXtals");
-produces<std::vector<float> >("XtalX");
-produces<std::vector<float> >("XtalY");
-produces<std::vector<float> >("XtalZ");
-produces<std::vector<float> >("XtalEtaWidth");
-produces<std::vector<float> >("XtalPhiWidth");
-produces<std::vector<float> >("XtalFront1X");
-produces<std::vector<float> >("XtalFront1Y");
-produces<std::vector<float> >("XtalFront1Z");
-produces<std::vector<float> >("XtalFront2X");
-produces<std::vector<float> >("XtalFront2Y");
-produces<std::vector<float> >("XtalFront2Z");
-produces<std::vector<float> >("XtalFront3X");
-produces<std::vector<float> >("XtalFront3Y");
-produces<std::vector<float> >("XtalFront3Z");
-produces<std::vector<float> >("XtalFront4X");
-produces<std::vector<float> >("XtalFront4Y");
-produces<std::vector<float> >("XtalFront4Z");
-produces<int>("NPfCand");
-produces<std::vector<int> >("PfCandPdgId");
-produces<std::vector<float> >("PfCandEta");
-produces<std::vector<float> >("PfCandPhi");
-produces<std::vector<float> >("PfCandEnergy");
-produces<std::vector<float> >("PfCandEcalEnergy");
-produces<std::vector<float> >("PfCandPt");
-produces<std::vector<float> >("PfCandVx");
-produces<std::vector<float> >("PfCandVy");
-produces<std::vector<float> >("PfCandVz");
-produces<std::vector<int> >("PfCandBelongsToJet");
+
 //produces<std::vector<int> >("PfCandHasHitInFirstPixelLayer");
 //produces<std::vector<float> >("PfCandTrackRefPx");
 //produces<std::vector<float> >("PfCandTrackRefPy");
 //produces<std::vector<float> >("PfCandTrackRefPz");
-produces<std::vector<int> >("PhoMatchedPFPhotonCand");
-produces<std::vector<int> >("PhoMatchedPFElectronCand");
-produces<std::vector<int> >("PhoFootprintPfCandsListStart");
-produces<std::vector<int> >("PhoFootprintPfCands");
-produces<std::vector<float> >("PhoVx");
-produces<std::vector<float> >("PhoVy");
-produces<std::vector<float> >("PhoVz");
-produces<std::vector<float> >("PhoRegrEnergy");
-produces<std::vector<float> >("PhoRegrEnergyErr");
 //produces<std::vector<float> >("PhoCone01PhotonIsodEta015EBdR070EEmvVtx");
 //produces<std::vector<float> >("PhoCone02PhotonIsodEta015EBdR070EEmvVtx");
 //produces<std::vector<float> >("PhoCone03PhotonIsodEta015EBdR070EEmvVtx");
@@ -4576,24 +4289,7 @@ produces<std::vector<float> >("PhoRegrEnergyErr");
 //produces<std::vector<float> >("PhoCone04ChargedHadronIsodR02dz02dxy01");
 //produces<std::vector<float> >("PhoCone03PFCombinedIso");
 //produces<std::vector<float> >("PhoCone04PFCombinedIso");
-produces<std::vector<int> >("Diphotonsfirst");
-produces<std::vector<int> >("Diphotonssecond");
-produces<std::vector<int> >("Vtxdiphoh2gglobe");
-produces<std::vector<int> >("Vtxdiphomva");
-produces<std::vector<int> >("Vtxdiphoproductrank");
-produces<std::vector<float> >("PhoSCRemovalPFIsoCharged");
-produces<std::vector<float> >("PhoSCRemovalPFIsoChargedPrimVtx");
-produces<std::vector<float> >("PhoSCRemovalPFIsoNeutral");
-produces<std::vector<float> >("PhoSCRemovalPFIsoPhoton");
-produces<std::vector<float> >("PhoSCRemovalPFIsoChargedRCone");
-produces<std::vector<float> >("PhoSCRemovalPFIsoChargedPrimVtxRCone");
-produces<std::vector<float> >("PhoSCRemovalPFIsoNeutralRCone");
-produces<std::vector<float> >("PhoSCRemovalPFIsoPhotonRCone");
-produces<std::vector<float> >("PhoSCRemovalRConeEta");
-produces<std::vector<float> >("PhoSCRemovalRConePhi");
 //MQ
-produces<std::vector<float> >("PhoSCRemovalPFIsoChargedVtxConst");
-produces<std::vector<float> >("PhoSCRemovalPFIsoChargedVtxConstRCone");
 
 }
 
@@ -4601,490 +4297,41 @@ produces<std::vector<float> >("PhoSCRemovalPFIsoChargedVtxConstRCone");
 // Reset all event variables
 void NTupleProducer::resetProducts( void ) {
   
-  fTRun.reset(new int(-999));
-  fTEvent.reset(new unsigned int(0));
-  fTLumiSection.reset(new int(-999));
-  fTPtHat.reset(new float(-999.99));
-  fTQCDPartonicHT.reset(new float(-999.99));
-  fTLHEEventID.reset(new std::vector<int> );
-  fTLHEEventStatus.reset(new std::vector<int> );
-  fTLHEEventMotherFirst.reset(new std::vector<int> );
-  fTLHEEventMotherSecond.reset(new std::vector<int> );
-  fTLHEEventPx.reset(new std::vector<float> );
-  fTLHEEventPy.reset(new std::vector<float> );
-  fTLHEEventPz.reset(new std::vector<float> );
-  fTLHEEventE .reset(new std::vector<float> );
-  fTLHEEventM .reset(new std::vector<float> );
-  fTSigProcID.reset(new int(-999));
-  fTPDFScalePDF.reset(new float(-999.99));
-  fTPDFID1.reset(new int(-999));
-  fTPDFID2.reset(new int(-999));
-  fTPDFx1.reset(new float(-999.99));
-  fTPDFx2.reset(new float(-999.99));
-  fTPDFxPDF1.reset(new float(-999.99));
-  fTPDFxPDF2.reset(new float(-999.99));
-  fTGenWeight.reset(new float(-999.99));
-  fTpdfW.reset(new std::vector<float> );
-  fTpdfWsum.reset(new float(0.0));
-  fTNPdfs.reset(new int(1));
-  fTPUnumInteractions.reset(new int(-999));
-  fTPUnumTrueInteractions.reset(new int(-999));
-  fTPUnumFilled.reset(new int(-999));
-  fTPUOOTnumInteractionsEarly.reset(new int(-999));
-  fTPUOOTnumInteractionsLate.reset(new int(-999));
-  fTPUzPositions.reset(new std::vector<float> );
-  fTPUsumPtLowPt.reset(new std::vector<float> );
-  fTPUsumPtHighPt.reset(new std::vector<float> );
-  fTPUnTrksLowPt.reset(new std::vector<float> );
-  fTPUnTrksHighPt.reset(new std::vector<float> );
-  fTRho.reset(new float(-999.99));
-  fTRhoForIso.reset(new float(-999.99));
-  fTWeight.reset(new float(-999.99));
-  fTHLTResults.reset(new std::vector<int> );
-  fTHLTPrescale.reset(new std::vector<int> );
-  fTL1PhysResults.reset(new std::vector<int> );
-  fTL1TechResults.reset(new std::vector<int> );
-  fTNHLTObjs.reset(new std::vector<int> );
+  // Regular event products, see NTupleBranches.h
+#define NTP_SCALAR(type, name, init, precision, group, enabled) \
+  if (branchEnabled(enabled, NTupleBranches::k##group)) fT##name.reset(new type(init)); \
+  else NTupleBranches::resetUnused(fT##name, static_cast<type>(init));
+#define NTP_VECTOR(type, name, hint, precision, group, enabled) \
+  if (branchEnabled(enabled, NTupleBranches::k##group)) fBufferPool.reset(fT##name, #name, hint); \
+  else NTupleBranches::resetUnused(fT##name);
+#include "DiLeptonAnalysis/NTupleProducer/interface/NTupleBranches.h"
+#undef NTP_SCALAR
+#undef NTP_VECTOR
+
   for ( size_t i=0; i<gMaxHltNPaths; ++i ) {
-    fTHLTObjectID[i].reset(new std::vector<int> );
-    fTHLTObjectPt[i].reset(new std::vector<float> );
-    fTHLTObjectEta[i].reset(new std::vector<float> );
-    fTHLTObjectPhi[i].reset(new std::vector<float> );
+    fBufferPool.reset(fTHLTObjectID[i], "HLTObjectID");
+    fBufferPool.reset(fTHLTObjectPt[i], "HLTObjectPt");
+    fBufferPool.reset(fTHLTObjectEta[i], "HLTObjectEta");
+    fBufferPool.reset(fTHLTObjectPhi[i], "HLTObjectPhi");
   }
-  fTPUWeightTotal.reset(new float(-999.99));
-  fTPUWeightInTime.reset(new float(-999.99));
-  fTMassGlu.reset(new float(-999.99));
-  fTMassChi.reset(new float(-999.99));
-  fTMassLSP.reset(new float(-999.99));
-  fTxSMS.reset(new float(-999.99));
-  fTxbarSMS.reset(new float(-999.99));
-  fTM0.reset(new float(-999.99));
-  fTM12.reset(new float(-999.99));
-  fTsignMu.reset(new float(-999.99));
-  fTA0.reset(new float(-999.99));
-  fTprocess.reset(new int(-999));
-
-  fTPhoVrtxListStart.reset(new std::vector<int>);
-  fTJVrtxListStart.reset(new std::vector<int>);
-
-  fTMaxGenPartExceed.reset(new int(-999));
-  fTnGenParticles.reset(new int(0));
-  fTgenInfoId.reset(new std::vector<int>);
-  fTgenInfoStatus.reset(new std::vector<int>);
-  fTgenInfoNMo.reset(new std::vector<int>);
-  fTgenInfoMo1.reset(new std::vector<int>);
-  fTgenInfoMo2.reset(new std::vector<int>);
-  fTPromptnessLevel.reset(new std::vector<int>);
-  fTgenInfoPt.reset(new std::vector<float>);
-  fTgenInfoEta.reset(new std::vector<float>);
-  fTgenInfoPhi.reset(new std::vector<float>);
-  fTgenInfoM.reset(new std::vector<float>);
-  fTgenInfoPromptFlag.reset(new std::vector<float>);
-
-  fTPrimVtxGood.reset(new int(-999));
-  fTPrimVtxx.reset(new float(-999.99));
-  fTPrimVtxy.reset(new float(-999.99));
-  fTPrimVtxz.reset(new float(-999.99));
-  fTPrimVtxRho.reset(new float(-999.99));
-  fTPrimVtxxE.reset(new float(-999.99));
-  fTPrimVtxyE.reset(new float(-999.99));
-  fTPrimVtxzE.reset(new float(-999.99));
-  fTPrimVtxNChi2.reset(new float(-999.99));
-  fTPrimVtxNdof.reset(new float(-999.99));
-  fTPrimVtxIsFake.reset(new int(-999));
-  fTPrimVtxPtSum.reset(new float(-999.99));
-  fTBeamspotx.reset(new float(-999.99));
-  fTBeamspoty.reset(new float(-999.99));
-  fTBeamspotz.reset(new float(-999.99));
-  fTNCaloTowers.reset(new int(0));
-  fTGoodEvent.reset(new int(0));
-  fTMaxMuExceed.reset(new int(0));
-  fTMaxElExceed.reset(new int(0));
-  fTMaxJetExceed.reset(new int(0));
-  fTMaxUncJetExceed.reset(new int(0));
-  fTMaxTrkExceed.reset(new int(0));
-  fTMaxPhotonsExceed.reset(new int(0));
-  fTMaxGenLepExceed.reset(new int(0));
-  fTMaxGenPhoExceed.reset(new int(0));
-  fTMaxGenJetExceed.reset(new int(0));
-  fTMaxVerticesExceed.reset(new int(0));
-  fTCSCTightHaloID.reset(new int(-999));
-  fTPFType1MET.reset(new float(-999.99));
-  fTPFType1METpx.reset(new float(-999.99));
-  fTPFType1METpy.reset(new float(-999.99));
-  fTPFType1METphi.reset(new float(-999.99));
-  fTPFType1METSignificance.reset(new float(-999.99));
-  fTPFType1SumEt.reset(new float(-999.99));
+
   //FR fPBNRFlag.reset(new int(-999));
-  fTNGenLeptons.reset(new int(0));
-  fTGenLeptonID.reset(new std::vector<int> );
-  fTGenLeptonPt.reset(new std::vector<float> );
-  fTGenLeptonEta.reset(new std::vector<float> );
-  fTGenLeptonPhi.reset(new std::vector<float> );
-  fTGenLeptonMID.reset(new std::vector<int> );
-  fTGenLeptonMStatus.reset(new std::vector<int> );
-  fTGenLeptonMPt.reset(new std::vector<float> );
-  fTGenLeptonMEta.reset(new std::vector<float> );
-  fTGenLeptonMPhi.reset(new std::vector<float> );
-  fTGenLeptonGMID.reset(new std::vector<int> );
-  fTGenLeptonGMStatus.reset(new std::vector<int> );
-  fTGenLeptonGMPt.reset(new std::vector<float> );
-  fTGenLeptonGMEta.reset(new std::vector<float> );
-  fTGenLeptonGMPhi.reset(new std::vector<float> );
-  fTNGenPhotons.reset(new int(0));
-  fTGenPhotonPt.reset(new std::vector<float> );
-  fTGenPhotonEta.reset(new std::vector<float> );
-  fTGenPhotonPhi.reset(new std::vector<float> );
-  fTGenPhotonVx.reset(new std::vector<float> );
-  fTGenPhotonVy.reset(new std::vector<float> );
-  fTGenPhotonVz.reset(new std::vector<float> );
-  fTGenPhotonPartonMindR.reset(new std::vector<float> );
-  fTGenPhotonMotherID.reset(new std::vector<int> );
-  fTGenPhotonMotherStatus.reset(new std::vector<int> );
-  fTNGenJets.reset(new int(0));
-  fTGenJetPt.reset(new std::vector<float> );
-  fTGenJetEta.reset(new std::vector<float> );
-  fTGenJetPhi.reset(new std::vector<float> );
-  fTGenJetE.reset(new std::vector<float> );
-  fTGenJetEmE.reset(new std::vector<float> );
-  fTGenJetHadE.reset(new std::vector<float> );
-  fTGenJetInvE.reset(new std::vector<float> );
-  fTNVrtx.reset(new int(0));
-  fTVrtxX.reset(new std::vector<float> );
-  fTVrtxY.reset(new std::vector<float> );
-  fTVrtxZ.reset(new std::vector<float> );
-  fTVrtxXE.reset(new std::vector<float> );
-  fTVrtxYE.reset(new std::vector<float> );
-  fTVrtxZE.reset(new std::vector<float> );
-  fTVrtxNdof.reset(new std::vector<float> );
-  fTVrtxChi2.reset(new std::vector<float> );
-  fTVrtxNtrks.reset(new std::vector<float> );
-  fTVrtxSumPt.reset(new std::vector<float> );
-  fTVrtxIsFake.reset(new std::vector<int> );
-
-  fTNMus.reset(new int(0));
-  fTNMusTot.reset(new int(0));
-  fTNGMus.reset(new int(0));
-  fTNTMus.reset(new int(0));
-  fTMuGood.reset(new std::vector<int> );
-  fTMuIsIso.reset(new std::vector<int> );
-  fTMuIsGlobalMuon.reset(new std::vector<int> );
-  fTMuIsTrackerMuon.reset(new std::vector<int> );
-  fTMuIsPFMuon.reset(new std::vector<int> );
-  fTMuIsStandaloneMuon.reset(new std::vector<int> );
-  fTMuPx.reset(new std::vector<float> );
-  fTMuPy.reset(new std::vector<float> );
-  fTMuPz.reset(new std::vector<float> );
-  fTMuPt.reset(new std::vector<float> );
-  fTMuInnerTkPt.reset(new std::vector<float> );
-  fTMuE.reset(new std::vector<float> );
-  fTMuEt.reset(new std::vector<float> );
-  fTMuEta.reset(new std::vector<float> );
-  fTMuPhi.reset(new std::vector<float> );
-  fTMuCharge.reset(new std::vector<int> );
-  fTMuRelIso03.reset(new std::vector<float> );
-  fTMuIso03SumPt.reset(new std::vector<float> );
-  fTMuIso03EmEt.reset(new std::vector<float> );
-  fTMuIso03HadEt.reset(new std::vector<float> );
-  fTMuIso03EMVetoEt.reset(new std::vector<float> );
-  fTMuIso03HadVetoEt.reset(new std::vector<float> );
-  fTMuIso05SumPt.reset(new std::vector<float> );
-  fTMuIso05EmEt.reset(new std::vector<float> );
-  fTMuIso05HadEt.reset(new std::vector<float> );
-  fTMuPfIsoR03ChHad  .reset(new std::vector<float> );
-  fTMuPfIsoR03NeHad  .reset(new std::vector<float> );
-  fTMuPfIsoR03Photon .reset(new std::vector<float> );
-  fTMuPfIsoR03NeHadHighThresh  .reset(new std::vector<float> );
-  fTMuPfIsoR03PhotonHighThresh .reset(new std::vector<float> );
-  fTMuPfIsoR03SumPUPt.reset(new std::vector<float> );
-  fTMuPfIsoR04ChHad  .reset(new std::vector<float> );
-  fTMuPfIsoR04NeHad  .reset(new std::vector<float> );
-  fTMuPfIsoR04Photon .reset(new std::vector<float> );
-  fTMuPfIsoR04NeHadHighThresh  .reset(new std::vector<float> );
-  fTMuPfIsoR04PhotonHighThresh .reset(new std::vector<float> );
-  fTMuPfIsoR04SumPUPt.reset(new std::vector<float> );
+
   size_t ipfisotag = 0;
   for ( std::vector<edm::InputTag>::const_iterator it = fMuonPfIsoTagsCustom.begin();
         it != fMuonPfIsoTagsCustom.end(); ++it ) {
-    fTMuPfIsosCustom[ipfisotag++].reset(new std::vector<float> );
+    fBufferPool.reset(fTMuPfIsosCustom[ipfisotag++], "MuPfIsosCustom");
   }
-  fTMuEem.reset(new std::vector<float> );
-  fTMuEhad.reset(new std::vector<float> );
-  fTMuD0BS.reset(new std::vector<float> );
-  fTMuD0PV.reset(new std::vector<float> );
-  fTMuD03DPV.reset(new std::vector<float> );
-  fTMuD03DE.reset(new std::vector<float> );
-  fTMuDzBS.reset(new std::vector<float> );
-  fTMuDzPV.reset(new std::vector<float> );
-  fTMuTkPtE.reset(new std::vector<float> );
-  fTMuTkD0E.reset(new std::vector<float> );
-  fTMuTkDzE.reset(new std::vector<float> );
-  fTMuPtE.reset(new std::vector<float> );
-  fTMuD0E.reset(new std::vector<float> );
-  fTMuDzE.reset(new std::vector<float> );
-  fTMuNChi2.reset(new std::vector<float> );
-  fTMuNGlHits.reset(new std::vector<int> );
-  fTMuNGlMuHits.reset(new std::vector<int> );
-  fTMuNMuHits.reset(new std::vector<int> );
-  fTMuNTkHits.reset(new std::vector<int> );
-  fTMuNPxHits.reset(new std::vector<int> );
-  fTMuInnerTkNChi2.reset(new std::vector<float> );
-  fTMuNSiLayers.reset(new std::vector<int> );
-  fTMuNMatches.reset(new std::vector<int> );
-  fTMuNMatchedStations.reset(new std::vector<int> );
-  fTMuNChambers.reset(new std::vector<int> );
-  fTMuIsoMVA.reset(new std::vector<float> );
-  fTMuCaloComp.reset(new std::vector<float> );
-  fTMuSegmComp.reset(new std::vector<float> );
-  fTMuIsGMPT.reset(new std::vector<int> );
-  fTMuIsGMTkChiComp.reset(new std::vector<int> );
-  fTMuIsGMStaChiComp.reset(new std::vector<int> );
-  fTMuIsGMTkKinkTight.reset(new std::vector<int> );
-  fTMuIsAllStaMuons.reset(new std::vector<int> );
-  fTMuIsAllTrkMuons.reset(new std::vector<int> );
-  fTMuIsTrkMuonArbitrated.reset(new std::vector<int> );
-  fTMuIsAllArbitrated.reset(new std::vector<int> );
-  fTMuIsTMLSLoose.reset(new std::vector<int> );
-  fTMuIsTMLSTight.reset(new std::vector<int> );
-  fTMuIsTM2DCompLoose.reset(new std::vector<int> );
-  fTMuIsTM2DCompTight.reset(new std::vector<int> );
-  fTMuIsTMOneStationLoose.reset(new std::vector<int> );
-  fTMuIsTMOneStationTight.reset(new std::vector<int> );
-  fTMuIsTMLSOptLowPtLoose.reset(new std::vector<int> );
-  fTMuIsTMLSAngLoose.reset(new std::vector<int> );
-  fTMuIsTMLSAngTight.reset(new std::vector<int> );
-  fTMuIsTMOneStationAngTight.reset(new std::vector<int> );
-  fTMuIsTMOneStationAngLoose.reset(new std::vector<int> );
-  fTMuGenID.reset(new std::vector<int> );
-  fTMuGenStatus.reset(new std::vector<int> );
-  fTMuGenPt.reset(new std::vector<float> );
-  fTMuGenEta.reset(new std::vector<float> );
-  fTMuGenPhi.reset(new std::vector<float> );
-  fTMuGenE.reset(new std::vector<float> );
-  fTMuGenMID.reset(new std::vector<int> );
-  fTMuGenMStatus.reset(new std::vector<int> );
-  fTMuGenMPt.reset(new std::vector<float> );
-  fTMuGenMEta.reset(new std::vector<float> );
-  fTMuGenMPhi.reset(new std::vector<float> );
-  fTMuGenME.reset(new std::vector<float> );
-  fTMuGenGMID.reset(new std::vector<int> );
-  fTMuGenGMStatus.reset(new std::vector<int> );
-  fTMuGenGMPt.reset(new std::vector<float> );
-  fTMuGenGMEta.reset(new std::vector<float> );
-  fTMuGenGMPhi.reset(new std::vector<float> );
-  fTMuGenGME.reset(new std::vector<float> );
-  fTNEBhits.reset(new int(0));
-  fTEBrechitE.reset(new std::vector<float> );
-  fTEBrechitPt.reset(new std::vector<float> );
-  fTEBrechitEta.reset(new std::vector<float> );
-  fTEBrechitPhi.reset(new std::vector<float> );
-  fTEBrechitChi2.reset(new std::vector<float> );
-  fTEBrechitTime.reset(new std::vector<float> );
-  fTEBrechitE4oE1.reset(new std::vector<float> );
-  fTEBrechitE2oE9.reset(new std::vector<float> );
-  fTNEles.reset(new int(0));
-  fTNElesTot.reset(new int(0));
-  fTElGood.reset(new std::vector<int> );
-  fTElIsIso.reset(new std::vector<int> );
-  fTElChargeMisIDProb.reset(new std::vector<int> );
-  fTElPx.reset(new std::vector<float> );
-  fTElPy.reset(new std::vector<float> );
-  fTElPz.reset(new std::vector<float> );
-  fTElPt.reset(new std::vector<float> );
-  fTElPtE.reset(new std::vector<float> );
-  fTElE.reset(new std::vector<float> );
-  fTElEt.reset(new std::vector<float> );
-  fTElEta.reset(new std::vector<float> );
-  fTElTheta.reset(new std::vector<float> );
-  fTElSCEta.reset(new std::vector<float> );
-  fTElPhi.reset(new std::vector<float> );
-  fTElIsEB.reset(new std::vector<int> );
-  fTElIsEE.reset(new std::vector<int> );
-  fTElGsfTkPt.reset(new std::vector<float> );
-  fTElGsfTkEta.reset(new std::vector<float> );
-  fTElGsfTkPhi.reset(new std::vector<float> );
-  fTElTrkMomentumError.reset(new std::vector<float> );
-  fTElEcalEnergyError.reset(new std::vector<float> );
-  fTElEleMomentumError.reset(new std::vector<float> );
-  fTElNBrems.reset(new std::vector<int> );
-  fTElD0BS.reset(new std::vector<float> );
-  fTElD0PV.reset(new std::vector<float> );
-  fTElD0E.reset(new std::vector<float> );
-  fTElD03DPV.reset(new std::vector<float> );
-  fTElD03DE.reset(new std::vector<float> );
-  fTElDzBS.reset(new std::vector<float> );
-  fTElDzPV.reset(new std::vector<float> );
-  fTElDzE.reset(new std::vector<float> );
-  fTElRelIso03.reset(new std::vector<float> );
-  fTElRelIso04.reset(new std::vector<float> );
-  fTElPfIsoChHad03.reset(new std::vector<float> );
-  fTElPfIsoNeHad03.reset(new std::vector<float> );
-  fTElPfIsoPhoton03.reset(new std::vector<float> );
-  fTElDR03TkSumPt.reset(new std::vector<float> );
-  fTElDR04TkSumPt.reset(new std::vector<float> );
-  fTElDR03EcalRecHitSumEt.reset(new std::vector<float> );
-  fTElDR04EcalRecHitSumEt.reset(new std::vector<float> );
-  fTElDR03HcalTowerSumEt.reset(new std::vector<float> );
-  fTElDR04HcalTowerSumEt.reset(new std::vector<float> );
   ipfisotag = 0;
   for ( std::vector<edm::InputTag>::const_iterator it = fElePfIsoTagsCustom.begin();
         it != fElePfIsoTagsCustom.end(); ++it ) {
-    fTElPfIsosCustom[ipfisotag++].reset(new std::vector<float> );
+    fBufferPool.reset(fTElPfIsosCustom[ipfisotag++], "ElPfIsosCustom");
   }
   ipfisotag = 0;
   for ( std::vector<edm::InputTag>::const_iterator it = fElePfIsoTagsEvent.begin();
         it != fElePfIsoTagsEvent.end(); ++it ) {
-    fTElPfIsosEvent[ipfisotag++].reset(new std::vector<float> );
+    fBufferPool.reset(fTElPfIsosEvent[ipfisotag++], "ElPfIsosEvent");
   }
-  fTElNChi2.reset(new std::vector<float> );
-  fTElKfTrkchi2.reset(new std::vector<float> );
-  fTElKfTrkhits.reset(new std::vector<float> );
-  fTElCharge.reset(new std::vector<int> );
-  fTElCInfoIsGsfCtfCons.reset(new std::vector<int> );
-  fTElCInfoIsGsfCtfScPixCons.reset(new std::vector<int> );
-  fTElCInfoIsGsfScPixCons.reset(new std::vector<int> );
-  fTElScPixCharge.reset(new std::vector<int> );
-  fTElClosestCtfTrackPt.reset(new std::vector<float> );
-  fTElClosestCtfTrackEta.reset(new std::vector<float> );
-  fTElClosestCtfTrackPhi.reset(new std::vector<float> );
-  fTElClosestCtfTrackCharge.reset(new std::vector<int> );
-  fTElIDMva.reset(new std::vector<float> );
-  fTElIDMVATrig.reset(new std::vector<float> );
-  fTElIDMVANoTrig.reset(new std::vector<float> );
-  fTElInGap.reset(new std::vector<int> );
-  fTElEcalDriven.reset(new std::vector<int> );
-  fTElTrackerDriven.reset(new std::vector<int> );
-  fTElBasicClustersSize.reset(new std::vector<int> );
-  fTElfbrem.reset(new std::vector<float> );
-  fTElHcalOverEcal.reset(new std::vector<float> );
-  fTElHcalOverEcalBc.reset(new std::vector<float> );
-  fTElE1x5.reset(new std::vector<float> );
-  fTElE5x5.reset(new std::vector<float> );
-  fTElE2x5Max.reset(new std::vector<float> );
-  fTElR9.reset(new std::vector<float> );
-  fTElSigmaIetaIeta.reset(new std::vector<float> );
-  fTElSigmaIphiIphi.reset(new std::vector<float> );
-  fTElScEtaWidth.reset(new std::vector<float> );
-  fTElScPhiWidth.reset(new std::vector<float> );
-  fTElDeltaPhiSeedClusterAtCalo.reset(new std::vector<float> );
-  fTElDeltaEtaSeedClusterAtCalo.reset(new std::vector<float> );
-  fTElDeltaPhiSuperClusterAtVtx.reset(new std::vector<float> );
-  fTElDeltaEtaSuperClusterAtVtx.reset(new std::vector<float> );
-  fTElCaloEnergy.reset(new std::vector<float> );
-  fTElTrkMomAtVtx.reset(new std::vector<float> );
-  fTElESuperClusterOverP.reset(new std::vector<float> );
-  fTElIoEmIoP.reset(new std::vector<float> );
-  fTElEoPout.reset(new std::vector<float> );
-  fTElPreShowerOverRaw.reset(new std::vector<float> );
-  fTElNumberOfMissingInnerHits.reset(new std::vector<int> );
-  fTElSCindex.reset(new std::vector<int> );
-  fTElConvPartnerTrkDist.reset(new std::vector<float> );
-  fTElPassConversionVeto.reset(new std::vector<bool>);
-  fTElConvPartnerTrkDCot.reset(new std::vector<float> );
-  fTElConvPartnerTrkPt.reset(new std::vector<float> );
-  fTElConvPartnerTrkEta.reset(new std::vector<float> );
-  fTElConvPartnerTrkPhi.reset(new std::vector<float> );
-  fTElConvPartnerTrkCharge.reset(new std::vector<float> );
-  fTElScSeedSeverity.reset(new std::vector<int> );
-  fTElE1OverE9.reset(new std::vector<float> );
-  fTElS4OverS1.reset(new std::vector<float> );
-  fTElGenID.reset(new std::vector<int> );
-  fTElGenStatus.reset(new std::vector<int> );
-  fTElGenPt.reset(new std::vector<float> );
-  fTElGenEta.reset(new std::vector<float> );
-  fTElGenPhi.reset(new std::vector<float> );
-  fTElGenE.reset(new std::vector<float> );
-  fTElGenMID.reset(new std::vector<int> );
-  fTElGenMStatus.reset(new std::vector<int> );
-  fTElGenMPt.reset(new std::vector<float> );
-  fTElGenMEta.reset(new std::vector<float> );
-  fTElGenMPhi.reset(new std::vector<float> );
-  fTElGenME.reset(new std::vector<float> );
-  fTElGenGMID.reset(new std::vector<int> );
-  fTElGenGMStatus.reset(new std::vector<int> );
-  fTElGenGMPt.reset(new std::vector<float> );
-  fTElGenGMEta.reset(new std::vector<float> );
-  fTElGenGMPhi.reset(new std::vector<float> );
-  fTElGenGME.reset(new std::vector<float> );
-  fTPhoPassConversionVeto.reset(new std::vector<bool>);
-  fTNPhotons.reset(new int(0));
-  fTNPhotonsTot.reset(new int(0));
-  fTPhoGood.reset(new std::vector<int> );
-  fTPhoIsIso.reset(new std::vector<int> );
-  fTPhoPt.reset(new std::vector<float> );
-  fTPhoPx.reset(new std::vector<float> );
-  fTPhoPy.reset(new std::vector<float> );
-  fTPhoPz.reset(new std::vector<float> );
-  fTPhoEta.reset(new std::vector<float> );
-  fTPhoPhi.reset(new std::vector<float> );
-  fTPhoEnergy.reset(new std::vector<float> );
-  fTPhoIso03Ecal.reset(new std::vector<float> );
-  fTPhoIso03Hcal.reset(new std::vector<float> );
-  fTPhoIso03TrkSolid.reset(new std::vector<float> );
-  fTPhoIso03TrkHollow.reset(new std::vector<float> );
-  fTPhoIso03.reset(new std::vector<float> );
-  fTPhoIso04Ecal.reset(new std::vector<float> );
-  fTPhoIso04Hcal.reset(new std::vector<float> );
-  fTPhoIso04TrkSolid.reset(new std::vector<float> );
-  fTPhoIso04TrkHollow.reset(new std::vector<float> );
-  fTPhoIso04.reset(new std::vector<float> );
-  fTPhoR9.reset(new std::vector<float> );
-  fTPhoCaloPositionX.reset(new std::vector<float> );
-  fTPhoCaloPositionY.reset(new std::vector<float> );
-  fTPhoCaloPositionZ.reset(new std::vector<float> );
-  fTPhoHoverE.reset(new std::vector<float> );
-  fTPhoH1overE.reset(new std::vector<float> );
-  fTPhoH2overE.reset(new std::vector<float> );
-  fTPhoHoverE2012.reset(new std::vector<float> );
-  fTPhoSigmaIetaIeta.reset(new std::vector<float> );
-  fTPhoSigmaIetaIphi.reset(new std::vector<float> );
-  fTPhoSigmaIphiIphi.reset(new std::vector<float> );
-  fTPhoS4Ratio.reset(new std::vector<float> );
-  fTPhoLambdaRatio.reset(new std::vector<float> );
-  fTPhoSCRawEnergy.reset(new std::vector<float> );
-  fTPhoSCEtaWidth.reset(new std::vector<float> );
-  fTPhoSCSigmaPhiPhi.reset(new std::vector<float> );
-  fTPhoHasPixSeed.reset(new std::vector<int> );
-  fTPhoHasConvTrks.reset(new std::vector<int> );
-  fTPhoScSeedSeverity.reset(new std::vector<int> );
-  fTPhoE1OverE9.reset(new std::vector<float> );
-  fTPhoS4OverS1.reset(new std::vector<float> );
-  fTPhoSigmaEtaEta.reset(new std::vector<float> );
-  fTPhoSigmaRR.reset(new std::vector<float> );
-  fTPhoHCalIso2012ConeDR03.reset(new std::vector<float> );
-  fTPhoNewIsoPFCharged.reset(new std::vector<float> );
-  fTPhoNewIsoPFPhoton.reset(new std::vector<float> );
-  fTPhoNewIsoPFNeutral.reset(new std::vector<float> );
-  fTPhoE1x5.reset(new std::vector<float> );
-  fTPhoE2x5.reset(new std::vector<float> );
-  fTPhoE3x3.reset(new std::vector<float> );
-  fTPhoE5x5.reset(new std::vector<float> );
-  fTPhomaxEnergyXtal.reset(new std::vector<float> );
-  fTPhoIso03HcalDepth1.reset(new std::vector<float> );
-  fTPhoIso03HcalDepth2.reset(new std::vector<float> );
-  fTPhoIso04HcalDepth1.reset(new std::vector<float> );
-  fTPhoIso04HcalDepth2.reset(new std::vector<float> );
-  fTPhoIso03nTrksSolid.reset(new std::vector<int> );
-  fTPhoIso03nTrksHollow.reset(new std::vector<int> );
-  fTPhoIso04nTrksSolid.reset(new std::vector<int> );
-  fTPhoIso04nTrksHollow.reset(new std::vector<int> );
-  fTPhoisEB.reset(new std::vector<int> );
-  fTPhoisEE.reset(new std::vector<int> );
-  fTPhoisEBEtaGap.reset(new std::vector<int> );
-  fTPhoisEBPhiGap.reset(new std::vector<int> );
-  fTPhoisEERingGap.reset(new std::vector<int> );
-  fTPhoisEEDeeGap.reset(new std::vector<int> );
-  fTPhoisEBEEGap.reset(new std::vector<int> );
-  fTPhoisPFlowPhoton.reset(new std::vector<int> );
-  fTPhoisStandardPhoton.reset(new std::vector<int> );
-  fTPhoMCmatchindex.reset(new std::vector<int> );
-  fTPhoMCmatchexitcode.reset(new std::vector<int> );
-  fTPhoChargedHadronIso.reset(new std::vector<float> );
-  fTPhoNeutralHadronIso.reset(new std::vector<float> );
-  fTPhoPhotonIso.reset(new std::vector<float> );
-  fTPhoisPFPhoton.reset(new std::vector<int> );
-  fTPhoisPFElectron.reset(new std::vector<int> );
-  fTPhotSCindex.reset(new std::vector<int> );
 //  fTPhoCone04PhotonIsodR0dEta0pt0.reset(new std::vector<float> );
 //  fTPhoCone04PhotonIsodR0dEta0pt5.reset(new std::vector<float> );
 //  fTPhoCone04PhotonIsodR8dEta0pt0.reset(new std::vector<float> );
@@ -5131,33 +4378,19 @@ void NTupleProducer::resetProducts( void ) {
 //  fTPhoCone04ChargedHadronIsodR015dEta0pt0dz0.reset(new std::vector<float> );
 //  fTPhoCone04ChargedHadronIsodR015dEta0pt0dz1dxy01.reset(new std::vector<float> );
 //  fTPhoCone04ChargedHadronIsodR015dEta0pt0PFnoPU.reset(new std::vector<float> );
-  fTPhoCiCPFIsoChargedDR03.reset(new std::vector<float> );
-  fTPhoCiCPFIsoNeutralDR03.reset(new std::vector<float> );
-  fTPhoCiCPFIsoPhotonDR03.reset(new std::vector<float> );
-  fTPhoCiCPFIsoChargedDR04.reset(new std::vector<float> );
-  fTPhoCiCPFIsoNeutralDR04.reset(new std::vector<float> );
-  fTPhoCiCPFIsoPhotonDR04.reset(new std::vector<float> );
-  fTPhoSCX.reset(new std::vector<float> );
-  fTPhoSCY.reset(new std::vector<float> );
-  fTPhoSCZ.reset(new std::vector<float> );
-  fTPhoSCEta.reset(new std::vector<float> );
-  fTPhoSCPhiWidth.reset(new std::vector<float> );
-  fTPhoIDMVA.reset(new std::vector<float> );
-  fTPhoConvValidVtx.reset(new std::vector<bool>);
-  fTPhoConvNtracks.reset(new std::vector<int>);
-  fTPhoConvChi2Probability.reset(new std::vector<float>);
-  fTPhoConvEoverP.reset(new std::vector<float>);
+  fBufferPool.reset(fTPhoSCX, "PhoSCX");
+  fBufferPool.reset(fTPhoSCY, "PhoSCY");
+  fBufferPool.reset(fTPhoSCZ, "PhoSCZ");
+  fBufferPool.reset(fTPhoConvValidVtx, "PhoConvValidVtx");
+  fBufferPool.reset(fTPhoConvNtracks, "PhoConvNtracks");
+  fBufferPool.reset(fTPhoConvChi2Probability, "PhoConvChi2Probability");
+  fBufferPool.reset(fTPhoConvEoverP, "PhoConvEoverP");
   fTNconv.reset(new int(0));
-  fTConvValidVtx.reset(new std::vector<bool>);
-  fTConvNtracks.reset(new std::vector<int>);
-  fTConvChi2Probability.reset(new std::vector<float>);
-  fTConvEoverP.reset(new std::vector<float>);
-  fTConvZofPrimVtxFromTrks.reset(new std::vector<float>);
-  fTNgv.reset(new int(0));
-  fTgvSumPtHi.reset(new std::vector<float>);
-  fTgvSumPtLo.reset(new std::vector<float>);
-  fTgvNTkHi.reset(new std::vector<int>);
-  fTgvNTkLo.reset(new std::vector<int>);
+  fBufferPool.reset(fTConvValidVtx, "ConvValidVtx");
+  fBufferPool.reset(fTConvNtracks, "ConvNtracks");
+  fBufferPool.reset(fTConvChi2Probability, "ConvChi2Probability");
+  fBufferPool.reset(fTConvEoverP, "ConvEoverP");
+  fBufferPool.reset(fTConvZofPrimVtxFromTrks, "ConvZofPrimVtxFromTrks");
   for (int i=0; i<gMaxNPhotons; i++) {
     pho_conv_vtx[i]=TVector3();
     pho_conv_refitted_momentum[i]=TVector3();
@@ -5169,214 +4402,22 @@ void NTupleProducer::resetProducts( void ) {
     gv_pos[i]=TVector3();
     gv_p3[i]=TVector3();
   }
-  fTNGoodSuperClusters.reset(new int(0));
-  fTGoodSCEnergy.reset(new std::vector<float> );
-  fTGoodSCEta.reset(new std::vector<float> );
-  fTGoodSCPhi.reset(new std::vector<float> );
-  fTNSuperClusters.reset(new int(0));
-  fTSCRaw.reset(new std::vector<float> );
-  fTSCPre.reset(new std::vector<float> );
-  fTSCEnergy.reset(new std::vector<float> );
-  fTSCEta.reset(new std::vector<float> );
-  fTSCPhi.reset(new std::vector<float> );
-  fTSCPhiWidth.reset(new std::vector<float> );
-  fTSCEtaWidth.reset(new std::vector<float> );
-  fTSCBrem.reset(new std::vector<float> );
-  fTSCR9.reset(new std::vector<float> );
-  fTSCcrackcorrseed.reset(new std::vector<float> );
-  fTSCcrackcorr.reset(new std::vector<float> );
-  fTSClocalcorrseed.reset(new std::vector<float> );
-  fTSClocalcorr.reset(new std::vector<float> );
-  fTSCcrackcorrseedfactor.reset(new std::vector<float> );
-  fTSClocalcorrseedfactor.reset(new std::vector<float> );
-  fTNJets.reset(new int(0));
-  fTNJetsTot.reset(new int(0));
-  fTJGood.reset(new std::vector<int> );
-  fTJPx.reset(new std::vector<float> );
-  fTJPy.reset(new std::vector<float> );
-  fTJPz.reset(new std::vector<float> );
-  fTJPt.reset(new std::vector<float> );
-  fTJE.reset(new std::vector<float> );
-  fTJEt.reset(new std::vector<float> );
-  fTJEta.reset(new std::vector<float> );
-  fTJPhi.reset(new std::vector<float> );
-  fTJEcorr.reset(new std::vector<float> );
-  fTJArea.reset(new std::vector<float> );
-  fTJEtaRms.reset(new std::vector<float> );
-  fTJPhiRms.reset(new std::vector<float> );
-  fTJNConstituents.reset(new std::vector<int> );
-  fTJNAssoTracks.reset(new std::vector<int> );
-  fTJNNeutrals.reset(new std::vector<int> );
-  fTJChargedEmFrac.reset(new std::vector<float> );
-  fTJNeutralEmFrac.reset(new std::vector<float> );
-  fTJChargedHadFrac.reset(new std::vector<float> );
-  fTJNeutralHadFrac.reset(new std::vector<float> );
-  fTJChargedMuEnergyFrac.reset(new std::vector<float> );
-  fTJPhoFrac.reset(new std::vector<float>);
-  fTJHFHadFrac.reset(new std::vector<float>);
-  fTJHFEMFrac.reset(new std::vector<float>);
-  fTJPtD.reset(new std::vector<float>);
-  fTJRMSCand.reset(new std::vector<float>);
-  fTJeMinDR.reset(new std::vector<float> );
   size_t ibtag = 0;
   for ( std::vector<edm::InputTag>::const_iterator it = fBtagTags.begin();
 	it != fBtagTags.end(); ++it ) {
-    fTJbTagProb[ibtag++].reset(new std::vector<float> );
+    fBufferPool.reset(fTJbTagProb[ibtag++], "JbTagProb");
   }
-  fTJPartonFlavour.reset(new std::vector<int> );
-  fTJMass.reset(new std::vector<float> );
-  fTJBetaStar.reset(new std::vector<float> );
-  fTJBeta.reset(new std::vector<float> );
-  fTJBetaSq.reset(new std::vector<float> );
-  fTJtrk1px.reset(new std::vector<float> );
-  fTJtrk1py.reset(new std::vector<float> );
-  fTJtrk1pz.reset(new std::vector<float> );
-  fTJtrk2px.reset(new std::vector<float> );
-  fTJtrk2py.reset(new std::vector<float> );
-  fTJtrk2pz.reset(new std::vector<float> );
-  fTJtrk3px.reset(new std::vector<float> );
-  fTJtrk3py.reset(new std::vector<float> );
-  fTJtrk3pz.reset(new std::vector<float> );
-  fTJVtxx.reset(new std::vector<float> );
-  fTJVtxy.reset(new std::vector<float> );
-  fTJVtxz.reset(new std::vector<float> );
-  fTJVtxExx.reset(new std::vector<float> );
-  fTJVtxEyx.reset(new std::vector<float> );
-  fTJVtxEyy.reset(new std::vector<float> );
-  fTJVtxEzy.reset(new std::vector<float> );
-  fTJVtxEzz.reset(new std::vector<float> );
-  fTJVtxEzx.reset(new std::vector<float> );
-  fTJVtxNChi2.reset(new std::vector<float> );
-  fTJGenJetIndex.reset(new std::vector<int> );
-  fTJMetCorrRawEta.reset(new std::vector<float> );
-  fTJMetCorrPhi.reset(new std::vector<float> );
-  fTJMetCorrNoMuPt.reset(new std::vector<float> );
-  fTJMetCorrRawPt.reset(new std::vector<float> );
-  fTJMetCorrEMF.reset(new std::vector<float> );
-  fTJMetCorrArea.reset(new std::vector<float> );
   for ( unsigned int i=0; i<gMaxNPileupJetIDAlgos; ++i ) {
-    fTJPassPileupIDL[i].reset(new std::vector<bool> );
-    fTJPassPileupIDM[i].reset(new std::vector<bool> );
-    fTJPassPileupIDT[i].reset(new std::vector<bool> );
+    fBufferPool.reset(fTJPassPileupIDL[i], "JPassPileupIDL");
+    fBufferPool.reset(fTJPassPileupIDM[i], "JPassPileupIDM");
+    fBufferPool.reset(fTJPassPileupIDT[i], "JPassPileupIDT");
   }
-  fTJQGTagLD.reset(new std::vector<float> );
-  fTJQGTagMLP.reset(new std::vector<float> );
-  fTJSmearedQGL.reset(new std::vector<float> );
-  fTNTracks.reset(new int(0));
-  fTNTracksTot.reset(new int(0));
-  fTTrkGood.reset(new std::vector<int> );
-  fTTrkPt.reset(new std::vector<float> );
-  fTTrkEta.reset(new std::vector<float> );
-  fTTrkPhi.reset(new std::vector<float> );
-  fTTrkNChi2.reset(new std::vector<float> );
-  fTTrkNHits.reset(new std::vector<float> );
-  fTTrkVtxDz.reset(new std::vector<float> );
-  fTTrkVtxDxy.reset(new std::vector<float> );
-  fTTrkPtSumx.reset(new float(-999.99));
-  fTTrkPtSumy.reset(new float(-999.99));
-  fTTrkPtSum.reset(new float(-999.99));
-  fTTrkPtSumPhi.reset(new float(-999.99));
-  fTSumEt.reset(new float(-999.99));
-  fTECALSumEt.reset(new float(-999.99));
-  fTHCALSumEt.reset(new float(-999.99));
-  fTECALEsumx.reset(new float(-999.99));
-  fTECALEsumy.reset(new float(-999.99));
-  fTECALEsumz.reset(new float(-999.99));
-  fTECALMET.reset(new float(-999.99));
-  fTECALMETPhi.reset(new float(-999.99));
-  fTECALMETEta.reset(new float(-999.99));
-  fTHCALEsumx.reset(new float(-999.99));
-  fTHCALEsumy.reset(new float(-999.99));
-  fTHCALEsumz.reset(new float(-999.99));
-  fTHCALMET.reset(new float(-999.99));
-  fTHCALMETPhi.reset(new float(-999.99));
-  fTHCALMETeta.reset(new float(-999.99));
-  fTRawMET.reset(new float(-999.99));
-  fTRawMETpx.reset(new float(-999.99));
-  fTRawMETpy.reset(new float(-999.99));
-  fTRawMETphi.reset(new float(-999.99));
-  fTRawMETemEtFrac.reset(new float(-999.99));
-  fTRawMETemEtInEB.reset(new float(-999.99));
-  fTRawMETemEtInEE.reset(new float(-999.99));
-  fTRawMETemEtInHF.reset(new float(-999.99));
-  fTRawMEThadEtFrac.reset(new float(-999.99));
-  fTRawMEThadEtInHB.reset(new float(-999.99));
-  fTRawMEThadEtInHE.reset(new float(-999.99));
-  fTRawMEThadEtInHF.reset(new float(-999.99));
-  fTRawMETSignificance.reset(new float(-999.99));
-  fTGenMET.reset(new float(-999.99));
-  fTGenMETpx.reset(new float(-999.99));
-  fTGenMETpy.reset(new float(-999.99));
-  fTGenMETphi.reset(new float(-999.99));
-  fTTCMET.reset(new float(-999.99));
-  fTTCMETpx.reset(new float(-999.99));
-  fTTCMETpy.reset(new float(-999.99));
-  fTTCMETphi.reset(new float(-999.99));
-  fTTCMETSignificance.reset(new float(-999.99));
-  fTMuJESCorrMET.reset(new float(-999.99));
-  fTMuJESCorrMETpx.reset(new float(-999.99));
-  fTMuJESCorrMETpy.reset(new float(-999.99));
-  fTMuJESCorrMETphi.reset(new float(-999.99));
-  fTPFMET.reset(new float(-999.99));
-  fTPFMETpx.reset(new float(-999.99));
-  fTPFMETpy.reset(new float(-999.99));
-  fTPFMETphi.reset(new float(-999.99));
-  fTPFMETSignificance.reset(new float(-999.99));
-  fTPFSumEt.reset(new float(-999.99));
-  fTMETR12.reset(new float(-999.99));
-  fTMETR21.reset(new float(-999.99));
-
-
-fTSigma.reset(new float(-999.99) );
-fTGenPhotonIsoDR03.reset(new std::vector<float>  );
-fTGenPhotonIsoDR04.reset(new std::vector<float>  );
-fTSCX.reset(new std::vector<float>  );
-fTSCY.reset(new std::vector<float>  );
-fTSCZ.reset(new std::vector<float>  );
-fTSCXtalListStart.reset(new std::vector<int>  );
-fTSCNXtals.reset(new std::vector<int>  );
-fTNXtals.reset(new int(0) );
-fTXtalX.reset(new std::vector<float> );
-fTXtalY.reset(new std::vector<float> );
-fTXtalZ.reset(new std::vector<float> );
-fTXtalEtaWidth.reset(new std::vector<float> );
-fTXtalPhiWidth.reset(new std::vector<float> );
-fTXtalFront1X.reset(new std::vector<float>  );
-fTXtalFront1Y.reset(new std::vector<float>  );
-fTXtalFront1Z.reset(new std::vector<float>  );
-fTXtalFront2X.reset(new std::vector<float>  );
-fTXtalFront2Y.reset(new std::vector<float>  );
-fTXtalFront2Z.reset(new std::vector<float>  );
-fTXtalFront3X.reset(new std::vector<float>  );
-fTXtalFront3Y.reset(new std::vector<float>  );
-fTXtalFront3Z.reset(new std::vector<float>  );
-fTXtalFront4X.reset(new std::vector<float>  );
-fTXtalFront4Y.reset(new std::vector<float>  );
-fTXtalFront4Z.reset(new std::vector<float>  );
-fTNPfCand.reset(new int(0) );
-fTPfCandPdgId.reset(new std::vector<int>  );
-fTPfCandEta.reset(new std::vector<float>  );
-fTPfCandPhi.reset(new std::vector<float>  );
-fTPfCandEnergy.reset(new std::vector<float>  );
-fTPfCandEcalEnergy.reset(new std::vector<float>  );
-fTPfCandPt.reset(new std::vector<float>  );
-fTPfCandVx.reset(new std::vector<float>  );
-fTPfCandVy.reset(new std::vector<float>  );
-fTPfCandVz.reset(new std::vector<float>  );
-fTPfCandBelongsToJet.reset(new std::vector<int>  );
+
+
 //fTPfCandHasHitInFirstPixelLayer.reset(new std::vector<int>  );
 //fTPfCandTrackRefPx.reset(new std::vector<float>  );
 //fTPfCandTrackRefPy.reset(new std::vector<float>  );
 //fTPfCandTrackRefPz.reset(new std::vector<float>  );
-fTPhoMatchedPFPhotonCand.reset(new std::vector<int>  );
-fTPhoMatchedPFElectronCand.reset(new std::vector<int>  );
-fTPhoFootprintPfCandsListStart.reset(new std::vector<int>  );
-fTPhoFootprintPfCands.reset(new std::vector<int>  );
-fTPhoVx.reset(new std::vector<float>  );
-fTPhoVy.reset(new std::vector<float>  );
-fTPhoVz.reset(new std::vector<float>  );
-fTPhoRegrEnergy.reset(new std::vector<float>  );
-fTPhoRegrEnergyErr.reset(new std::vector<float>  );
 //fTPhoCone01PhotonIsodEta015EBdR070EEmvVtx.reset(new std::vector<float>  );
 //fTPhoCone02PhotonIsodEta015EBdR070EEmvVtx.reset(new std::vector<float>  );
 //fTPhoCone03PhotonIsodEta015EBdR070EEmvVtx.reset(new std::vector<float>  );
@@ -5391,25 +4432,8 @@ fTPhoRegrEnergyErr.reset(new std::vector<float>  );
 //fTPhoCone04ChargedHadronIsodR02dz02dxy01.reset(new std::vector<float>  );
 //fTPhoCone03PFCombinedIso.reset(new std::vector<float>  );
 //fTPhoCone04PFCombinedIso.reset(new std::vector<float>  );
-fTDiphotonsfirst.reset(new std::vector<int>  );
-fTDiphotonssecond.reset(new std::vector<int>  );
-fTVtxdiphoh2gglobe.reset(new std::vector<int>  );
-fTVtxdiphomva.reset(new std::vector<int>  );
-fTVtxdiphoproductrank.reset(new std::vector<int>  );
-fTPhoSCRemovalPFIsoCharged.reset(new std::vector<float>  );
-fTPhoSCRemovalPFIsoChargedPrimVtx.reset(new std::vector<float>  );
-fTPhoSCRemovalPFIsoNeutral.reset(new std::vector<float>  );
-fTPhoSCRemovalPFIsoPhoton.reset(new std::vector<float>  );
-fTPhoSCRemovalPFIsoChargedRCone.reset(new std::vector<float>  );
-fTPhoSCRemovalPFIsoChargedPrimVtxRCone.reset(new std::vector<float>  );
-fTPhoSCRemovalPFIsoNeutralRCone.reset(new std::vector<float>  );
-fTPhoSCRemovalPFIsoPhotonRCone.reset(new std::vector<float>  );
-fTPhoSCRemovalRConeEta.reset(new std::vector<float>  );
-fTPhoSCRemovalRConePhi.reset(new std::vector<float>  );
 //MQ
 
-fTPhoSCRemovalPFIsoChargedVtxConst.reset(new std::vector<float>  );
-fTPhoSCRemovalPFIsoChargedVtxConstRCone.reset(new std::vector<float>  );
 
 }
 
@@ -5464,6 +4488,9 @@ void NTupleProducer::resetRunProducts( void ) {
   fRMaxNConv    .reset(new int(-999));
   fRMaxNPfCand  .reset(new int(-999));
   fRMaxNXtals .reset(new int(-999));
+  fRXtalGeomDetId.reset(new std::vector<unsigned int>);
+  fRXtalGeometry .reset(new std::vector<float>);
+  fXtalGeometry.clear();
 
   fRL1PhysMenu  .reset(new std::vector<std::string>);
 
@@ -5472,50 +4499,23 @@ void NTupleProducer::resetRunProducts( void ) {
 //________________________________________________________________________________________
 void NTupleProducer::putProducts( edm::Event& event ) {
   
-  event.put(fTRun,   "Run");
-  event.put(fTEvent, "Event");
-  event.put(fTLumiSection, "LumiSection");
-  event.put(fTPtHat, "PtHat");
-  event.put(fTQCDPartonicHT, "QCDPartonicHT");
-  event.put(fTLHEEventID, "LHEEventID");
-  event.put(fTLHEEventStatus, "LHEEventStatus");
-  event.put(fTLHEEventMotherFirst, "LHEEventMotherFirst");
-  event.put(fTLHEEventMotherSecond, "LHEEventMotherSecond");
-  event.put(fTLHEEventPx, "LHEEventPx");
-  event.put(fTLHEEventPy, "LHEEventPy");
-  event.put(fTLHEEventPz, "LHEEventPz");
-  event.put(fTLHEEventE,  "LHEEventE");
-  event.put(fTLHEEventM,  "LHEEventM");
-  event.put(fTSigProcID, "SigProcID");
-  event.put(fTPDFScalePDF, "PDFScalePDF");
-  event.put(fTPDFID1, "PDFID1");
-  event.put(fTPDFID2, "PDFID2");
-  event.put(fTPDFx1, "PDFx1");
-  event.put(fTPDFx2, "PDFx2");
-  event.put(fTPDFxPDF1, "PDFxPDF1");
-  event.put(fTPDFxPDF2, "PDFxPDF2");
-  event.put(fTGenWeight, "GenWeight");
-  event.put(fTpdfW, "pdfW");
-  event.put(fTpdfWsum, "pdfWsum");
-  event.put(fTNPdfs, "NPdfs");
-  event.put(fTPUnumInteractions, "PUnumInteractions");
-  event.put(fTPUnumTrueInteractions, "PUnumTrueInteractions");
-  event.put(fTPUnumFilled, "PUnumFilled");
-  event.put(fTPUOOTnumInteractionsEarly, "PUOOTnumInteractionsEarly");
-  event.put(fTPUOOTnumInteractionsLate, "PUOOTnumInteractionsLate");
-  event.put(fTPUzPositions, "PUzPositions");
-  event.put(fTPUsumPtLowPt, "PUsumPtLowPt");
-  event.put(fTPUsumPtHighPt, "PUsumPtHighPt");
-  event.put(fTPUnTrksLowPt, "PUnTrksLowPt");
-  event.put(fTPUnTrksHighPt, "PUnTrksHighPt");
-  event.put(fTRho,       "Rho");
-  event.put(fTRhoForIso, "RhoForIso");
-  event.put(fTWeight, "Weight");
-  event.put(fTHLTResults, "HLTResults");
-  event.put(fTHLTPrescale, "HLTPrescale");
-  event.put(fTL1PhysResults, "L1PhysResults");
-  event.put(fTL1TechResults, "L1TechResults");
-  event.put(fTNHLTObjs, "NHLTObjs");
+  fBufferPool.collect();
+
+  // Regular event products, see NTupleBranches.h
+#define NTP_SCALAR(type, name, init, precision, group, enabled) \
+  if (branchEnabled(enabled, NTupleBranches::k##group)) { \
+    NTupleBranches::applyPrecision(*fT##name, NTupleBranches::k##precision); \
+    event.put(fT##name, #name); \
+  }
+#define NTP_VECTOR(type, name, hint, precision, group, enabled) \
+  if (branchEnabled(enabled, NTupleBranches::k##group)) { \
+    NTupleBranches::applyPrecision(*fT##name, NTupleBranches::k##precision); \
+    event.put(fT##name, #name); \
+  }
+#include "DiLeptonAnalysis/NTupleProducer/interface/NTupleBranches.h"
+#undef NTP_SCALAR
+#undef NTP_VECTOR
+
   for ( size_t i=0; i<fTNpaths; ++i ) {
     std::ostringstream s;
     s << i;
@@ -5524,278 +4524,13 @@ void NTupleProducer::putProducts( edm::Event& event ) {
     event.put(fTHLTObjectEta[i], ("HLTObjectEta"+s.str()).c_str());
     event.put(fTHLTObjectPhi[i], ("HLTObjectPhi"+s.str()).c_str());
   }
-  event.put(fTPUWeightTotal, "PUWeightTotal");
-  event.put(fTPUWeightInTime, "PUWeightInTime");
-  event.put(fTMassGlu, "MassGlu");
-  event.put(fTMassChi, "MassChi");
-  event.put(fTMassLSP, "MassLSP");
-  event.put(fTxSMS, "xSMS");
-  event.put(fTxbarSMS, "xbarSMS");
-  event.put(fTM0, "M0");
-  event.put(fTM12, "M12");
-  event.put(fTsignMu, "signMu");
-  event.put(fTA0, "A0");
-  event.put(fTprocess, "process");
-  event.put(fTPhoVrtxListStart ,"PhoVrtxListStart");
-  event.put(fTJVrtxListStart, "JVrtxListStart");
-  event.put(fTMaxGenPartExceed,"MaxGenPartExceed");
-  event.put(fTnGenParticles,"nGenParticles");
-  event.put(fTgenInfoId,"genInfoId");
-  event.put(fTgenInfoStatus,"genInfoStatus");
-  event.put(fTgenInfoNMo,"genInfoNMo");
-  event.put(fTgenInfoMo1,"genInfoMo1");
-  event.put(fTgenInfoMo2,"genInfoMo2");
-  event.put(fTPromptnessLevel,"PromptnessLevel");
-  event.put(fTgenInfoPt,"genInfoPt");
-  event.put(fTgenInfoEta,"genInfoEta");
-  event.put(fTgenInfoPhi,"genInfoPhi");
-  event.put(fTgenInfoM,"genInfoM");
-  event.put(fTgenInfoPromptFlag,"genInfoPromptFlag");
-  event.put(fTPrimVtxGood, "PrimVtxGood");
-  event.put(fTPrimVtxx, "PrimVtxx");
-  event.put(fTPrimVtxy, "PrimVtxy");
-  event.put(fTPrimVtxz, "PrimVtxz");
-  event.put(fTPrimVtxRho, "PrimVtxRho");
-  event.put(fTPrimVtxxE, "PrimVtxxE");
-  event.put(fTPrimVtxyE, "PrimVtxyE");
-  event.put(fTPrimVtxzE, "PrimVtxzE");
-  event.put(fTPrimVtxNChi2, "PrimVtxNChi2");
-  event.put(fTPrimVtxNdof, "PrimVtxNdof");
-  event.put(fTPrimVtxIsFake, "PrimVtxIsFake");
-  event.put(fTPrimVtxPtSum, "PrimVtxPtSum");
-  event.put(fTBeamspotx, "Beamspotx");
-  event.put(fTBeamspoty, "Beamspoty");
-  event.put(fTBeamspotz, "Beamspotz");
-  event.put(fTNCaloTowers, "NCaloTowers");
-  event.put(fTGoodEvent, "GoodEvent");
-  event.put(fTMaxMuExceed, "MaxMuExceed");
-  event.put(fTMaxElExceed, "MaxElExceed");
-  event.put(fTMaxJetExceed, "MaxJetExceed");
-  event.put(fTMaxUncJetExceed, "MaxUncJetExceed");
-  event.put(fTMaxTrkExceed, "MaxTrkExceed");
-  event.put(fTMaxPhotonsExceed, "MaxPhotonsExceed");
-  event.put(fTMaxGenLepExceed, "MaxGenLepExceed");
-  event.put(fTMaxGenPhoExceed, "MaxGenPhoExceed");
-  event.put(fTMaxGenJetExceed, "MaxGenJetExceed");
-  event.put(fTMaxVerticesExceed, "MaxVerticesExceed");
-  event.put(fTCSCTightHaloID, "CSCTightHaloID");
-  event.put(fTPFType1MET, "PFType1MET");
-  event.put(fTPFType1METpx, "PFType1METpx");
-  event.put(fTPFType1METpy, "PFType1METpy");
-  event.put(fTPFType1METphi, "PFType1METphi");
-  event.put(fTPFType1METSignificance, "PFType1METSignificance");
-  event.put(fTPFType1SumEt, "PFType1SumEt");
   //FR event.put(fPBNRFlag,"PBNRFlag");
-  event.put(fTNGenLeptons, "NGenLeptons");
-  event.put(fTGenLeptonID, "GenLeptonID");
-  event.put(fTGenLeptonPt, "GenLeptonPt");
-  event.put(fTGenLeptonEta, "GenLeptonEta");
-  event.put(fTGenLeptonPhi, "GenLeptonPhi");
-  event.put(fTGenLeptonMID, "GenLeptonMID");
-  event.put(fTGenLeptonMStatus, "GenLeptonMStatus");
-  event.put(fTGenLeptonMPt, "GenLeptonMPt");
-  event.put(fTGenLeptonMEta, "GenLeptonMEta");
-  event.put(fTGenLeptonMPhi, "GenLeptonMPhi");
-  event.put(fTGenLeptonGMID, "GenLeptonGMID");
-  event.put(fTGenLeptonGMStatus, "GenLeptonGMStatus");
-  event.put(fTGenLeptonGMPt, "GenLeptonGMPt");
-  event.put(fTGenLeptonGMEta, "GenLeptonGMEta");
-  event.put(fTGenLeptonGMPhi, "GenLeptonGMPhi");
-  event.put(fTNGenPhotons, "NGenPhotons");
-  event.put(fTGenPhotonPt, "GenPhotonPt");
-  event.put(fTGenPhotonEta, "GenPhotonEta");
-  event.put(fTGenPhotonPhi, "GenPhotonPhi");
-  event.put(fTGenPhotonVx, "GenPhotonVx");
-  event.put(fTGenPhotonVy, "GenPhotonVy");
-  event.put(fTGenPhotonVz, "GenPhotonVz");
-  event.put(fTGenPhotonPartonMindR, "GenPhotonPartonMindR");
-  event.put(fTGenPhotonMotherID, "GenPhotonMotherID");
-  event.put(fTGenPhotonMotherStatus, "GenPhotonMotherStatus");
-  event.put(fTNGenJets, "NGenJets");
-  event.put(fTGenJetPt, "GenJetPt");
-  event.put(fTGenJetEta, "GenJetEta");
-  event.put(fTGenJetPhi, "GenJetPhi");
-  event.put(fTGenJetE, "GenJetE");
-  event.put(fTGenJetEmE, "GenJetEmE");
-  event.put(fTGenJetHadE, "GenJetHadE");
-  event.put(fTGenJetInvE, "GenJetInvE");
-  event.put(fTNVrtx, "NVrtx");
-  event.put(fTVrtxX, "VrtxX");
-  event.put(fTVrtxY, "VrtxY");
-  event.put(fTVrtxZ, "VrtxZ");
-  event.put(fTVrtxXE, "VrtxXE");
-  event.put(fTVrtxYE, "VrtxYE");
-  event.put(fTVrtxZE, "VrtxZE");
-  event.put(fTVrtxNdof, "VrtxNdof");
-  event.put(fTVrtxChi2, "VrtxChi2");
-  event.put(fTVrtxNtrks, "VrtxNtrks");
-  event.put(fTVrtxSumPt, "VrtxSumPt");
-  event.put(fTVrtxIsFake, "VrtxIsFake");
  
-  event.put(fTNMus, "NMus");
-  event.put(fTNMusTot, "NMusTot");
-  event.put(fTNGMus, "NGMus");
-  event.put(fTNTMus, "NTMus");
-  event.put(fTMuGood, "MuGood");
-  event.put(fTMuIsIso, "MuIsIso");
-  event.put(fTMuIsGlobalMuon, "MuIsGlobalMuon");
-  event.put(fTMuIsTrackerMuon, "MuIsTrackerMuon");
-  event.put(fTMuIsPFMuon, "MuIsPFMuon");
-  event.put(fTMuIsStandaloneMuon, "MuIsStandaloneMuon");
-  event.put(fTMuPx, "MuPx");
-  event.put(fTMuPy, "MuPy");
-  event.put(fTMuPz, "MuPz");
-  event.put(fTMuPt, "MuPt");
-  event.put(fTMuInnerTkPt, "MuInnerTkPt");
-  event.put(fTMuTkPtE,"MuTkPtE");
-  event.put(fTMuTkD0E,"MuTkD0E");
-  event.put(fTMuTkDzE,"MuTkDzE");
-  event.put(fTMuPtE, "MuPtE");
-  event.put(fTMuE, "MuE");
-  event.put(fTMuEt, "MuEt");
-  event.put(fTMuEta, "MuEta");
-  event.put(fTMuPhi, "MuPhi");
-  event.put(fTMuCharge, "MuCharge");
-  event.put(fTMuRelIso03, "MuRelIso03");
-  event.put(fTMuIso03SumPt, "MuIso03SumPt");
-  event.put(fTMuIso03EmEt, "MuIso03EmEt");
-  event.put(fTMuIso03HadEt, "MuIso03HadEt");
-  event.put(fTMuIso03EMVetoEt, "MuIso03EMVetoEt");
-  event.put(fTMuIso03HadVetoEt, "MuIso03HadVetoEt");
-  event.put(fTMuIso05SumPt, "MuIso05SumPt");
-  event.put(fTMuIso05EmEt, "MuIso05EmEt");
-  event.put(fTMuIso05HadEt, "MuIso05HadEt");
-  event.put(fTMuPfIsoR03ChHad  , "MuPfIsoR03ChHad");
-  event.put(fTMuPfIsoR03NeHad  , "MuPfIsoR03NeHad");
-  event.put(fTMuPfIsoR03Photon , "MuPfIsoR03Photon");
-  event.put(fTMuPfIsoR03NeHadHighThresh  , "MuPfIsoR03NeHadHighThresh");
-  event.put(fTMuPfIsoR03PhotonHighThresh , "MuPfIsoR03PhotonHighThresh");
-  event.put(fTMuPfIsoR03SumPUPt, "MuPfIsoR03SumPUPt");
-  event.put(fTMuPfIsoR04ChHad  , "MuPfIsoR04ChHad");
-  event.put(fTMuPfIsoR04NeHad  , "MuPfIsoR04NeHad");
-  event.put(fTMuPfIsoR04Photon , "MuPfIsoR04Photon");
-  event.put(fTMuPfIsoR04NeHadHighThresh  , "MuPfIsoR04NeHadHighThresh");
-  event.put(fTMuPfIsoR04PhotonHighThresh , "MuPfIsoR04PhotonHighThresh");
-  event.put(fTMuPfIsoR04SumPUPt, "MuPfIsoR04SumPUPt");
   size_t ipfisotag = 0;
   for ( std::vector<edm::InputTag>::const_iterator it = fMuonPfIsoTagsCustom.begin();
         it != fMuonPfIsoTagsCustom.end(); ++it ) {
     event.put(fTMuPfIsosCustom[ipfisotag++], ("Mu"+(*it).label()).c_str());
   }
-  event.put(fTMuEem, "MuEem");
-  event.put(fTMuEhad, "MuEhad");
-  event.put(fTMuD0BS, "MuD0BS");
-  event.put(fTMuD0PV, "MuD0PV");
-  event.put(fTMuD03DPV, "MuD03DPV");
-  event.put(fTMuD03DE, "MuD03DE");
-  event.put(fTMuD0E, "MuD0E");
-  event.put(fTMuDzBS, "MuDzBS");
-  event.put(fTMuDzPV, "MuDzPV");
-  event.put(fTMuDzE, "MuDzE");
-  event.put(fTMuNChi2, "MuNChi2");
-  event.put(fTMuNGlHits, "MuNGlHits");
-  event.put(fTMuNGlMuHits, "MuNGlMuHits");
-  event.put(fTMuNMuHits, "MuNMuHits");
-  event.put(fTMuNTkHits, "MuNTkHits");
-  event.put(fTMuNPxHits, "MuNPxHits");
-  event.put(fTMuInnerTkNChi2, "MuInnerTkNChi2");
-  event.put(fTMuNSiLayers, "MuNSiLayers");
-  event.put(fTMuNMatches, "MuNMatches");
-  event.put(fTMuNMatchedStations, "MuNMatchedStations");
-  event.put(fTMuNChambers, "MuNChambers");
-  event.put(fTMuIsoMVA, "MuIsoMVA");
-  event.put(fTMuCaloComp, "MuCaloComp");
-  event.put(fTMuSegmComp, "MuSegmComp");
-  event.put(fTMuIsGMPT, "MuIsGMPT");
-  event.put(fTMuIsGMTkChiComp, "MuIsGMTkChiComp");
-  event.put(fTMuIsGMStaChiComp, "MuIsGMStaChiComp");
-  event.put(fTMuIsGMTkKinkTight, "MuIsGMTkKinkTight");
-  event.put(fTMuIsAllStaMuons, "MuIsAllStaMuons");
-  event.put(fTMuIsAllTrkMuons, "MuIsAllTrkMuons");
-  event.put(fTMuIsTrkMuonArbitrated, "MuIsTrkMuonArbitrated");
-  event.put(fTMuIsAllArbitrated, "MuIsAllArbitrated");
-  event.put(fTMuIsTMLSLoose, "MuIsTMLSLoose");
-  event.put(fTMuIsTMLSTight, "MuIsTMLSTight");
-  event.put(fTMuIsTM2DCompLoose, "MuIsTM2DCompLoose");
-  event.put(fTMuIsTM2DCompTight, "MuIsTM2DCompTight");
-  event.put(fTMuIsTMOneStationLoose, "MuIsTMOneStationLoose");
-  event.put(fTMuIsTMOneStationTight, "MuIsTMOneStationTight");
-  event.put(fTMuIsTMLSOptLowPtLoose, "MuIsTMLSOptLowPtLoose");
-  event.put(fTMuIsTMLSAngLoose, "MuIsTMLSAngLoose");
-  event.put(fTMuIsTMLSAngTight, "MuIsTMLSAngTight");
-  event.put(fTMuIsTMOneStationAngTight, "MuIsTMOneStationAngTight");
-  event.put(fTMuIsTMOneStationAngLoose, "MuIsTMOneStationAngLoose");
-  event.put(fTMuGenID, "MuGenID");
-  event.put(fTMuGenStatus, "MuGenStatus");
-  event.put(fTMuGenPt, "MuGenPt");
-  event.put(fTMuGenEta, "MuGenEta");
-  event.put(fTMuGenPhi, "MuGenPhi");
-  event.put(fTMuGenE, "MuGenE");
-  event.put(fTMuGenMID, "MuGenMID");
-  event.put(fTMuGenMStatus, "MuGenMStatus");
-  event.put(fTMuGenMPt, "MuGenMPt");
-  event.put(fTMuGenMEta, "MuGenMEta");
-  event.put(fTMuGenMPhi, "MuGenMPhi");
-  event.put(fTMuGenME, "MuGenME");
-  event.put(fTMuGenGMID, "MuGenGMID");
-  event.put(fTMuGenGMStatus, "MuGenGMStatus");
-  event.put(fTMuGenGMPt, "MuGenGMPt");
-  event.put(fTMuGenGMEta, "MuGenGMEta");
-  event.put(fTMuGenGMPhi, "MuGenGMPhi");
-  event.put(fTMuGenGME, "MuGenGME");
-  event.put(fTNEBhits, "NEBhits");
-  event.put(fTEBrechitE, "EBrechitE");
-  event.put(fTEBrechitPt, "EBrechitPt");
-  event.put(fTEBrechitEta, "EBrechitEta");
-  event.put(fTEBrechitPhi, "EBrechitPhi");
-  event.put(fTEBrechitChi2, "EBrechitChi2");
-  event.put(fTEBrechitTime, "EBrechitTime");
-  event.put(fTEBrechitE4oE1, "EBrechitE4oE1");
-  event.put(fTEBrechitE2oE9, "EBrechitE2oE9");
-  event.put(fTNEles, "NEles");
-  event.put(fTNElesTot, "NElesTot");
-  event.put(fTElGood, "ElGood");
-  event.put(fTElIsIso, "ElIsIso");
-  event.put(fTElChargeMisIDProb, "ElChargeMisIDProb");
-  event.put(fTElPx, "ElPx");
-  event.put(fTElPy, "ElPy");
-  event.put(fTElPz, "ElPz");
-  event.put(fTElPt, "ElPt");
-  event.put(fTElPtE, "ElPtE");
-  event.put(fTElE, "ElE");
-  event.put(fTElEt, "ElEt");
-  event.put(fTElEta, "ElEta");
-  event.put(fTElTheta, "ElTheta");
-  event.put(fTElSCEta, "ElSCEta");
-  event.put(fTElPhi, "ElPhi");
-  event.put(fTElIsEB, "ElIsEB");
-  event.put(fTElIsEE, "ElIsEE");
-  event.put(fTElGsfTkPt, "ElGsfTkPt");
-  event.put(fTElGsfTkEta, "ElGsfTkEta");
-  event.put(fTElGsfTkPhi, "ElGsfTkPhi");
-  event.put(fTElTrkMomentumError, "ElTrkMomentumError");
-  event.put(fTElEcalEnergyError, "ElEcalEnergyError");
-  event.put(fTElEleMomentumError, "ElEleMomentumError");
-  event.put(fTElNBrems, "ElNBrems");
-  event.put(fTElD0BS, "ElD0BS");
-  event.put(fTElD0PV, "ElD0PV");
-  event.put(fTElD0E, "ElD0E");
-  event.put(fTElD03DPV, "ElD03DPV");
-  event.put(fTElD03DE, "ElD03DE");
-  event.put(fTElDzBS, "ElDzBS");
-  event.put(fTElDzPV, "ElDzPV");
-  event.put(fTElDzE, "ElDzE");
-  event.put(fTElRelIso03, "ElRelIso03");
-  event.put(fTElRelIso04, "ElRelIso04");
-  event.put(fTElPfIsoChHad03, "ElPfIsoChHad03");
-  event.put(fTElPfIsoNeHad03, "ElPfIsoNeHad03");
-  event.put(fTElPfIsoPhoton03, "ElPfIsoPhoton03");
-  event.put(fTElDR03TkSumPt, "ElDR03TkSumPt");
-  event.put(fTElDR04TkSumPt, "ElDR04TkSumPt");
-  event.put(fTElDR03EcalRecHitSumEt, "ElDR03EcalRecHitSumEt");
-  event.put(fTElDR04EcalRecHitSumEt, "ElDR04EcalRecHitSumEt");
-  event.put(fTElDR03HcalTowerSumEt, "ElDR03HcalTowerSumEt");
-  event.put(fTElDR04HcalTowerSumEt, "ElDR04HcalTowerSumEt");
   ipfisotag = 0;
   for ( std::vector<edm::InputTag>::const_iterator it = fElePfIsoTagsCustom.begin();
         it != fElePfIsoTagsCustom.end(); ++it ) {
@@ -5806,155 +4541,6 @@ void NTupleProducer::putProducts( edm::Event& event ) {
         it != fElePfIsoTagsEvent.end(); ++it ) {
     event.put(fTElPfIsosEvent[ipfisotag++], ("ElEvent"+(*it).label()).c_str());
   }
-  event.put(fTElNChi2, "ElNChi2");
-  event.put(fTElKfTrkchi2, "ElKfTrkchi2");
-  event.put(fTElKfTrkhits, "ElKfTrkhits");
-  event.put(fTElCharge, "ElCharge");
-  event.put(fTElCInfoIsGsfCtfCons, "ElCInfoIsGsfCtfCons");
-  event.put(fTElCInfoIsGsfCtfScPixCons, "ElCInfoIsGsfCtfScPixCons");
-  event.put(fTElCInfoIsGsfScPixCons, "ElCInfoIsGsfScPixCons");
-  event.put(fTElScPixCharge, "ElScPixCharge");
-  event.put(fTElClosestCtfTrackPt, "ElClosestCtfTrackPt");
-  event.put(fTElClosestCtfTrackEta, "ElClosestCtfTrackEta");
-  event.put(fTElClosestCtfTrackPhi, "ElClosestCtfTrackPhi");
-  event.put(fTElClosestCtfTrackCharge, "ElClosestCtfTrackCharge");
-  event.put(fTElIDMva, "ElIDMva");
-  event.put(fTElIDMVATrig, "ElIDMVATrig");
-  event.put(fTElIDMVANoTrig, "ElIDMVANoTrig");
-  event.put(fTElInGap, "ElInGap");
-  event.put(fTElEcalDriven, "ElEcalDriven");
-  event.put(fTElTrackerDriven, "ElTrackerDriven");
-  event.put(fTElBasicClustersSize, "ElBasicClustersSize");
-  event.put(fTElfbrem, "Elfbrem");
-  event.put(fTElHcalOverEcal, "ElHcalOverEcal");
-  event.put(fTElHcalOverEcalBc, "ElHcalOverEcalBc");
-  event.put(fTElE1x5, "ElE1x5");
-  event.put(fTElE5x5, "ElE5x5");
-  event.put(fTElE2x5Max, "ElE2x5Max");
-  event.put(fTElR9, "ElR9");
-  event.put(fTElSigmaIetaIeta, "ElSigmaIetaIeta");
-  event.put(fTElSigmaIphiIphi, "ElSigmaIphiIphi");
-  event.put(fTElScEtaWidth, "ElScEtaWidth");
-  event.put(fTElScPhiWidth, "ElScPhiWidth");
-  event.put(fTElDeltaPhiSeedClusterAtCalo, "ElDeltaPhiSeedClusterAtCalo");
-  event.put(fTElDeltaEtaSeedClusterAtCalo, "ElDeltaEtaSeedClusterAtCalo");
-  event.put(fTElDeltaPhiSuperClusterAtVtx, "ElDeltaPhiSuperClusterAtVtx");
-  event.put(fTElDeltaEtaSuperClusterAtVtx, "ElDeltaEtaSuperClusterAtVtx");
-  event.put(fTElCaloEnergy, "ElCaloEnergy");
-  event.put(fTElTrkMomAtVtx, "ElTrkMomAtVtx");
-  event.put(fTElESuperClusterOverP, "ElESuperClusterOverP");
-  event.put(fTElIoEmIoP, "ElIoEmIoP");
-  event.put(fTElEoPout, "ElEoPout");
-  event.put(fTElPreShowerOverRaw, "ElPreShowerOverRaw");
-  event.put(fTElNumberOfMissingInnerHits, "ElNumberOfMissingInnerHits");
-  event.put(fTElSCindex, "ElSCindex");
-  event.put(fTElConvPartnerTrkDist, "ElConvPartnerTrkDist");
-  event.put(fTElPassConversionVeto,"ElPassConversionVeto");
-  event.put(fTElConvPartnerTrkDCot, "ElConvPartnerTrkDCot");
-  event.put(fTElConvPartnerTrkPt, "ElConvPartnerTrkPt");
-  event.put(fTElConvPartnerTrkEta, "ElConvPartnerTrkEta");
-  event.put(fTElConvPartnerTrkPhi, "ElConvPartnerTrkPhi");
-  event.put(fTElConvPartnerTrkCharge, "ElConvPartnerTrkCharge");
-  event.put(fTElScSeedSeverity, "ElScSeedSeverity");
-  event.put(fTElE1OverE9, "ElE1OverE9");
-  event.put(fTElS4OverS1, "ElS4OverS1");
-  event.put(fTElGenID, "ElGenID");
-  event.put(fTElGenStatus, "ElGenStatus");
-  event.put(fTElGenPt, "ElGenPt");
-  event.put(fTElGenEta, "ElGenEta");
-  event.put(fTElGenPhi, "ElGenPhi");
-  event.put(fTElGenE, "ElGenE");
-  event.put(fTElGenMID, "ElGenMID");
-  event.put(fTElGenMStatus, "ElGenMStatus");
-  event.put(fTElGenMPt, "ElGenMPt");
-  event.put(fTElGenMEta, "ElGenMEta");
-  event.put(fTElGenMPhi, "ElGenMPhi");
-  event.put(fTElGenME, "ElGenME");
-  event.put(fTElGenGMID, "ElGenGMID");
-  event.put(fTElGenGMStatus, "ElGenGMStatus");
-  event.put(fTElGenGMPt, "ElGenGMPt");
-  event.put(fTElGenGMEta, "ElGenGMEta");
-  event.put(fTElGenGMPhi, "ElGenGMPhi");
-  event.put(fTElGenGME, "ElGenGME");
-  event.put(fTPhoPassConversionVeto,"PhoPassConversionVeto");
-  event.put(fTNPhotons, "NPhotons");
-  event.put(fTNPhotonsTot, "NPhotonsTot");
-  event.put(fTPhoGood, "PhoGood");
-  event.put(fTPhoIsIso, "PhoIsIso");
-  event.put(fTPhoPt, "PhoPt");
-  event.put(fTPhoPx, "PhoPx");
-  event.put(fTPhoPy, "PhoPy");
-  event.put(fTPhoPz, "PhoPz");
-  event.put(fTPhoEta, "PhoEta");
-  event.put(fTPhoPhi, "PhoPhi");
-  event.put(fTPhoEnergy, "PhoEnergy");
-  event.put(fTPhoIso03Ecal, "PhoIso03Ecal");
-  event.put(fTPhoIso03Hcal, "PhoIso03Hcal");
-  event.put(fTPhoIso03TrkSolid, "PhoIso03TrkSolid");
-  event.put(fTPhoIso03TrkHollow, "PhoIso03TrkHollow");
-  event.put(fTPhoIso03, "PhoIso03");
-  event.put(fTPhoIso04Ecal, "PhoIso04Ecal");
-  event.put(fTPhoIso04Hcal, "PhoIso04Hcal");
-  event.put(fTPhoIso04TrkSolid, "PhoIso04TrkSolid");
-  event.put(fTPhoIso04TrkHollow, "PhoIso04TrkHollow");
-  event.put(fTPhoIso04, "PhoIso04");
-  event.put(fTPhoR9, "PhoR9");
-  event.put(fTPhoCaloPositionX, "PhoCaloPositionX");
-  event.put(fTPhoCaloPositionY, "PhoCaloPositionY");
-  event.put(fTPhoCaloPositionZ, "PhoCaloPositionZ");
-  event.put(fTPhoHoverE, "PhoHoverE");
-  event.put(fTPhoH1overE, "PhoH1overE");
-  event.put(fTPhoH2overE, "PhoH2overE");
-  event.put(fTPhoHoverE2012, "PhoHoverE2012");
-  event.put(fTPhoSigmaIetaIeta, "PhoSigmaIetaIeta");
-  event.put(fTPhoSigmaIetaIphi, "PhoSigmaIetaIphi");
-  event.put(fTPhoSigmaIphiIphi, "PhoSigmaIphiIphi");
-  event.put(fTPhoS4Ratio, "PhoS4Ratio");
-  event.put(fTPhoLambdaRatio, "PhoLambdaRatio");
-  event.put(fTPhoSCRawEnergy, "PhoSCRawEnergy");
-  event.put(fTPhoSCEtaWidth, "PhoSCEtaWidth");
-  event.put(fTPhoSCSigmaPhiPhi, "PhoSCSigmaPhiPhi");
-  event.put(fTPhoHasPixSeed, "PhoHasPixSeed");
-  event.put(fTPhoHasConvTrks, "PhoHasConvTrks");
-  event.put(fTPhoScSeedSeverity, "PhoScSeedSeverity");
-  event.put(fTPhoE1OverE9, "PhoE1OverE9");
-  event.put(fTPhoS4OverS1, "PhoS4OverS1");
-  event.put(fTPhoSigmaEtaEta, "PhoSigmaEtaEta");
-  event.put(fTPhoSigmaRR, "PhoSigmaRR");
-  event.put(fTPhoHCalIso2012ConeDR03, "PhoHCalIso2012ConeDR03");
-  event.put(fTPhoNewIsoPFCharged, "PhoNewIsoPFCharged");
-  event.put(fTPhoNewIsoPFPhoton, "PhoNewIsoPFPhoton");
-  event.put(fTPhoNewIsoPFNeutral, "PhoNewIsoPFNeutral");
-  event.put(fTPhoE1x5, "PhoE1x5");
-  event.put(fTPhoE2x5, "PhoE2x5");
-  event.put(fTPhoE3x3, "PhoE3x3");
-  event.put(fTPhoE5x5, "PhoE5x5");
-  event.put(fTPhomaxEnergyXtal, "PhomaxEnergyXtal");
-  event.put(fTPhoIso03HcalDepth1, "PhoIso03HcalDepth1");
-  event.put(fTPhoIso03HcalDepth2, "PhoIso03HcalDepth2");
-  event.put(fTPhoIso04HcalDepth1, "PhoIso04HcalDepth1");
-  event.put(fTPhoIso04HcalDepth2, "PhoIso04HcalDepth2");
-  event.put(fTPhoIso03nTrksSolid, "PhoIso03nTrksSolid");
-  event.put(fTPhoIso03nTrksHollow, "PhoIso03nTrksHollow");
-  event.put(fTPhoIso04nTrksSolid, "PhoIso04nTrksSolid");
-  event.put(fTPhoIso04nTrksHollow, "PhoIso04nTrksHollow");
-  event.put(fTPhoisEB, "PhoisEB");
-  event.put(fTPhoisEE, "PhoisEE");
-  event.put(fTPhoisEBEtaGap, "PhoisEBEtaGap");
-  event.put(fTPhoisEBPhiGap, "PhoisEBPhiGap");
-  event.put(fTPhoisEERingGap, "PhoisEERingGap");
-  event.put(fTPhoisEEDeeGap, "PhoisEEDeeGap");
-  event.put(fTPhoisEBEEGap, "PhoisEBEEGap");
-  event.put(fTPhoisPFlowPhoton, "PhoisPFlowPhoton");
-  event.put(fTPhoisStandardPhoton, "PhoisStandardPhoton");
-  event.put(fTPhoMCmatchindex, "PhoMCmatchindex");
-  event.put(fTPhoMCmatchexitcode, "PhoMCmatchexitcode");
-  event.put(fTPhoChargedHadronIso, "PhoChargedHadronIso");
-  event.put(fTPhoNeutralHadronIso, "PhoNeutralHadronIso");
-  event.put(fTPhoPhotonIso, "PhoPhotonIso");
-  event.put(fTPhoisPFPhoton, "PhoisPFPhoton");
-  event.put(fTPhoisPFElectron, "PhoisPFElectron");
-  event.put(fTPhotSCindex, "PhotSCindex");
 //  event.put(fTPhoCone04PhotonIsodR0dEta0pt0, "PhoCone04PhotonIsodR0dEta0pt0");
 //  event.put(fTPhoCone04PhotonIsodR0dEta0pt5, "PhoCone04PhotonIsodR0dEta0pt5");
 //  event.put(fTPhoCone04PhotonIsodR8dEta0pt0, "PhoCone04PhotonIsodR8dEta0pt0");
@@ -6001,15 +4587,6 @@ void NTupleProducer::putProducts( edm::Event& event ) {
 //  event.put(fTPhoCone04ChargedHadronIsodR015dEta0pt0dz0, "PhoCone04ChargedHadronIsodR015dEta0pt0dz0");
 //  event.put(fTPhoCone04ChargedHadronIsodR015dEta0pt0dz1dxy01, "PhoCone04ChargedHadronIsodR015dEta0pt0dz1dxy01");
 //  event.put(fTPhoCone04ChargedHadronIsodR015dEta0pt0PFnoPU, "PhoCone04ChargedHadronIsodR015dEta0pt0PFnoPU");
-  event.put(fTPhoCiCPFIsoChargedDR03, "PhoCiCPFIsoChargedDR03");
-  event.put(fTPhoCiCPFIsoNeutralDR03, "PhoCiCPFIsoNeutralDR03");
-  event.put(fTPhoCiCPFIsoPhotonDR03, "PhoCiCPFIsoPhotonDR03");
-  event.put(fTPhoCiCPFIsoChargedDR04, "PhoCiCPFIsoChargedDR04");
-  event.put(fTPhoCiCPFIsoNeutralDR04, "PhoCiCPFIsoNeutralDR04");
-  event.put(fTPhoCiCPFIsoPhotonDR04, "PhoCiCPFIsoPhotonDR04");
-  event.put(fTPhoSCEta, "PhoSCEta");
-  event.put(fTPhoSCPhiWidth, "PhoSCPhiWidth");
-  event.put(fTPhoIDMVA, "PhoIDMVA");
 //  event.put(fTPhoConvValidVtx, "PhoConvValidVtx");
 //  event.put(fTPhoConvNtracks, "PhoConvNtracks");
 //  event.put(fTPhoConvChi2Probability, "PhoConvChi2Probability");
@@ -6020,96 +4597,11 @@ void NTupleProducer::putProducts( edm::Event& event ) {
 //  event.put(fTConvChi2Probability, "ConvChi2Probability");
 //  event.put(fTConvEoverP, "ConvEoverP");
 //  event.put(fTConvZofPrimVtxFromTrks, "ConvZofPrimVtxFromTrks");
-  event.put(fTNgv, "Ngv");
-  event.put(fTgvSumPtHi, "gvSumPtHi");
-  event.put(fTgvSumPtLo, "gvSumPtLo");
-  event.put(fTgvNTkHi, "gvNTkHi");
-  event.put(fTgvNTkLo, "gvNTkLo");
-  event.put(fTNGoodSuperClusters, "NGoodSuperClusters");
-  event.put(fTGoodSCEnergy, "GoodSCEnergy");
-  event.put(fTGoodSCEta, "GoodSCEta");
-  event.put(fTGoodSCPhi, "GoodSCPhi");
-  event.put(fTNSuperClusters, "NSuperClusters");
-  event.put(fTSCRaw, "SCRaw");
-  event.put(fTSCPre, "SCPre");
-  event.put(fTSCEnergy, "SCEnergy");
-  event.put(fTSCEta, "SCEta");
-  event.put(fTSCPhi, "SCPhi");
-  event.put(fTSCPhiWidth, "SCPhiWidth");
-  event.put(fTSCEtaWidth, "SCEtaWidth");
-  event.put(fTSCBrem, "SCBrem");
-  event.put(fTSCR9, "SCR9");
-  event.put(fTSCcrackcorrseed, "SCcrackcorrseed");
-  event.put(fTSCcrackcorr, "SCcrackcorr");
-  event.put(fTSClocalcorrseed, "SClocalcorrseed");
-  event.put(fTSClocalcorr, "SClocalcorr");
-  event.put(fTSCcrackcorrseedfactor, "SCcrackcorrseedfactor");
-  event.put(fTSClocalcorrseedfactor, "SClocalcorrseedfactor");
-  event.put(fTNJets, "NJets");
-  event.put(fTNJetsTot, "NJetsTot");
-  event.put(fTJGood, "JGood");
-  event.put(fTJPx, "JPx");
-  event.put(fTJPy, "JPy");
-  event.put(fTJPz, "JPz");
-  event.put(fTJPt, "JPt");
-  event.put(fTJE, "JE");
-  event.put(fTJEt, "JEt");
-  event.put(fTJEta, "JEta");
-  event.put(fTJPhi, "JPhi");
-  event.put(fTJEcorr, "JEcorr");
-  event.put(fTJArea, "JArea");
-  event.put(fTJEtaRms, "JEtaRms");
-  event.put(fTJPhiRms, "JPhiRms");
-  event.put(fTJNConstituents, "JNConstituents");
-  event.put(fTJNAssoTracks, "JNAssoTracks");
-  event.put(fTJNNeutrals, "JNNeutrals");
-  event.put(fTJChargedEmFrac, "JChargedEmFrac");
-  event.put(fTJNeutralEmFrac, "JNeutralEmFrac");
-  event.put(fTJChargedHadFrac, "JChargedHadFrac");
-  event.put(fTJNeutralHadFrac, "JNeutralHadFrac");
-  event.put(fTJChargedMuEnergyFrac, "JChargedMuEnergyFrac");
-  event.put(fTJPhoFrac, "JPhoFrac");
-  event.put(fTJHFHadFrac, "JHFHadFrac");
-  event.put(fTJHFEMFrac, "JHFEMFrac");
-  event.put(fTJPtD, "JPtD");
-  event.put(fTJRMSCand, "JRMSCand");
-  event.put(fTJeMinDR, "JeMinDR");
   size_t ibtag = 0;
   for ( std::vector<edm::InputTag>::const_iterator it = fBtagTags.begin();
 	it != fBtagTags.end(); ++it ) {
     event.put(fTJbTagProb[ibtag++], ("J"+(*it).label()).c_str());
   }
-  event.put(fTJPartonFlavour, "JPartonFlavour");
-  event.put(fTJMass, "JMass");
-  event.put(fTJBetaStar, "JBetaStar");
-  event.put(fTJBeta, "JBeta");
-  event.put(fTJBetaSq, "JBetaSq");
-  event.put(fTJtrk1px, "Jtrk1px");
-  event.put(fTJtrk1py, "Jtrk1py");
-  event.put(fTJtrk1pz, "Jtrk1pz");
-  event.put(fTJtrk2px, "Jtrk2px");
-  event.put(fTJtrk2py, "Jtrk2py");
-  event.put(fTJtrk2pz, "Jtrk2pz");
-  event.put(fTJtrk3px, "Jtrk3px");
-  event.put(fTJtrk3py, "Jtrk3py");
-  event.put(fTJtrk3pz, "Jtrk3pz");
-  event.put(fTJVtxx, "JVtxx");
-  event.put(fTJVtxy, "JVtxy");
-  event.put(fTJVtxz, "JVtxz");
-  event.put(fTJVtxExx, "JVtxExx");
-  event.put(fTJVtxEyx, "JVtxEyx");
-  event.put(fTJVtxEyy, "JVtxEyy");
-  event.put(fTJVtxEzy, "JVtxEzy");
-  event.put(fTJVtxEzz, "JVtxEzz");
-  event.put(fTJVtxEzx, "JVtxEzx");
-  event.put(fTJVtxNChi2, "JVtxNChi2");
-  event.put(fTJGenJetIndex, "JGenJetIndex");
-  event.put(fTJMetCorrRawEta, "JMetCorrRawEta"); 
-  event.put(fTJMetCorrNoMuPt,  "JMetCorrNoMuPt");  
-  event.put(fTJMetCorrRawPt,  "JMetCorrRawPt");  
-  event.put(fTJMetCorrPhi,  "JMetCorrPhi");  
-  event.put(fTJMetCorrEMF, "JMetCorrEMF"); 
-  event.put(fTJMetCorrArea,"JMetCorrArea");
   for ( unsigned int i=0; i<PileupJetIdAlgos.size(); ++i ) {
     std::ostringstream s;
     s << i;
@@ -6117,123 +4609,11 @@ void NTupleProducer::putProducts( edm::Event& event ) {
     event.put(fTJPassPileupIDM[i], ("JPassPileupIDM"+s.str()).c_str());
     event.put(fTJPassPileupIDT[i], ("JPassPileupIDT"+s.str()).c_str());
   }
-  event.put(fTJQGTagLD,"JQGTagLD");
-  event.put(fTJQGTagMLP,"JQGTagMLP");
-  event.put(fTJSmearedQGL,"JSmearedQGL");
-  event.put(fTNTracks, "NTracks");
-  event.put(fTNTracksTot, "NTracksTot");
-  event.put(fTTrkGood, "TrkGood");
-  event.put(fTTrkPt, "TrkPt");
-  event.put(fTTrkEta, "TrkEta");
-  event.put(fTTrkPhi, "TrkPhi");
-  event.put(fTTrkNChi2, "TrkNChi2");
-  event.put(fTTrkNHits, "TrkNHits");
-  event.put(fTTrkVtxDz, "TrkVtxDz");
-  event.put(fTTrkVtxDxy, "TrkVtxDxy");
-  event.put(fTTrkPtSumx, "TrkPtSumx");
-  event.put(fTTrkPtSumy, "TrkPtSumy");
-  event.put(fTTrkPtSum, "TrkPtSum");
-  event.put(fTTrkPtSumPhi, "TrkPtSumPhi");
-  event.put(fTSumEt, "SumEt");
-  event.put(fTECALSumEt, "ECALSumEt");
-  event.put(fTHCALSumEt, "HCALSumEt");
-  event.put(fTECALEsumx, "ECALEsumx");
-  event.put(fTECALEsumy, "ECALEsumy");
-  event.put(fTECALEsumz, "ECALEsumz");
-  event.put(fTECALMET, "ECALMET");
-  event.put(fTECALMETPhi, "ECALMETPhi");
-  event.put(fTECALMETEta, "ECALMETEta");
-  event.put(fTHCALEsumx, "HCALEsumx");
-  event.put(fTHCALEsumy, "HCALEsumy");
-  event.put(fTHCALEsumz, "HCALEsumz");
-  event.put(fTHCALMET, "HCALMET");
-  event.put(fTHCALMETPhi, "HCALMETPhi");
-  event.put(fTHCALMETeta, "HCALMETeta");
-  event.put(fTRawMET, "RawMET");
-  event.put(fTRawMETpx, "RawMETpx");
-  event.put(fTRawMETpy, "RawMETpy");
-  event.put(fTRawMETphi, "RawMETphi");
-  event.put(fTRawMETemEtFrac, "RawMETemEtFrac");
-  event.put(fTRawMETemEtInEB, "RawMETemEtInEB");
-  event.put(fTRawMETemEtInEE, "RawMETemEtInEE");
-  event.put(fTRawMETemEtInHF, "RawMETemEtInHF");
-  event.put(fTRawMEThadEtFrac, "RawMEThadEtFrac");
-  event.put(fTRawMEThadEtInHB, "RawMEThadEtInHB");
-  event.put(fTRawMEThadEtInHE, "RawMEThadEtInHE");
-  event.put(fTRawMEThadEtInHF, "RawMEThadEtInHF");
-  event.put(fTRawMETSignificance, "RawMETSignificance");
-  event.put(fTGenMET, "GenMET");
-  event.put(fTGenMETpx, "GenMETpx");
-  event.put(fTGenMETpy, "GenMETpy");
-  event.put(fTGenMETphi, "GenMETphi");
-  event.put(fTTCMET, "TCMET");
-  event.put(fTTCMETpx, "TCMETpx");
-  event.put(fTTCMETpy, "TCMETpy");
-  event.put(fTTCMETphi, "TCMETphi");
-  event.put(fTTCMETSignificance, "TCMETSignificance");
-  event.put(fTMuJESCorrMET, "MuJESCorrMET");
-  event.put(fTMuJESCorrMETpx, "MuJESCorrMETpx");
-  event.put(fTMuJESCorrMETpy, "MuJESCorrMETpy");
-  event.put(fTMuJESCorrMETphi, "MuJESCorrMETphi");
-  event.put(fTPFMET, "PFMET");
-  event.put(fTPFMETpx, "PFMETpx");
-  event.put(fTPFMETpy, "PFMETpy");
-  event.put(fTPFMETphi, "PFMETphi");
-  event.put(fTPFMETSignificance, "PFMETSignificance");
-  event.put(fTPFSumEt, "PFSumEt");
-  event.put(fTMETR12, "METR12");
-  event.put(fTMETR21, "METR21");
-
-event.put(fTSigma,"Sigma");
-event.put(fTGenPhotonIsoDR03,"GenPhotonIsoDR03");
-event.put(fTGenPhotonIsoDR04,"GenPhotonIsoDR04");
-event.put(fTSCX,"SCX");
-event.put(fTSCY,"SCY");
-event.put(fTSCZ,"SCZ");
-event.put(fTSCXtalListStart,"SCXtalListStart");
-event.put(fTSCNXtals,"SCNXtals");
-event.put(fTNXtals,"NXtals");
-event.put(fTXtalX,"XtalX");
-event.put(fTXtalY,"XtalY");
-event.put(fTXtalZ,"XtalZ");
-event.put(fTXtalEtaWidth,"XtalEtaWidth");
-event.put(fTXtalPhiWidth,"XtalPhiWidth");
-event.put(fTXtalFront1X,"XtalFront1X");
-event.put(fTXtalFront1Y,"XtalFront1Y");
-event.put(fTXtalFront1Z,"XtalFront1Z");
-event.put(fTXtalFront2X,"XtalFront2X");
-event.put(fTXtalFront2Y,"XtalFront2Y");
-event.put(fTXtalFront2Z,"XtalFront2Z");
-event.put(fTXtalFront3X,"XtalFront3X");
-event.put(fTXtalFront3Y,"XtalFront3Y");
-event.put(fTXtalFront3Z,"XtalFront3Z");
-event.put(fTXtalFront4X,"XtalFront4X");
-event.put(fTXtalFront4Y,"XtalFront4Y");
-event.put(fTXtalFront4Z,"XtalFront4Z");
-event.put(fTNPfCand,"NPfCand");
-event.put(fTPfCandPdgId,"PfCandPdgId");
-event.put(fTPfCandEta,"PfCandEta");
-event.put(fTPfCandPhi,"PfCandPhi");
-event.put(fTPfCandEnergy,"PfCandEnergy");
-event.put(fTPfCandEcalEnergy,"PfCandEcalEnergy");
-event.put(fTPfCandPt,"PfCandPt");
-event.put(fTPfCandVx,"PfCandVx");
-event.put(fTPfCandVy,"PfCandVy");
-event.put(fTPfCandVz,"PfCandVz");
-event.put(fTPfCandBelongsToJet,"PfCandBelongsToJet");
+
 //event.put(fTPfCandHasHitInFirstPixelLayer,"PfCandHasHitInFirstPixelLayer");
 //event.put(fTPfCandTrackRefPx,"PfCandTrackRefPx");
 //event.put(fTPfCandTrackRefPy,"PfCandTrackRefPy");
 //event.put(fTPfCandTrackRefPz,"PfCandTrackRefPz");
-event.put(fTPhoMatchedPFPhotonCand,"PhoMatchedPFPhotonCand");
-event.put(fTPhoMatchedPFElectronCand,"PhoMatchedPFElectronCand");
-event.put(fTPhoFootprintPfCandsListStart,"PhoFootprintPfCandsListStart");
-event.put(fTPhoFootprintPfCands,"PhoFootprintPfCands");
-event.put(fTPhoVx,"PhoVx");
-event.put(fTPhoVy,"PhoVy");
-event.put(fTPhoVz,"PhoVz");
-event.put(fTPhoRegrEnergy,"PhoRegrEnergy");
-event.put(fTPhoRegrEnergyErr,"PhoRegrEnergyErr");
 //event.put(fTPhoCone01PhotonIsodEta015EBdR070EEmvVtx,"PhoCone01PhotonIsodEta015EBdR070EEmvVtx");
 //event.put(fTPhoCone02PhotonIsodEta015EBdR070EEmvVtx,"PhoCone02PhotonIsodEta015EBdR070EEmvVtx");
 //event.put(fTPhoCone03PhotonIsodEta015EBdR070EEmvVtx,"PhoCone03PhotonIsodEta015EBdR070EEmvVtx");
@@ -6248,23 +4628,6 @@ event.put(fTPhoRegrEnergyErr,"PhoRegrEnergyErr");
 //event.put(fTPhoCone04ChargedHadronIsodR02dz02dxy01,"PhoCone04ChargedHadronIsodR02dz02dxy01");
 //event.put(fTPhoCone03PFCombinedIso,"PhoCone03PFCombinedIso");
 //event.put(fTPhoCone04PFCombinedIso,"PhoCone04PFCombinedIso");
-event.put(fTDiphotonsfirst,"Diphotonsfirst");
-event.put(fTDiphotonssecond,"Diphotonssecond");
-event.put(fTVtxdiphoh2gglobe,"Vtxdiphoh2gglobe");
-event.put(fTVtxdiphomva,"Vtxdiphomva");
-event.put(fTVtxdiphoproductrank,"Vtxdiphoproductrank");
-event.put(fTPhoSCRemovalPFIsoCharged,"PhoSCRemovalPFIsoCharged");
-event.put(fTPhoSCRemovalPFIsoChargedPrimVtx,"PhoSCRemovalPFIsoChargedPrimVtx");
-event.put(fTPhoSCRemovalPFIsoNeutral,"PhoSCRemovalPFIsoNeutral");
-event.put(fTPhoSCRemovalPFIsoPhoton,"PhoSCRemovalPFIsoPhoton");
-event.put(fTPhoSCRemovalPFIsoChargedRCone,"PhoSCRemovalPFIsoChargedRCone");
-event.put(fTPhoSCRemovalPFIsoChargedPrimVtxRCone,"PhoSCRemovalPFIsoChargedPrimVtxRCone");
-event.put(fTPhoSCRemovalPFIsoNeutralRCone,"PhoSCRemovalPFIsoNeutralRCone");
-event.put(fTPhoSCRemovalPFIsoPhotonRCone,"PhoSCRemovalPFIsoPhotonRCone");
-event.put(fTPhoSCRemovalRConeEta, "PhoSCRemovalRConeEta");
-event.put(fTPhoSCRemovalRConePhi, "PhoSCRemovalRConePhi");
-event.put(fTPhoSCRemovalPFIsoChargedVtxConst,"PhoSCRemovalPFIsoChargedVtxConst");
-event.put(fTPhoSCRemovalPFIsoChargedVtxConstRCone,"PhoSCRemovalPFIsoChargedVtxConstRCone");
 
 }
 
@@ -6277,6 +4640,7 @@ bool NTupleProducer::beginRun(edm::Run& r, const edm::EventSetup& es){
   
   // Need to reset at each run, since "put" deletes the pointers
   fRHLTLabels.reset( new std::vector<std::string>(fHLTLabels) );
+  fRTrigMatchFilters.reset( new std::vector<std::string>(fTrigMatchLabels) );
   fRPileUpData.reset( new std::vector<std::string>(fPileUpData) );
   fRPileUpMC.reset( new std::vector<std::string>(fPileUpMC) );
 
@@ -6287,6 +4651,32 @@ bool NTupleProducer::beginRun(edm::Run& r, const edm::EventSetup& es){
                          << fHltConfig.processName();
   }
   fRHLTNames.reset(new std::vector<std::string>(fHltConfig.triggerNames()));
+  fHLTResultsTag = edm::InputTag("TriggerResults","",fHltConfig.processName());
+  fHLTPrescaleRun = 0; // the menu may have changed
+  fHLTPrescaleLumi = 0;
+
+  // Paths and filters to store the trigger objects of
+  const std::vector<std::string>& allTrigNames = *fRHLTNames;
+  fHLTObjectPaths.resize(fTNpaths);
+  for (size_t i=0; i<fTNpaths; ++i) {
+    HLTObjectPath& hltPath = fHLTObjectPaths[i];
+    hltPath.path = -1;
+    hltPath.filter.index = 0;
+    size_t j = 0;
+    for(; j <allTrigNames.size();++j) {
+      if(allTrigNames[j].find(fHLTLabels[i])!=std::string::npos) break;
+    }
+    if (j==allTrigNames.size()) continue;
+    const std::vector<std::string>& filtertags = fHltConfig.moduleLabels(j);
+    if(filtertags.size() < 2) continue;
+    hltPath.path = j;
+    hltPath.filter.tag = edm::InputTag(filtertags[filtertags.size()-2],"",fHltConfig.processName());
+  }
+  fTrigMatchFilters.resize(fTrigMatchLabels.size());
+  for (size_t i=0; i<fTrigMatchLabels.size(); ++i) {
+    fTrigMatchFilters[i].tag = edm::InputTag(fTrigMatchLabels[i],"",fHltConfig.processName());
+    fTrigMatchFilters[i].index = 0;
+  }
 
   // Store L1 trigger names
   edm::ESHandle<L1GtTriggerMenu> menuRcd;
@@ -6407,9 +4797,23 @@ bool NTupleProducer::endRun(edm::Run& r, const edm::EventSetup&){
   r.put(fRMaxNPfCand, "MaxNPfCand"    );
   r.put(fRMaxNXtals,  "MaxNXtals"    );
 
+  // Geometry of the crystals stored in the run
+  const std::vector<CrystalGeometryCache::Crystal>& xtals = fXtalGeometry.crystals();
+  fRXtalGeometry->reserve(xtals.size()*17);
+  for (size_t i=0; i<xtals.size(); ++i) {
+    const CrystalGeometryCache::Crystal& xtal = xtals[i];
+    fRXtalGeomDetId->push_back(xtal.rawId);
+    float values[5] = { xtal.x, xtal.y, xtal.z, xtal.etaWidth, xtal.phiWidth };
+    fRXtalGeometry->insert(fRXtalGeometry->end(), values, values+5);
+    for (int k=0; k<4; ++k) fRXtalGeometry->insert(fRXtalGeometry->end(), xtal.front[k], xtal.front[k]+3);
+  }
+  r.put(fRXtalGeomDetId, "XtalGeomDetId");
+  r.put(fRXtalGeometry,  "XtalGeometry" );
+
   r.put(fRHLTNames   ,"HLTNames"      );
   r.put(fRL1PhysMenu ,"L1PhysMenu"    );
   r.put(fRHLTLabels  ,"HLTLabels"     );
+  r.put(fRTrigMatchFilters,"TrigMatchFilters");
 
   r.put(fRPileUpData ,"PileUpData"    );
   r.put(fRPileUpMC   ,"PileUpMC"      );
@@ -6425,155 +4829,23 @@ void NTupleProducer::endJob( void ){
   edm::LogVerbatim("NTP") << " ==> NTupleProducer::endJob() ...";
   edm::LogVerbatim("NTP") << "  Total number of processed Events: " << fNTotEvents;
   edm::LogVerbatim("NTP") << "  Number of times Tree was filled:  " << fNFillTree;
+  edm::LogVerbatim("NTP") << "  Collection lookups:               " << fCollections.nTotLookups();
+  edm::LogVerbatim("NTP") << "   of which served from cache:      " << fCollections.nTotSaved();
+  edm::LogVerbatim("NTP") << "  Transient track requests:         " << fTransientTracks.nTotRequests();
+  edm::LogVerbatim("NTP") << "   of which built:                  " << fTransientTracks.nTotBuilds();
+  edm::LogVerbatim("NTP") << "  Corrected jet requests:           " << fCorrectedJets.nTotRequests();
+  edm::LogVerbatim("NTP") << "   of which corrected:              " << fCorrectedJets.nTotCorrected();
+  fBufferPool.report("NTupleProducer");
+  fStageTimer.report("Event loop stages");
+  for (size_t i=0; i<jetFillers.size(); ++i)      jetFillers[i]     ->reportBufferPool();
+  for (size_t i=0; i<muonFillers.size(); ++i)     muonFillers[i]    ->reportBufferPool();
+  for (size_t i=0; i<electronFillers.size(); ++i) electronFillers[i]->reportBufferPool();
+  for (size_t i=0; i<tauFillers.size(); ++i)      tauFillers[i]     ->reportBufferPool();
+  for (size_t i=0; i<pfFillers.size(); ++i)       pfFillers[i]      ->reportBufferPool();
   edm::LogVerbatim("NTP") << " ---------------------------------------------------";
 
 }
 
-//________________________________________________________________________________________
-// Method for matching of reco candidates
-std::vector<const reco::GenParticle*> NTupleProducer::matchRecoCand(const reco::RecoCandidate *Cand, const edm::Event& iEvent){
-  using namespace std;
-  const GenParticle *GenCand = NULL;
-  const GenParticle *GenMom  = NULL;
-  const GenParticle *GenGMom = NULL;
-  std::vector<const GenParticle*> res;
-  if(fIsRealData){
-    edm::LogWarning("NTP") << "@SUB=matchRecoCand"
-                           << "Trying to access generator info on real data...";
-    res.push_back(GenCand);
-    res.push_back(GenMom);
-    res.push_back(GenGMom);
-    return res;
-  }
-
-  int id(0), mid(0), gmid(0);
-
-  edm::Handle<GenParticleCollection> genparts;
-  iEvent.getByLabel(fGenPartTag, genparts);
-  GenParticleCollection::const_iterator gpart;
-  GenCand = new GenParticle();
-  GenMom  = new GenParticle();
-  GenGMom = new GenParticle();
-  // initialize the results
-  // btw, this is a little memory leak
-  res.push_back(GenCand);
-  res.push_back(GenMom);
-  res.push_back(GenGMom);
-
-  bool matched = false;
-
-  // Try to match the reco candidate to a generator object
-  double mindr(999.99);
-  for(gpart = genparts->begin(); gpart != genparts->end(); gpart++){
-    if( gpart->status() != 1 ) continue;
-
-    // Restrict to cone of 0.1 in DR around candidate
-    double dr = reco::deltaR(gpart->eta(), gpart->phi(), Cand->eta(), Cand->phi());
-    if(dr > 0.1) continue;
-
-    // Restrict to pt match within a factor of 2
-    double ndpt = fabs(gpart->pt() - Cand->pt())/gpart->pt();
-    if(ndpt > 2.) continue;
-
-    // Minimize DeltaR
-    if(dr > mindr) continue;
-    mindr = dr;
-
-    matched = true;
-    GenCand = &(*gpart);
-  }
-
-
-  // Fill generator information in case match was successful
-  if(matched){
-    // update the results
-    res[0]=GenCand;
-    id  = GenCand->pdgId();
-    if ( !GenCand->mother() ) return res;
-
-    // Determine mother object of matched gen object:
-    // (Make sure that the mother has a different PDG ID)
-    GenMom = static_cast<const GenParticle*>(GenCand->mother());
-    mid = GenMom->pdgId();
-    if(mid != id); // do nothing
-    else{
-      int tempid = mid;
-      int loop_counter = 0;
-      while(tempid == id){
-	loop_counter++;
-	if(loop_counter>=10){
-	  edm::LogWarning("NTP") << "@SUB=analyze"
-				 << " WARNING: accessing GenParticle mother results in loop";
-	  GenMom = static_cast<const GenParticle*>(GenCand->mother());
-	  break;
-	}
-        GenMom = static_cast<const GenParticle*>(GenMom->mother());
-        tempid = GenMom->pdgId();
-      }
-    }
-    mid = GenMom->pdgId();
-    // update the results
-    res[1] = GenMom;
-
-    if ( !GenMom->mother() ) return res;
-    // Determine grand-mother object of matched gen object:
-    // (Make sure that the grand-mother has a different PDG ID than the mother)
-    GenGMom = static_cast<const GenParticle*>(GenMom->mother());
-    gmid = GenGMom->pdgId();
-    if(gmid != mid); // do nothing
-    else{
-      int tempid = gmid;
-      int loop_counter = 0;
-      while(tempid == mid){
-	loop_counter++;
-	if(loop_counter>=10){
-	  edm::LogWarning("NTP") << "@SUB=analyze"
-				 << " WARNING: accessing GenParticle grand-mother results in loop";
-	  GenGMom = static_cast<const GenParticle*>(GenMom->mother());
-	  break;
-	}
-        GenGMom = static_cast<const GenParticle*>(GenGMom->mother());
-        tempid = GenGMom->pdgId();
-      }
-    }
-
-    res[2] = GenGMom;
-  }
-  return res;
-}
-
-//________________________________________________________________________________________
-// Method for matching of jets
-const int NTupleProducer::matchJet(const reco::Jet* jet){
-  // match to already filled genjets in ntuple:
-  // this can only be called AFTER the genjets have been stored!
-  if(fIsRealData || *fTNGenJets < 1){
-    edm::LogWarning("NTP") << "@SUB=matchJet"
-                           << "Trying to access generator info on real data...";
-    return -1;
-  }
-
-  // Try to match the reco jet to a stored generator jet
-  double mindr(999.99);
-  int matchedindex = -1;
-  for(int i = 0; i < *fTNGenJets; i++){
-
-    // Restrict to cone of 0.1 in DR around candidate
-    double dr = reco::deltaR((*fTGenJetEta)[i], (*fTGenJetPhi)[i], jet->eta(), jet->phi());
-    if(dr > 0.3) continue;
-
-    // Restrict to pt match within a factor of 2
-    double ndpt = fabs((*fTGenJetPt)[i] - jet->pt())/(*fTGenJetPt)[i];
-    if(ndpt > 2.) continue;
-
-    // Minimize DeltaR
-    if(dr > mindr) continue;
-    mindr = dr;
-    matchedindex = i;
-  }
-  return matchedindex;
-}
-
 //reco::VertexRef NTupleProducer::chargedHadronVertex( const edm::Handle<reco::VertexCollection>& vertices, const reco::PFCandidate& pfcand ) const {
 //
 //  //PfPileUp candidates!
@@ -7096,55 +5368,91 @@ TLorentzVector NTupleProducer::get_pho_p4(int phoindex, int vtxInd, float energy
   return pho.p4(fTVrtxX->at(vtxInd),fTVrtxY->at(vtxInd),fTVrtxZ->at(vtxInd));
 }
 
-float NTupleProducer::pfTkIsoWithVertexCiC(int phoindex, int vtxInd, const reco::PFCandidateCollection &pfcands, int pfToUse,
-					float dRmax, float dRvetoBarrel, float dRvetoEndcap, float ptMin, float dzMax, float dxyMax) {
-  
+void NTupleProducer::pfTkIsoWithVerticesCiC(const reco::PFCandidateCollection &pfcands, int pfToUse, int ncones, const float *dRmax,
+					    float dRvetoBarrel, float dRvetoEndcap, float ptMin, float dzMax, float dxyMax, std::vector<float> &sums) {
+
+  // Charged isolation of all the stored photons for all vertices and cone sizes, one sweep over
+  // the candidates per photon; sums[(ipho*nvtx+ivtx)*ncones+icone] is the sum for photon ipho,
+  // vertex ivtx and cone dRmax[icone]
+
   assert (pfToUse==1); // protection
+  assert (fPFCandGrid.size()==pfcands.size() && fPFCandArrays.size()==pfcands.size()); // built on this collection
+
+  const int npho = fTPhoVrtxListStart->size();
+  const int nvtx = *fTNVrtx;
+  sums.assign(npho*nvtx*ncones, 0.);
+  if (nvtx==0) return;
+
+  float dRconeMax = 0.;
+  for (int c=0; c<ncones; c++) dRconeMax = std::max(dRconeMax, dRmax[c]);
+
+  // Vertex positions, shared by all photons, ordered in z for the dz preselection
+  std::vector<double> vtxX(nvtx), vtxY(nvtx);
+  std::vector<std::pair<double,int> > vtxZ(nvtx);
+  for (int v=0; v<nvtx; v++) {
+    vtxX[v] = fTVrtxX->at(v);
+    vtxY[v] = fTVrtxY->at(v);
+    vtxZ[v] = std::make_pair((double)fTVrtxZ->at(v), v);
+  }
+  std::sort(vtxZ.begin(), vtxZ.end());
+
+  const PFCandidateArrays& pf = fPFCandArrays;
+  const double dzWindow = dzMax + 1.e-3; // margin for the float rounding of dz, exact cut applied below
+  std::vector<double> axisEta(nvtx), axisPhi(nvtx);
+
+  for (int ipho=0; ipho<npho; ipho++) {
+
+    const float dRveto = (*fTPhoisEB)[ipho] ? dRvetoBarrel : dRvetoEndcap;
+    float *phoSums = &sums[ipho*nvtx*ncones];
+
+    // Photon direction from each vertex
+    double etaLo = 0., etaHi = 0., dPhiMax = 0.;
+    for (int v=0; v<nvtx; v++) {
+      TLorentzVector photonDirectionWrtVtx = get_pho_p4(ipho, v, 0);
+      axisEta[v] = photonDirectionWrtVtx.Eta();
+      axisPhi[v] = photonDirectionWrtVtx.Phi();
+      if (v==0 || axisEta[v]<etaLo) etaLo = axisEta[v];
+      if (v==0 || axisEta[v]>etaHi) etaHi = axisEta[v];
+      dPhiMax = std::max(dPhiMax, fabs(TVector2::Phi_mpi_pi(axisPhi[v]-axisPhi[0])));
+    }
 
-  float dRveto;
-  if ((*fTPhoisEB)[phoindex])
-    dRveto = dRvetoBarrel;
-  else
-    dRveto = dRvetoEndcap;
-  
-  TLorentzVector photonDirectionWrtVtx = get_pho_p4(phoindex, vtxInd, 0);
-  
-  float sum = 0;
-  // Loop over the PFCandidates
-  for(reco::PFCandidateCollection::const_iterator pf=pfcands.begin(); pf!=pfcands.end(); pf++) {
-    
-    //require that PFCandidate is a charged hadron
-    if (FindPFCandType(pf->pdgId()) == pfToUse) {
-	
-      if (!(pf->pt()>0)) continue;
+    // One grid query covering the cones around all vertex-dependent axes
+    const std::vector<unsigned>& cands = fPFCandGrid.coneCandidates(pfToUse, 0.5*(etaLo+etaHi), axisPhi[0],
+								   dRconeMax + std::max(0.5*(etaHi-etaLo), dPhiMax));
 
-      TLorentzVector pfc;
-      pfc.SetPtEtaPhiE(pf->pt(),pf->eta(),pf->phi(),pf->energy());
+    for (std::vector<unsigned>::const_iterator ipf=cands.begin(); ipf!=cands.end(); ipf++) {
+      const unsigned k = *ipf;
 
-      if (pfc.Pt() < ptMin)
+      if (pf.pt[k] < ptMin)
 	continue;
 
-      TVector3 vtx(fTVrtxX->at(vtxInd),fTVrtxY->at(vtxInd),fTVrtxZ->at(vtxInd));
-      TVector3 pfCandVtx(pf->vx(),pf->vy(),pf->vz());
+      std::vector<std::pair<double,int> >::const_iterator vit =
+	std::lower_bound(vtxZ.begin(), vtxZ.end(), std::make_pair(pf.vz[k]-dzWindow, -1));
+      for (; vit!=vtxZ.end() && vit->first <= pf.vz[k]+dzWindow; ++vit) {
+	const int v = vit->second;
 
-      float dz = fabs(pfCandVtx.Z() - vtx.Z());
-	
-      if (dz > dzMax) 
-	continue;
-	
-      double dxy = (-(pfCandVtx.X() - vtx.X())*pfc.Py() + (pfCandVtx.Y() - vtx.Y())*pfc.Px()) / pfc.Pt();
-      if(fabs(dxy) > dxyMax) 
-	continue;
-	
-      float dR = photonDirectionWrtVtx.DeltaR(pfc);
-      if(dR > dRmax || dR < dRveto) 
-	continue;
-	    
-      sum += pfc.Pt();
+	float dz = fabs(pf.vz[k] - vit->first);
+	if (dz > dzMax)
+	  continue;
+
+	double dxy = (-(pf.vx[k] - vtxX[v])*pf.py[k] + (pf.vy[k] - vtxY[v])*pf.px[k]) / pf.pt[k];
+	if (fabs(dxy) > dxyMax)
+	  continue;
+
+	// Same arithmetic as TLorentzVector::DeltaR
+	double deta = axisEta[v] - pf.eta[k];
+	double dphi = TVector2::Phi_mpi_pi(axisPhi[v] - pf.phi[k]);
+	float dR = TMath::Sqrt(deta*deta + dphi*dphi);
+	if (dR < dRveto)
+	  continue;
+
+	for (int c=0; c<ncones; c++)
+	  if (!(dR > dRmax[c])) phoSums[v*ncones+c] += pf.pt[k];
+      }
     }
+
   }
-    
-  return sum;
+
 }
 
 float NTupleProducer::pfEcalIsoCiC(int phoindex, const reco::PFCandidateCollection &pfcands, int pfToUse, float dRmax, float dRVetoBarrel, 
@@ -7163,37 +5471,48 @@ float NTupleProducer::pfEcalIsoCiC(int phoindex, const reco::PFCandidateCollecti
     thr = thrEndcaps;
   }
   
+  assert (fPFCandGrid.size()==pfcands.size()); // grid must be built on this collection
+
+  // The cone axis depends on the candidate vertex: use a cone query only if all
+  // candidates of this type share one vertex, otherwise visit all of them
+  const std::vector<unsigned>* candidates;
+  if (fPFCandGrid.hasCommonVertex(pfToUse)) {
+    const reco::PFCandidate::Point& pfvtx = fPFCandGrid.commonVertex(pfToUse);
+    TVector3 axis(fTPhoSCX->at(phoindex) - pfvtx.X(),
+		  fTPhoSCY->at(phoindex) - pfvtx.Y(),
+		  fTPhoSCZ->at(phoindex) - pfvtx.Z());
+    candidates = &fPFCandGrid.coneCandidates(pfToUse, axis.Eta(), axis.Phi(), dRmax);
+  } else {
+    candidates = &fPFCandGrid.typeCandidates(pfToUse);
+  }
+
   float sum = 0;
-  for(reco::PFCandidateCollection::const_iterator pf=pfcands.begin(); pf!=pfcands.end(); pf++) {
+  for(std::vector<unsigned>::const_iterator ipf=candidates->begin(); ipf!=candidates->end(); ipf++) {
     
-    if (FindPFCandType(pf->pdgId()) == pfToUse) {
-      
-      if (!(pf->pt()>0)) continue;
-
-      TVector3 pfvtx(pf->vx(),pf->vy(),pf->vz());
-      TVector3 phoEcalPos(fTPhoSCX->at(phoindex),fTPhoSCY->at(phoindex),fTPhoSCZ->at(phoindex));
-      
-      TVector3 photonDirectionWrtVtx = TVector3(phoEcalPos.X() - pfvtx.X(),
-						phoEcalPos.Y() - pfvtx.Y(),
-						phoEcalPos.Z() - pfvtx.Z());
-      
-      TLorentzVector pfc;
-      pfc.SetPtEtaPhiE(pf->pt(),pf->eta(),pf->phi(),pf->energy());
-      
-      if( pfc.Pt() < thr ) 
-	continue;
-      
-      float dEta = fabs(photonDirectionWrtVtx.Eta() - pfc.Eta());
-      float dR = photonDirectionWrtVtx.DeltaR(pfc.Vect());
-      
-      if (dEta < etaStrip)
-	continue;
-      
-      if(dR > dRmax || dR < dRVeto)
-	continue;
-      
-      sum += pfc.Pt();
-    }
+    const reco::PFCandidate *pf = &pfcands[*ipf];
+    TVector3 pfvtx(pf->vx(),pf->vy(),pf->vz());
+    TVector3 phoEcalPos(fTPhoSCX->at(phoindex),fTPhoSCY->at(phoindex),fTPhoSCZ->at(phoindex));
+    
+    TVector3 photonDirectionWrtVtx = TVector3(phoEcalPos.X() - pfvtx.X(),
+      					phoEcalPos.Y() - pfvtx.Y(),
+      					phoEcalPos.Z() - pfvtx.Z());
+    
+    TLorentzVector pfc;
+    pfc.SetPtEtaPhiE(pf->pt(),pf->eta(),pf->phi(),pf->energy());
+    
+    if( pfc.Pt() < thr ) 
+      continue;
+    
+    float dEta = fabs(photonDirectionWrtVtx.Eta() - pfc.Eta());
+    float dR = photonDirectionWrtVtx.DeltaR(pfc.Vect());
+    
+    if (dEta < etaStrip)
+      continue;
+    
+    if(dR > dRmax || dR < dRVeto)
+      continue;
+    
+    sum += pfc.Pt();
   }
   
   return sum;
@@ -7270,6 +5589,3 @@ void NTupleProducer::ReadEnergyScale(int run){ // TO BE IMPLEMENTED
   energy_scales.EEHighEtaBad = 1;
 
 }
-
-//define this as a plug-in
-DEFINE_FWK_MODULE(NTupleProducer);
@@ -0,0 +1,37 @@
+#include "DiLeptonAnalysis/NTupleProducer/interface/PFCandidateArrays.h"
+
+#include "TLorentzVector.h"
+
+//________________________________________________________________________________________
+void PFCandidateArrays::fill(const reco::PFCandidateCollection& pfcands, const std::vector<int>& types) {
+
+  size_t n = pfcands.size();
+  pt .resize(n);
+  px .resize(n);
+  py .resize(n);
+  eta.resize(n);
+  phi.resize(n);
+  vx .resize(n);
+  vy .resize(n);
+  vz .resize(n);
+  type.assign(types.begin(), types.begin()+n);
+
+  for (size_t i=0; i<n; ++i) {
+    const reco::PFCandidate& pf = pfcands[i];
+    vx[i] = pf.vx();
+    vy[i] = pf.vy();
+    vz[i] = pf.vz();
+    if (!(pf.pt()>0)) { // never used by the isolation sums
+      pt[i] = px[i] = py[i] = eta[i] = phi[i] = 0.;
+      continue;
+    }
+    TLorentzVector pfc;
+    pfc.SetPtEtaPhiE(pf.pt(),pf.eta(),pf.phi(),pf.energy());
+    pt[i]  = pfc.Pt();
+    px[i]  = pfc.Px();
+    py[i]  = pfc.Py();
+    eta[i] = pfc.Eta();
+    phi[i] = pfc.Phi();
+  }
+
+}
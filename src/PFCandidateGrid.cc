@@ -0,0 +1,119 @@
+#include "DiLeptonAnalysis/NTupleProducer/interface/PFCandidateGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "TMath.h"
+
+//________________________________________________________________________________________
+PFCandidateGrid::PFCandidateGrid(int ntypes, int netabins, double etamax, int nphibins, double conepad) :
+  fNTypes(ntypes),
+  fNEta(netabins),
+  fEtaMax(etamax),
+  fEtaWidth(2.*etamax/netabins),
+  fNPhi(nphibins),
+  fPhiWidth(2.*TMath::Pi()/nphibins),
+  fConePad(conepad),
+  fNCands(0),
+  fCellStart((size_t)ntypes*netabins*nphibins+1,0),
+  fTypeCands(ntypes),
+  fCommonVertex(ntypes,true),
+  fVertex(ntypes)
+{
+}
+
+//________________________________________________________________________________________
+int PFCandidateGrid::etaBin(double eta) const {
+  // Outermost bins are open-ended
+  int ieta = (int)floor((eta+fEtaMax)/fEtaWidth);
+  if (ieta < 0) return 0;
+  if (ieta >= fNEta) return fNEta-1;
+  return ieta;
+}
+
+//________________________________________________________________________________________
+int PFCandidateGrid::phiBin(double phi) const {
+  int iphi = (int)floor((phi+TMath::Pi())/fPhiWidth) % fNPhi;
+  if (iphi < 0) iphi += fNPhi;
+  return iphi;
+}
+
+//________________________________________________________________________________________
+void PFCandidateGrid::build(const reco::PFCandidateCollection& pfcands, const std::vector<int>& types) {
+
+  fNCands = pfcands.size();
+  fCandCell.resize(fNCands);
+  std::fill(fCellStart.begin(), fCellStart.end(), 0);
+  for (int t=0; t<fNTypes; ++t) {
+    fTypeCands[t].clear();
+    fCommonVertex[t] = true;
+  }
+
+  // Count candidates per cell
+  size_t nindexed = 0;
+  for (size_t i=0; i<fNCands; ++i) {
+    const reco::PFCandidate& pf = pfcands[i];
+    int type = types[i];
+    // Same acceptance as the isolation sums: non-positive (or NaN) pt never contributes
+    if (type < 0 || type >= fNTypes || !(pf.pt()>0)) {
+      fCandCell[i] = fCellStart.size();
+      continue;
+    }
+    if (fTypeCands[type].empty()) fVertex[type] = pf.vertex();
+    else if (fCommonVertex[type] && !(pf.vertex() == fVertex[type])) fCommonVertex[type] = false;
+    fTypeCands[type].push_back(i);
+
+    size_t c = cell(type, etaBin(pf.eta()), phiBin(pf.phi()));
+    fCandCell[i] = c;
+    ++fCellStart[c+1];
+    ++nindexed;
+  }
+  for (size_t c=1; c<fCellStart.size(); ++c) fCellStart[c] += fCellStart[c-1];
+
+  // Fill cells; walking the collection in order keeps each cell sorted by index
+  fCellCands.resize(nindexed);
+  std::vector<unsigned> next(fCellStart.begin(), fCellStart.end()-1);
+  for (size_t i=0; i<fNCands; ++i) {
+    if (fCandCell[i] >= fCellStart.size()) continue;
+    fCellCands[next[fCandCell[i]]++] = i;
+  }
+
+}
+
+//________________________________________________________________________________________
+const std::vector<unsigned>& PFCandidateGrid::coneCandidates(int type, double eta, double phi, double dR) {
+
+  fQuery.clear();
+  if (type < 0 || type >= fNTypes) return fQuery;
+
+  dR += fConePad;
+  int etaLo = etaBin(eta-dR);
+  int etaHi = etaBin(eta+dR);
+  int phiLo = (int)floor((phi-dR+TMath::Pi())/fPhiWidth);
+  int phiHi = (int)floor((phi+dR+TMath::Pi())/fPhiWidth);
+  // Do not visit a phi column twice if the window wraps around
+  if (phiHi-phiLo >= fNPhi) phiHi = phiLo+fNPhi-1;
+
+  for (int ieta=etaLo; ieta<=etaHi; ++ieta) {
+    for (int jphi=phiLo; jphi<=phiHi; ++jphi) {
+      int iphi = jphi % fNPhi;
+      if (iphi < 0) iphi += fNPhi;
+      size_t c = cell(type, ieta, iphi);
+      fQuery.insert(fQuery.end(), fCellCands.begin()+fCellStart[c], fCellCands.begin()+fCellStart[c+1]);
+    }
+  }
+
+  // Restore collection order
+  std::sort(fQuery.begin(), fQuery.end());
+  return fQuery;
+
+}
+
+//________________________________________________________________________________________
+const std::vector<unsigned>& PFCandidateGrid::typeCandidates(int type) {
+  if (type < 0 || type >= fNTypes) {
+    fQuery.clear();
+    return fQuery;
+  }
+  return fTypeCands[type];
+}
@@ -36,7 +36,7 @@ void PFFiller::fillProducts(edm::Event& iEvent,const edm::EventSetup& iSetup ) {
 
   // Retrieve collections
   Handle<View<reco::PFCandidate> > pfHandle;
-  iEvent.getByLabel(fTag,pfHandle);
+  getByLabel(iEvent,fTag,pfHandle);
   View<reco::PFCandidate> candidates = *pfHandle;
 
   // PAT jets are already ordered by corrected pt: no need to re-order
@@ -105,23 +105,25 @@ void PFFiller::resetProducts(void) {
 
   fTNObjs.reset(new int(0));
   
-  fTPx     .reset(new std::vector<float>);
-  fTPy     .reset(new std::vector<float>);
-  fTPz     .reset(new std::vector<float>);
-  fTPt     .reset(new std::vector<float>);
-  fTE      .reset(new std::vector<float>);
-  fTEt     .reset(new std::vector<float>);
-  fTEta    .reset(new std::vector<float>);
-  fTPhi    .reset(new std::vector<float>);
-  fTType   .reset(new std::vector<int>);
-  fTVx     .reset(new std::vector<float>);
-  fTVy     .reset(new std::vector<float>);
-  fTVz     .reset(new std::vector<float>);
+  fBufferPool.reset(fTPx, "Px");
+  fBufferPool.reset(fTPy, "Py");
+  fBufferPool.reset(fTPz, "Pz");
+  fBufferPool.reset(fTPt, "Pt");
+  fBufferPool.reset(fTE, "E");
+  fBufferPool.reset(fTEt, "Et");
+  fBufferPool.reset(fTEta, "Eta");
+  fBufferPool.reset(fTPhi, "Phi");
+  fBufferPool.reset(fTType, "Type");
+  fBufferPool.reset(fTVx, "Vx");
+  fBufferPool.reset(fTVy, "Vy");
+  fBufferPool.reset(fTVz, "Vz");
 
 }
 
 //______________________________________________________________________________
 void PFFiller::putProducts( edm::Event& e ) { 
+  fBufferPool.collect();
+
   e.put(fTNObjs,fullName("NCandidates"));
 	
   e.put(fTPx, fullName("Px"));
@@ -0,0 +1,69 @@
+#include "DiLeptonAnalysis/NTupleProducer/interface/ProductBufferPool.h"
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+namespace {
+  // Allocations of a vector growing by doubling from capacity 'reserved' to hold n elements
+  unsigned growthAllocations(size_t n, size_t reserved) {
+    if (n == 0) return reserved > 0 ? 1 : 0;
+    unsigned nalloc = 1;
+    size_t capacity = reserved > 0 ? reserved : 1;
+    while (capacity < n) { capacity *= 2; ++nalloc; }
+    return nalloc;
+  }
+}
+
+//________________________________________________________________________________________
+ProductBufferPool::Entry& ProductBufferPool::entry(const void* owner, SizeFunction size, const char* name) {
+
+  std::map<const void*,size_t>::const_iterator it = fIndex.find(owner);
+  if (it != fIndex.end()) return fEntries[it->second];
+
+  Entry e;
+  e.owner     = owner;
+  e.size      = size;
+  e.name      = name;
+  e.highWater = 0;
+  e.reserved  = 0;
+  e.nPut      = 0;
+  e.nAvoided  = 0;
+  fIndex[owner] = fEntries.size();
+  fEntries.push_back(e);
+  return fEntries.back();
+
+}
+
+//________________________________________________________________________________________
+void ProductBufferPool::collect(void) {
+
+  for (std::vector<Entry>::iterator e = fEntries.begin(); e != fEntries.end(); ++e) {
+    size_t n = e->size(e->owner);
+    unsigned fromZero = growthAllocations(n, 0);
+    unsigned reserved = growthAllocations(n, e->reserved);
+    if (fromZero > reserved) e->nAvoided += fromZero - reserved;
+    if (n > e->highWater) e->highWater = n;
+    ++e->nPut;
+  }
+
+}
+
+//________________________________________________________________________________________
+unsigned long ProductBufferPool::nAvoided(void) const {
+  unsigned long n = 0;
+  for (std::vector<Entry>::const_iterator e = fEntries.begin(); e != fEntries.end(); ++e)
+    n += e->nAvoided;
+  return n;
+}
+
+//________________________________________________________________________________________
+void ProductBufferPool::report(const std::string& title) const {
+
+  edm::LogVerbatim("NTP") << "  Product buffers " << title << ": " << fEntries.size()
+			  << " branches, allocations avoided: " << nAvoided();
+  for (std::vector<Entry>::const_iterator e = fEntries.begin(); e != fEntries.end(); ++e) {
+    if (e->nAvoided == 0) continue;
+    edm::LogVerbatim("NTP") << "    " << e->name << ": " << e->nAvoided
+			    << " (high-water mark " << e->highWater << ")";
+  }
+
+}
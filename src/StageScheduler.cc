@@ -0,0 +1,132 @@
+#include "DiLeptonAnalysis/NTupleProducer/interface/StageScheduler.h"
+
+#include <exception>
+
+#include <boost/bind.hpp>
+
+//________________________________________________________________________________________
+StageScheduler::StageScheduler(unsigned nThreads) :
+  fNThreads(nThreads > 0 ? nThreads : 1),
+  fNDone(0),
+  fAccept(true),
+  fStop(false)
+{
+  for (unsigned i = 1; i < fNThreads; ++i)
+    fWorkers.create_thread(boost::bind(&StageScheduler::work, this));
+}
+
+//________________________________________________________________________________________
+StageScheduler::~StageScheduler(void) {
+
+  {
+    boost::mutex::scoped_lock lock(fMutex);
+    fStop = true;
+  }
+  fWake.notify_all();
+  fWorkers.join_all();
+
+}
+
+//________________________________________________________________________________________
+unsigned StageScheduler::add(const Task& task, const std::vector<unsigned>& after) {
+
+  unsigned index = fNodes.size();
+  for (std::vector<unsigned>::const_iterator it = after.begin(); it != after.end(); ++it)
+    if (*it >= index)
+      throw cms::Exception("LogicError") << "StageScheduler: task " << index
+                                         << " depends on task " << *it << " added after it";
+
+  Node node;
+  node.task     = task;
+  node.nAfter   = after.size();
+  node.nPending = 0;
+  fNodes.push_back(node);
+  for (std::vector<unsigned>::const_iterator it = after.begin(); it != after.end(); ++it)
+    fNodes[*it].next.push_back(index);
+  return index;
+
+}
+
+//________________________________________________________________________________________
+bool StageScheduler::run(void) {
+
+  if (fNThreads == 1) {
+    for (std::vector<Node>::iterator it = fNodes.begin(); it != fNodes.end(); ++it)
+      if (!it->task()) return false;
+    return true;
+  }
+
+  boost::mutex::scoped_lock lock(fMutex);
+  fReady.clear();
+  fNDone  = 0;
+  fAccept = true;
+  fError.reset();
+  for (unsigned i = 0; i < fNodes.size(); ++i) {
+    fNodes[i].nPending = fNodes[i].nAfter;
+    if (fNodes[i].nAfter == 0) fReady.push_back(i);
+  }
+  fWake.notify_all();
+
+  // The calling thread takes tasks as well, until all are done
+  while (fNDone < fNodes.size()) {
+    if (fReady.empty()) {
+      fWake.wait(lock);
+      continue;
+    }
+    unsigned node = fReady.front();
+    fReady.pop_front();
+    execute(node, lock);
+  }
+
+  if (fError.get()) {
+    cms::Exception error(*fError);
+    fError.reset();
+    throw error;
+  }
+  return fAccept;
+
+}
+
+//________________________________________________________________________________________
+void StageScheduler::work(void) {
+
+  boost::mutex::scoped_lock lock(fMutex);
+  while (true) {
+    while (!fStop && fReady.empty()) fWake.wait(lock);
+    if (fStop) return;
+    unsigned node = fReady.front();
+    fReady.pop_front();
+    execute(node, lock);
+  }
+
+}
+
+//________________________________________________________________________________________
+// Called and returns with the lock held, which is released while the task runs
+void StageScheduler::execute(unsigned node, boost::mutex::scoped_lock& lock) {
+
+  if (fAccept && !fError.get()) {
+    lock.unlock();
+    bool accept = true;
+    std::auto_ptr<cms::Exception> error;
+    try {
+      accept = fNodes[node].task();
+    } catch (cms::Exception& e) {
+      error.reset(new cms::Exception(e));
+    } catch (std::exception& e) {
+      error.reset(new cms::Exception("StdException", e.what()));
+    } catch (...) {
+      error.reset(new cms::Exception("Unknown", "Unknown exception in a scheduled task"));
+    }
+    lock.lock();
+    if (!accept) fAccept = false;
+    if (error.get() && !fError.get()) fError = error;
+  }
+
+  ++fNDone;
+  const std::vector<unsigned>& next = fNodes[node].next;
+  for (std::vector<unsigned>::const_iterator it = next.begin(); it != next.end(); ++it)
+    if (--fNodes[*it].nPending == 0) fReady.push_back(*it);
+  fWake.notify_all();
+
+}
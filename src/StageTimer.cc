@@ -0,0 +1,102 @@
+#include "DiLeptonAnalysis/NTupleProducer/interface/StageTimer.h"
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <time.h>
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+namespace {
+  const double gMinTime     = 1e-7; // lower edge of the first bin [s]
+  const int    gBinsPerDec  = 50;
+  const int    gNBins       = 10*gBinsPerDec; // up to 1000 s
+
+  int timeBin(double t) {
+    if (!(t > gMinTime)) return 0;
+    int bin = int(gBinsPerDec*std::log10(t/gMinTime));
+    return bin < gNBins ? bin : gNBins-1;
+  }
+}
+
+//________________________________________________________________________________________
+unsigned StageTimer::add(const std::string& name) {
+
+  Stage s;
+  s.name  = name;
+  s.start = 0.;
+  s.sum   = 0.;
+  s.max   = 0.;
+  s.n     = 0;
+  s.hist.assign(gNBins, 0);
+  fStages.push_back(s);
+  return fStages.size()-1;
+
+}
+
+//________________________________________________________________________________________
+void StageTimer::stop(unsigned stage) {
+
+  Stage& s = fStages[stage];
+  double t = now() - s.start;
+  s.sum += t;
+  if (t > s.max) s.max = t;
+  ++s.n;
+  ++s.hist[timeBin(t)];
+
+}
+
+//________________________________________________________________________________________
+double StageTimer::now(void) {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9*ts.tv_nsec;
+}
+
+//________________________________________________________________________________________
+double StageTimer::quantile(const Stage& s, double q) const {
+
+  if (s.n == 0) return 0.;
+  unsigned long target = (unsigned long)std::ceil(q*s.n);
+  if (target == 0) target = 1;
+  unsigned long sum = 0;
+  for (int bin = 0; bin < gNBins; ++bin) {
+    sum += s.hist[bin];
+    if (sum >= target) {
+      // Geometric centre of the bin, but never above the largest time seen
+      double t = gMinTime*std::pow(10., (bin+0.5)/gBinsPerDec);
+      return t < s.max ? t : s.max;
+    }
+  }
+  return s.max;
+
+}
+
+//________________________________________________________________________________________
+void StageTimer::report(const std::string& title) const {
+
+  double total = 0.;
+  for (std::vector<Stage>::const_iterator s = fStages.begin(); s != fStages.end(); ++s)
+    total += s->sum;
+
+  edm::LogVerbatim("NTP") << "  " << title << " (times in ms, total " << std::fixed
+			  << std::setprecision(3) << total << " s):";
+  edm::LogVerbatim("NTP") << "    " << std::setw(20) << std::left << "stage" << std::right
+			  << std::setw(10) << "calls" << std::setw(10) << "mean"
+			  << std::setw(10) << "p50" << std::setw(10) << "p99"
+			  << std::setw(10) << "max" << std::setw(8) << "share";
+  for (std::vector<Stage>::const_iterator s = fStages.begin(); s != fStages.end(); ++s) {
+    double mean = s->n > 0 ? s->sum/s->n : 0.;
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(3)
+	 << "    " << std::setw(20) << std::left << s->name << std::right
+	 << std::setw(10) << s->n
+	 << std::setw(10) << 1e3*mean
+	 << std::setw(10) << 1e3*quantile(*s, 0.50)
+	 << std::setw(10) << 1e3*quantile(*s, 0.99)
+	 << std::setw(10) << 1e3*s->max
+	 << std::setw(7)  << std::setprecision(1) << (total > 0. ? 100.*s->sum/total : 0.) << "%";
+    edm::LogVerbatim("NTP") << line.str();
+  }
+
+}
@@ -0,0 +1,72 @@
+#include "DiLeptonAnalysis/NTupleProducer/interface/TrackVertexTable.h"
+
+//________________________________________________________________________________________
+void TrackVertexTable::fill(const reco::VertexCollection& vertices) {
+
+  fEntries.clear();
+  fVertexStart.assign(1, 0);
+  fCollections.clear();
+  fTrackEntries.clear();
+
+  // First pass: entries by vertex, and number of vertices per track key
+  for (unsigned v = 0; v < vertices.size(); ++v) {
+    const reco::Vertex& vtx = vertices[v];
+    for (reco::Vertex::trackRef_iterator tk = vtx.tracks_begin(); tk != vtx.tracks_end(); ++tk) {
+      int c = collectionIndex(tk->id());
+      if (c < 0) {
+        Collection collection;
+        collection.id = tk->id();
+        fCollections.push_back(collection);
+        c = fCollections.size()-1;
+      }
+      Entry entry;
+      entry.vertex     = v;
+      entry.collection = c;
+      entry.key        = tk->key();
+      entry.weight     = vtx.trackWeight(*tk);
+      fEntries.push_back(entry);
+
+      std::vector<unsigned>& start = fCollections[c].start;
+      if (start.size() < entry.key+2) start.resize(entry.key+2, 0);
+      ++start[entry.key+1];
+    }
+    fVertexStart.push_back(fEntries.size());
+  }
+
+  // Counts to offsets, the collections one after the other
+  unsigned offset = 0;
+  std::vector<std::vector<unsigned> > next(fCollections.size());
+  for (size_t c = 0; c < fCollections.size(); ++c) {
+    std::vector<unsigned>& start = fCollections[c].start;
+    start[0] = offset;
+    for (size_t k = 1; k < start.size(); ++k) start[k] += start[k-1];
+    offset = start.back();
+    next[c].assign(start.begin(), start.end()-1);
+  }
+
+  // Second pass: entries by track, keeping the vertex order
+  fTrackEntries.resize(offset);
+  for (std::vector<Entry>::const_iterator e = fEntries.begin(); e != fEntries.end(); ++e)
+    fTrackEntries[next[e->collection][e->key]++] = &(*e);
+
+}
+
+//________________________________________________________________________________________
+std::pair<const TrackVertexTable::Entry* const*, const TrackVertexTable::Entry* const*>
+TrackVertexTable::trackVertices(const edm::ProductID& id, size_t key) const {
+
+  typedef std::pair<const Entry* const*, const Entry* const*> Range;
+  int c = collectionIndex(id);
+  if (c < 0) return Range(0, 0);
+  const std::vector<unsigned>& start = fCollections[c].start;
+  if (key+1 >= start.size() || start[key] == start[key+1]) return Range(0, 0);
+  return Range(&fTrackEntries[start[key]], &fTrackEntries[0] + start[key+1]);
+
+}
+
+//________________________________________________________________________________________
+int TrackVertexTable::collectionIndex(const edm::ProductID& id) const {
+  for (size_t c = 0; c < fCollections.size(); ++c)
+    if (fCollections[c].id == id) return c;
+  return -1;
+}
@@ -0,0 +1,53 @@
+#include "DiLeptonAnalysis/NTupleProducer/interface/TransientTrackCache.h"
+
+#include "TrackingTools/TransientTrack/interface/TransientTrackBuilder.h"
+
+//________________________________________________________________________________________
+TransientTrackCache::TransientTrackCache(void) :
+  fBuilder(0),
+  fNTotRequests(0),
+  fNTotBuilds(0)
+{
+}
+
+//________________________________________________________________________________________
+void TransientTrackCache::newEvent(const TransientTrackBuilder* builder) {
+  boost::mutex::scoped_lock lock(fMutex);
+  fBuilder = builder;
+  fTracks.clear();
+}
+
+//________________________________________________________________________________________
+reco::TransientTrack TransientTrackCache::get(const reco::TrackRef& track) {
+  reco::TransientTrack transient;
+  if (find(key(track.id(), track.key()), transient)) return transient;
+  transient = fBuilder->build(track);
+  insert(key(track.id(), track.key()), transient);
+  return transient;
+}
+
+//________________________________________________________________________________________
+reco::TransientTrack TransientTrackCache::get(const reco::GsfTrackRef& track) {
+  reco::TransientTrack transient;
+  if (find(key(track.id(), track.key()), transient)) return transient;
+  transient = fBuilder->build(track);
+  insert(key(track.id(), track.key()), transient);
+  return transient;
+}
+
+//________________________________________________________________________________________
+bool TransientTrackCache::find(unsigned long long key, reco::TransientTrack& track) {
+  boost::mutex::scoped_lock lock(fMutex);
+  ++fNTotRequests;
+  TrackMap::const_iterator it = fTracks.find(key);
+  if (it == fTracks.end()) return false;
+  track = it->second;
+  return true;
+}
+
+//________________________________________________________________________________________
+void TransientTrackCache::insert(unsigned long long key, const reco::TransientTrack& track) {
+  boost::mutex::scoped_lock lock(fMutex);
+  ++fNTotBuilds;
+  fTracks.insert(std::make_pair(key, track));
+}
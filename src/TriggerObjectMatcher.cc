@@ -0,0 +1,36 @@
+#include "DiLeptonAnalysis/NTupleProducer/interface/TriggerObjectMatcher.h"
+
+#include <algorithm>
+
+#include "DataFormats/Math/interface/deltaR.h"
+
+//________________________________________________________________________________________
+void TriggerObjectMatcher::add(double eta, double phi, unsigned int mask) {
+
+  Object object;
+  object.eta  = eta;
+  object.phi  = phi;
+  object.mask = mask;
+  fObjects.push_back(object);
+
+}
+
+//________________________________________________________________________________________
+void TriggerObjectMatcher::build(void) {
+  std::sort(fObjects.begin(), fObjects.end());
+}
+
+//________________________________________________________________________________________
+unsigned int TriggerObjectMatcher::match(double eta, double phi, double maxDR) const {
+
+  Object low;
+  low.eta = eta - maxDR;
+  unsigned int mask = 0;
+  for (std::vector<Object>::const_iterator o = std::lower_bound(fObjects.begin(), fObjects.end(), low);
+       o != fObjects.end() && o->eta <= eta + maxDR; ++o) {
+    if ((mask | o->mask) == mask) continue; // nothing new
+    if (reco::deltaR(o->eta, o->phi, eta, phi) < maxDR) mask |= o->mask;
+  }
+  return mask;
+
+}
@@ -0,0 +1,103 @@
+// Compares the photon ID responses of FastForest to those of TMVA::Reader,
+// for both weight files and fixed inputs, read from the XML and from the
+// binary cache. Run from a CMSSW area: testNTupleProducerFastForest [number of inputs]
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "TMVA/Reader.h"
+#include "TRandom3.h"
+
+#include "DiLeptonAnalysis/NTupleProducer/interface/FastForest.h"
+
+namespace {
+  // Photon ID variables, in the order of the weight files, with the ranges the inputs are drawn from
+  struct Variable { const char* name; float min, max; };
+  const Variable gVariables[] = {
+    { "ph.scrawe",                   0.,    300.   },
+    { "ph.r9",                       0.2,   1.05   },
+    { "ph.sigietaieta",              0.,    0.05   },
+    { "ph.scetawidth",               0.,    0.05   },
+    { "ph.scphiwidth",               0.,    0.15   },
+    { "ph.idmva_CoviEtaiPhi",       -0.001, 0.001  },
+    { "ph.idmva_s4ratio",            0.3,   1.     },
+    { "ph.idmva_GammaIso",           0.,    20.    },
+    { "ph.idmva_ChargedIso_selvtx",  0.,    20.    },
+    { "ph.idmva_ChargedIso_worstvtx",0.,    30.    },
+    { "ph.sceta",                   -2.5,   2.5    },
+    { "rho",                         0.,    40.    },
+    { "ph.idmva_PsEffWidthSigmaRR",  0.,    15.    }
+  };
+
+  // Number of responses differing from TMVA's
+  unsigned compare(const std::string& weightPath, unsigned nVariables, unsigned nRows) {
+
+    std::vector<std::string> names;
+    std::vector<float> inputs(nVariables);
+    TMVA::Reader reader("!Color:Silent");
+    for (unsigned v = 0; v < nVariables; ++v) {
+      names.push_back(gVariables[v].name);
+      reader.AddVariable(gVariables[v].name, &inputs[v]);
+    }
+    reader.BookMVA("AdaBoost", weightPath.c_str());
+
+    TRandom3 random(4357);
+    std::vector<float> rows(nRows*nVariables);
+    for (unsigned r = 0; r < nRows; ++r)
+      for (unsigned v = 0; v < nVariables; ++v)
+        rows[r*nVariables+v] = random.Uniform(gVariables[v].min, gVariables[v].max);
+
+    const std::string cachePath = weightPath + ".test.forest";
+    std::remove(cachePath.c_str());
+    FastForest fromXml, fromCache;
+    fromXml.load(weightPath, names, cachePath);    // writes the cache
+    fromCache.load(weightPath, names, cachePath);  // reads it back
+    std::remove(cachePath.c_str());
+
+    std::vector<double> responses;
+    fromCache.evaluate(&rows[0], nRows, responses);
+    unsigned nBad = 0;
+    double maxDiff = 0.;
+    for (unsigned r = 0; r < nRows; ++r) {
+      for (unsigned v = 0; v < nVariables; ++v) inputs[v] = rows[r*nVariables+v];
+      const double expected = reader.EvaluateMVA("AdaBoost");
+      const double single   = fromXml.evaluate(&rows[r*nVariables]);
+      const double diff = std::max(std::fabs(single-expected), std::fabs(responses[r]-expected));
+      if (diff > maxDiff) maxDiff = diff;
+      if (diff > 1e-12) {
+        if (nBad < 10) printf("  row %u: TMVA %.17g, FastForest %.17g (batch %.17g)\n", r, expected, single, responses[r]);
+        ++nBad;
+      }
+    }
+    printf("%s: %u trees, %u inputs, %u differences, largest %g\n",
+           weightPath.c_str(), fromXml.nTrees(), nRows, nBad, maxDiff);
+    return nBad;
+
+  }
+}
+
+int main(int argc, char** argv) {
+
+  const unsigned nRows = argc > 1 ? std::atoi(argv[1]) : 10000;
+  const char* base = std::getenv("CMSSW_BASE");
+  if (!base) {
+    printf("CMSSW_BASE is not set\n");
+    return 2;
+  }
+  const std::string data = std::string(base) + "/src/DiLeptonAnalysis/NTupleProducer/data/";
+
+  unsigned nBad = 0;
+  try {
+    nBad += compare(data + "2013FinalPaper_PhotonID_Barrel_BDT_TrainRangePT15.weights.xml", 12, nRows);
+    nBad += compare(data + "2013FinalPaper_PhotonID_Endcap_BDT_TrainRangePT15.weights.xml", 13, nRows);
+  } catch (std::exception& e) {
+    printf("%s\n", e.what());
+    return 2;
+  }
+  return nBad == 0 ? 0 : 1;
+
+}